@@ -21,7 +21,9 @@
 #include "itkProcessObject.h"
 #include "itkPolyData.h"
 
+#include <functional>
 #include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -48,6 +50,10 @@ public:
  * Convert an itk::PointSet or itk::Mesh to an itk::PolyData for visualization
  * with vtk.js.
  *
+ * The points of a 3D mesh with float coordinates are shared with the output
+ * without a copy. Other points are converted in a single parallel pass,
+ * with the third coordinate of 2D points set to 0.0.
+ *
  * Currently support ITK cell types:
  *
  * - itk::VertexCell
@@ -55,11 +61,65 @@ public:
  * - itk::TriangleCell
  * - itk::QuadrilateralCell
  * - itk::PolygonCell
+ * - itk::TetrahedronCell and itk::HexahedronCell, as their boundary faces
+ *
+ * The faces of tetrahedra and hexahedra that are not shared by two cells are
+ * output as polygons, with the cell data of their cell, so that volumetric
+ * meshes produce their exterior surface. Shared faces are found with a face
+ * table keyed on the sorted point ids of each face, built in parallel.
+ *
+ * The cells are split into contiguous ranges that are converted in parallel,
+ * one range per work unit. A first pass counts the output of each range so
+ * that every cell array is allocated to its exact size, and a second pass
+ * writes each range at its offset. The output is identical for any number
+ * of work units.
+ *
+ * The connectivity is cached and shared with the output. Updates that only
+ * change the input points or point data reuse it, as long as the input cells
+ * container is not modified. Cells edited in place must be followed by a
+ * call to Modified() on the cells container.
+ *
+ * In streaming mode, see SetNumberOfCellsPerChunk(), the input cells are
+ * converted in chunks, so that pieces can be sent while the rest of the mesh
+ * is converted. Each piece only holds the points used by its cells,
+ * renumbered in order of first use, with their point data, and the memory
+ * used to build it is proportional to the chunk size. For meshes of
+ * surface cells, that bounds the peak memory. The boundary faces of
+ * tetrahedra and hexahedra, however, can only be told apart from the faces
+ * shared by cells of different chunks by looking at the whole mesh, so they
+ * are found once before the first chunk. This sorts a temporary record of
+ * the point ids of every face of the volumetric cells, then keeps one byte
+ * per face until the last chunk, so the peak memory of volumetric meshes
+ * grows with their number of faces. An exception is thrown when no chunk
+ * callback is set.
+ *
+ * Meshes made only of triangles, or only of quadrilaterals, are detected
+ * during the first pass and written in a tight loop that bypasses the cell
+ * visitors.
+ *
+ * When GenerateTriangleStrips is enabled, the triangles are joined into
+ * triangle strips, which reduces the size of the connectivity by up to about
+ * three times. Neighboring triangles are found with a parallel edge table
+ * and joined greedily within each range of triangles. Only triangles with a
+ * consistent winding and equal cell data are joined, and the cell data of
+ * each strip is the one of its triangles. Other polygons are kept as
+ * polygons.
+ *
+ * The output PolyData type, PolyData<PixelType> by default, sets the integer
+ * type of the output cell arrays, see PolyData::CellIndexType. An exception
+ * is thrown when the input points or cells cannot be indexed by it.
+ * GetMaximumCellIndexValue() and CallWithNarrowestPolyDataType() select the
+ * narrowest output type for a given input.
+ *
+ * The filter keeps the containers it allocates, for the output and for the
+ * intermediate cell arrays, and reuses their capacity in later updates once
+ * nothing else references them, see ReuseContainers. A long-lived filter
+ * that converts many meshes of similar sizes then stops allocating memory.
  *
  * \ingroup MeshToPolyData
  *
  */
-template <typename TInputMesh>
+template <typename TInputMesh, typename TOutputPolyData = PolyData<typename TInputMesh::PixelType>>
 class MeshToPolyDataFilter : public ProcessObject
 {
 public:
@@ -70,12 +130,12 @@ public:
   using InputMeshType = TInputMesh;
 
   /** Standard class typedefs. */
-  using Self = MeshToPolyDataFilter<InputMeshType>;
+  using Self = MeshToPolyDataFilter<InputMeshType, TOutputPolyData>;
   using Superclass = ProcessObject;
   using Pointer = SmartPointer<Self>;
   using ConstPointer = SmartPointer<const Self>;
 
-  using PolyDataType = PolyData<typename InputMeshType::PixelType>;
+  using PolyDataType = TOutputPolyData;
 
   /** Run-time type information. */
   itkOverrideGetNameOfClassMacro(MeshToPolyDataFilter);
@@ -103,6 +163,91 @@ public:
   PolyDataType *
   GetOutput(unsigned int idx);
 
+  /** Join the output triangles into triangle strips. Off by default. */
+  itkSetMacro(GenerateTriangleStrips, bool);
+  itkGetConstMacro(GenerateTriangleStrips, bool);
+  itkBooleanMacro(GenerateTriangleStrips);
+
+  /** Store the output point data and cell data as flat buffers of pixel
+   * components, see PolyData::GetPointDataBuffer(), instead of containers of
+   * pixels. The components are copied in bulk, without an allocation per
+   * pixel. Off by default. */
+  itkSetMacro(UseAttributeBuffers, bool);
+  itkGetConstMacro(UseAttributeBuffers, bool);
+  itkBooleanMacro(UseAttributeBuffers);
+
+  /** Reorder the output polygons to improve the reuse of the GPU vertex
+   * cache when they are rendered, with the algorithm of Forsyth. The cell
+   * data follows the polygons. Blocks of polygons are reordered in parallel.
+   * Off by default. */
+  itkSetMacro(OptimizeVertexCache, bool);
+  itkGetConstMacro(OptimizeVertexCache, bool);
+  itkBooleanMacro(OptimizeVertexCache);
+
+  /** Drop the input points that no cell uses, and renumber the output cells
+   * accordingly. The used points keep their relative order, and the point
+   * data follows them. Off by default. */
+  itkSetMacro(RemoveUnusedPoints, bool);
+  itkGetConstMacro(RemoveUnusedPoints, bool);
+  itkBooleanMacro(RemoveUnusedPoints);
+
+  /** Reuse the containers of the previous outputs, and the intermediate cell
+   * arrays, once the filter holds their only reference, instead of
+   * allocating new containers at every update. A reused container keeps its
+   * capacity. Containers that an update does not reuse are freed at the
+   * next update. On by default.
+   *
+   * The filter holds a reference to each container of its outputs, so the
+   * non-const container getters of an output with PolyData::CopyOnWrite
+   * enabled return a copy of the container. Leave CopyOnWrite off on the
+   * outputs, or turn ReuseContainers off, to modify them in place. */
+  itkSetMacro(ReuseContainers, bool);
+  itkGetConstMacro(ReuseContainers, bool);
+  itkBooleanMacro(ReuseContainers);
+
+  /** Streaming mode: when not 0, the input cells are converted in chunks of
+   * this many cells, and each chunk is delivered as a self-contained piece
+   * to the chunk callback instead of being written to the output. 0 by
+   * default. */
+  itkSetMacro(NumberOfCellsPerChunk, SizeValueType);
+  itkGetConstMacro(NumberOfCellsPerChunk, SizeValueType);
+
+  /** Function called in streaming mode with each piece, in input cell
+   * order, and the index of its chunk. Required in streaming mode. */
+  using ChunkCallbackType = std::function<void(PolyDataType * piece, SizeValueType chunkIndex)>;
+  void
+  SetChunkCallback(ChunkCallbackType callback);
+
+  using CellsContainer = typename PolyDataType::CellsContainer;
+
+  /** Input cell ids are stored with at least 32 bits, so that narrow cell
+   * arrays can hold meshes with many cells. */
+  using CellIdentifierElementType = std::conditional_t<(sizeof(typename CellsContainer::Element) < sizeof(uint32_t)),
+                                                       uint32_t,
+                                                       typename CellsContainer::Element>;
+  using CellIdentifiersContainer = VectorContainer<SizeValueType, CellIdentifierElementType>;
+
+  /** Input cell id of every output cell, in the order of the output cell
+   * data: vertices, lines, polygons, then triangle strips, once the
+   * polygons are reordered or joined into strips. Gather the input cell
+   * attributes that the filter does not carry with it. nullptr before the
+   * first update, in streaming mode, and for inputs without cells. Valid
+   * until the next update. */
+  const CellIdentifiersContainer *
+  GetInputCellIdentifiers() const;
+
+  /** Input point id of every output point when RemoveUnusedPoints is on,
+   * else nullptr, the output points being the input points. Valid until the
+   * next update. */
+  const CellsContainer *
+  GetInputPointIdentifiers() const;
+
+  /** Largest value the cell arrays of the output of input would hold: its
+   * number of points, or the number of points of its largest cell. Pass it
+   * to PolyData::CanIndex() or CallWithNarrowestPolyDataType(). */
+  static SizeValueType
+  GetMaximumCellIndexValue(const InputMeshType * input);
+
 protected:
   MeshToPolyDataFilter();
   ~MeshToPolyDataFilter() override = default;
@@ -123,12 +268,111 @@ protected:
   void
   GenerateDataDispatch();
 
+  /** Cell arrays converted from a range of input cells, with the input cell
+   * id of every output cell in the output cell order. */
+  struct ConnectivityType
+  {
+    typename CellsContainer::Pointer           Vertices;
+    typename CellsContainer::Pointer           Lines;
+    typename CellsContainer::Pointer           Polygons;
+    typename CellsContainer::Pointer           TriangleStrips;
+    typename CellIdentifiersContainer::Pointer CellIds;
+
+    /** Input point id of every output point, when unused points are
+     * removed. */
+    typename CellsContainer::Pointer PointIds;
+  };
+
+  /** Convert the numberOfCells input cells in [begin, end). boundaryFaces
+   * holds, for each face of the tetrahedra and hexahedra of these cells, its
+   * number of points if it is on the boundary of the whole mesh and 0
+   * otherwise. When nullptr, the boundary faces are found among these cells
+   * only. */
+  template <typename TInputMeshDispatch>
+  void
+  GenerateConnectivity(typename TInputMeshDispatch::CellsContainer::ConstIterator begin,
+                       typename TInputMeshDispatch::CellsContainer::ConstIterator end,
+                       SizeValueType                                              numberOfCells,
+                       const uint8_t *                                            boundaryFaces,
+                       ConnectivityType &                                         connectivity);
+
+  /** Reorder the polygons for the vertex cache, see OptimizeVertexCache. */
+  void
+  ReorderPolygonsForVertexCache(ConnectivityType & connectivity);
+
+  /** Replace the triangles of the polygons with triangle strips. */
+  template <typename TInputMeshDispatch>
+  void
+  JoinTrianglesIntoStrips(ConnectivityType & connectivity);
+
+  /** Set the point data of output to the input point data of the points
+   * pointIds[0], ..., pointIds[numberOfPoints - 1]. */
+  void
+  GatherPointData(const typename CellsContainer::Element * pointIds,
+                  SizeValueType                            numberOfPoints,
+                  PolyDataType *                           output);
+
+  /** Return a container of the pool, see ReuseContainers, resized to size
+   * elements: the smallest free container of type TContainer that has the
+   * capacity for them, or else the largest one, or a new container. */
+  template <typename TContainer>
+  typename TContainer::Pointer
+  AcquireContainer(SizeValueType size);
+
+  /** Free the containers of the pool that the last update did not reuse. */
+  void
+  PrepareContainerPool();
+
+  /** Convert the input in chunks of cells, in streaming mode. */
+  template <typename TInputMeshDispatch>
+  void
+  GenerateChunks();
+
   ProcessObject::DataObjectPointer
   MakeOutput(ProcessObject::DataObjectPointerArraySizeType idx) override;
   ProcessObject::DataObjectPointer
   MakeOutput(const ProcessObject::DataObjectIdentifierType &) override;
 
 private:
+  bool              m_GenerateTriangleStrips{ false };
+  bool              m_UseAttributeBuffers{ false };
+  bool              m_OptimizeVertexCache{ false };
+  bool              m_RemoveUnusedPoints{ false };
+  bool              m_ReuseContainers{ true };
+  SizeValueType     m_NumberOfCellsPerChunk{ 0 };
+  ChunkCallbackType m_ChunkCallback;
+
+  using CellDataContainer = typename PolyDataType::CellDataContainer;
+  using PointDataBufferType = typename PolyDataType::PointDataBufferType;
+  using CellDataBufferType = typename PolyDataType::CellDataBufferType;
+
+  /** Connectivity generated by the last update. It is shared with the
+   * output and reused until the input cells container or the filter is
+   * modified. */
+  Object::ConstPointer m_CachedInputCells;
+  ModifiedTimeType     m_CachedInputCellsMTime{ 0 };
+  ModifiedTimeType     m_CachedFilterMTime{ 0 };
+  ConnectivityType     m_CachedConnectivity;
+
+  /** Input cell data the triangle strips were generated with. */
+  Object::ConstPointer m_CachedStripsInputCellData;
+  ModifiedTimeType     m_CachedStripsInputCellDataMTime{ 0 };
+
+  /** Cell data generated by the last update, as a container or as a flat
+   * buffer, reused until the input cell data container or the connectivity
+   * changes. */
+  Object::ConstPointer                 m_CachedInputCellData;
+  ModifiedTimeType                     m_CachedInputCellDataMTime{ 0 };
+  typename CellDataContainer::Pointer  m_CachedCellData;
+  typename CellDataBufferType::Pointer m_CachedCellDataBuffer;
+  unsigned int                         m_CachedNumberOfCellDataComponents{ 0 };
+
+  /** Containers allocated by the filter. A container is free when the pool
+   * holds its only reference. Acquiring a container modifies it, so the
+   * containers acquired by the last update are modified after
+   * m_ContainerPoolTime, the start of that update. */
+  std::vector<Object::Pointer> m_ContainerPool;
+  TimeStamp                    m_ContainerPoolTime;
 };
 } // namespace itk
 
@@ -30,83 +30,1117 @@
 #include "itkTetrahedronCell.h"
 #include "itkHexahedronCell.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
 namespace
 {
 
-template <typename TMesh, typename TPolyData>
-class VisitCellsClass
+// Number of cells and connectivity entries in one of the output cell arrays
+struct CellArrayCount
 {
-public:
-  using MeshType = TMesh;
-  using PolyDataType = TPolyData;
-  // typedef the itk cells we are interested in
-  using CellInterfaceType = itk::CellInterface<typename MeshType::PixelType, typename MeshType::CellTraits>;
+  itk::SizeValueType NumberOfCells{ 0 };
+  itk::SizeValueType Size{ 0 };
 
-  using CellsContainerType = typename TPolyData::CellsContainer;
+  void
+  AddCell(itk::SizeValueType numberOfPoints)
+  {
+    ++NumberOfCells;
+    Size += numberOfPoints + 1;
+  }
 
-  using VertexCellType = itk::VertexCell<CellInterfaceType>;
-  using LineCellType = itk::LineCell<CellInterfaceType>;
-  using PolyLineCellType = itk::PolyLineCell<CellInterfaceType>;
-  using TriangleCellType = itk::TriangleCell<CellInterfaceType>;
-  using QuadrilateralCellType = itk::QuadrilateralCell<CellInterfaceType>;
-  using PolygonCellType = itk::PolygonCell<CellInterfaceType>;
-  using TetrahedronCellType = itk::TetrahedronCell<CellInterfaceType>;
-  using HexahedronCellType = itk::HexahedronCell<CellInterfaceType>;
+  CellArrayCount &
+  operator+=(const CellArrayCount & other)
+  {
+    NumberOfCells += other.NumberOfCells;
+    Size += other.Size;
+    return *this;
+  }
+};
+
+
+// Output produced by one contiguous range of input cells. Counted in a first
+// pass so that every output array can be allocated to its exact size, and
+// every range can then write its cells at its prefix-sum offset.
+struct CellRangeCounts
+{
+  CellArrayCount Vertices;
+  CellArrayCount Lines;
+  CellArrayCount PolyLines;
+  CellArrayCount Polygons;
+
+  // Faces of the tetrahedra and hexahedra, whether on the boundary or not
+  itk::SizeValueType VolumeFaces{ 0 };
+
+  // Largest number of points of a cell and largest input cell identifier,
+  // which must fit in the output cell arrays and cell id permutation
+  itk::SizeValueType MaximumNumberOfCellPoints{ 0 };
+  itk::SizeValueType MaximumCellIdentifier{ 0 };
+
+  // Type shared by all the counted cells, valid when HasCellType and not
+  // MixedCellTypes. Null cells count as mixed.
+  itk::CellGeometryEnum CellType{ itk::CellGeometryEnum::MAX_ITK_CELLS };
+  bool                  HasCellType{ false };
+  bool                  MixedCellTypes{ false };
 
-  // Set the output polydata vertices container
   void
-  SetVertices(CellsContainerType * vertices)
+  AddCellType(itk::CellGeometryEnum cellType)
   {
-    m_Vertices = vertices;
+    if (!HasCellType)
+    {
+      CellType = cellType;
+      HasCellType = true;
+    }
+    else if (cellType != CellType)
+    {
+      MixedCellTypes = true;
+    }
   }
 
-  // Set the output polydata polygons container
-  void
-  SetLines(CellsContainerType * lines)
+  CellRangeCounts &
+  operator+=(const CellRangeCounts & other)
   {
-    m_Lines = lines;
+    Vertices += other.Vertices;
+    Lines += other.Lines;
+    PolyLines += other.PolyLines;
+    Polygons += other.Polygons;
+    VolumeFaces += other.VolumeFaces;
+    MaximumNumberOfCellPoints = std::max(MaximumNumberOfCellPoints, other.MaximumNumberOfCellPoints);
+    MaximumCellIdentifier = std::max(MaximumCellIdentifier, other.MaximumCellIdentifier);
+    MixedCellTypes = MixedCellTypes || other.MixedCellTypes;
+    if (other.HasCellType)
+    {
+      this->AddCellType(other.CellType);
+    }
+    return *this;
   }
 
-  // Set the output polydata polygons container
-  void
-  SetPolygons(CellsContainerType * polygons)
+  // Whether every counted cell has the type cellType
+  bool
+  IsHomogeneous(itk::CellGeometryEnum cellType) const
   {
-    m_Polygons = polygons;
+    return HasCellType && !MixedCellTypes && CellType == cellType;
   }
+};
 
-  // Set the output polydata triangleStrips container
-  void
-  SetTriangleStrips(CellsContainerType * triangleStrips)
+
+// Count the output of the cells in [begin, end). The cell types must match
+// the ones handled by VisitCellsClass.
+template <typename TMesh>
+void
+CountCellRange(typename TMesh::CellsContainer::ConstIterator begin,
+               typename TMesh::CellsContainer::ConstIterator end,
+               CellRangeCounts &                             counts)
+{
+  for (auto cellItr = begin; cellItr != end; ++cellItr)
   {
-    m_TriangleStrips = triangleStrips;
+    const typename TMesh::CellType * cell = cellItr.Value();
+    if (!cell)
+    {
+      counts.MixedCellTypes = true;
+      continue;
+    }
+    const itk::CellGeometryEnum cellType = cell->GetType();
+    counts.AddCellType(cellType);
+    counts.MaximumNumberOfCellPoints =
+      std::max<itk::SizeValueType>(counts.MaximumNumberOfCellPoints, cell->GetNumberOfPoints());
+    counts.MaximumCellIdentifier = std::max<itk::SizeValueType>(counts.MaximumCellIdentifier, cellItr.Index());
+    switch (cellType)
+    {
+      case itk::CellGeometryEnum::VERTEX_CELL:
+        counts.Vertices.AddCell(cell->GetNumberOfPoints());
+        break;
+      case itk::CellGeometryEnum::LINE_CELL:
+        counts.Lines.AddCell(cell->GetNumberOfPoints());
+        break;
+      case itk::CellGeometryEnum::POLYLINE_CELL:
+        counts.PolyLines.AddCell(cell->GetNumberOfPoints());
+        break;
+      case itk::CellGeometryEnum::TRIANGLE_CELL:
+        counts.Polygons.AddCell(3);
+        break;
+      case itk::CellGeometryEnum::QUADRILATERAL_CELL:
+        counts.Polygons.AddCell(4);
+        break;
+      case itk::CellGeometryEnum::POLYGON_CELL:
+        counts.Polygons.AddCell(cell->GetNumberOfPoints());
+        break;
+      // The boundary faces of volumetric cells are counted once the face
+      // table is built
+      case itk::CellGeometryEnum::TETRAHEDRON_CELL:
+        counts.VolumeFaces += 4;
+        break;
+      case itk::CellGeometryEnum::HEXAHEDRON_CELL:
+        counts.VolumeFaces += 6;
+        break;
+      default:
+        break;
+    }
   }
+}
 
-  // Set the associated input cell id container
-  void
-  SetVerticesCellIds(CellsContainerType * cellIds)
+
+// Write positions of one range of input cells in the output arrays
+template <typename TElement, typename TCellId>
+struct CellRangeCursors
+{
+  using ElementType = TElement;
+  using CellIdType = TCellId;
+
+  ElementType * Vertices{ nullptr };
+  ElementType * Lines{ nullptr };
+  ElementType * PolyLines{ nullptr };
+  ElementType * Polygons{ nullptr };
+
+  // Input cell ids of the cells above, for copying cell data in output order
+  CellIdType * VerticesCellIds{ nullptr };
+  CellIdType * LinesCellIds{ nullptr };
+  CellIdType * PolyLinesCellIds{ nullptr };
+  CellIdType * PolygonsCellIds{ nullptr };
+
+  // Number of points of each face of the volumetric cells if it is on the
+  // boundary, 0 otherwise
+  const uint8_t * BoundaryFaces{ nullptr };
+};
+
+
+// Write the polygons of the cells in [begin, end), which all have the
+// fixed-size topology TCell, directly at cursors. The point ids are read
+// through non-virtual calls, bypassing the visitors.
+template <typename TCell, typename TElement, typename TCellId, typename TCellsConstIterator>
+void
+WriteHomogeneousCellRange(TCellsConstIterator                   begin,
+                          TCellsConstIterator                   end,
+                          CellRangeCursors<TElement, TCellId> & cursors)
+{
+  constexpr unsigned int numberOfPoints = TCell::NumberOfPoints;
+
+  TElement * polygons = cursors.Polygons;
+  TCellId *  polygonsCellIds = cursors.PolygonsCellIds;
+  for (auto cellItr = begin; cellItr != end; ++cellItr)
   {
-    m_VerticesCellIds = cellIds;
+    const auto * cell = static_cast<const TCell *>(cellItr.Value());
+    const auto * pointIds = cell->TCell::PointIdsBegin();
+    *polygons++ = numberOfPoints;
+    for (unsigned int ii = 0; ii < numberOfPoints; ++ii)
+    {
+      *polygons++ = static_cast<TElement>(pointIds[ii]);
+    }
+    *polygonsCellIds++ = static_cast<TCellId>(cellItr.Index());
   }
+  cursors.Polygons = polygons;
+  cursors.PolygonsCellIds = polygonsCellIds;
+}
 
-  // Set the associated input cell id container
-  void
-  SetLinesCellIds(CellsContainerType * cellIds)
+
+// Convert the points of a mesh to PolyData points in a single pass. The
+// coordinates are cast to the PolyData coordinate type, and the third
+// coordinate of 2D points defaults to 0.0. Contiguous input is converted in
+// parallel blocks with flat loops over the coordinates that the compiler
+// can vectorize.
+template <typename TInputPointsContainer, typename TOutputPointsContainer>
+void
+ConvertPoints(const TInputPointsContainer * inputPoints,
+              TOutputPointsContainer *      outputPoints,
+              itk::MultiThreaderBase *      multiThreader,
+              itk::ThreadIdType             numberOfWorkUnits)
+{
+  using InputPointType = typename TInputPointsContainer::Element;
+  using OutputPointType = typename TOutputPointsContainer::Element;
+  using InputCoordinateType = typename InputPointType::ValueType;
+  using OutputCoordinateType = typename OutputPointType::ValueType;
+  constexpr unsigned int InputDimension = InputPointType::PointDimension;
+  constexpr unsigned int OutputDimension = OutputPointType::PointDimension;
+  constexpr unsigned int CopiedDimension = std::min(InputDimension, OutputDimension);
+
+  const itk::SizeValueType numberOfPoints = inputPoints->Size();
+  outputPoints->resize(numberOfPoints);
+  if (numberOfPoints == 0)
   {
-    m_LinesCellIds = cellIds;
+    return;
   }
 
-  // Set the associated input cell id container
-  void
-  SetPolygonsCellIds(CellsContainerType * cellIds)
+  if constexpr (std::is_same<typename TInputPointsContainer::STLContainerType, std::vector<InputPointType>>::value)
+  {
+    static_assert(sizeof(InputPointType) == InputDimension * sizeof(InputCoordinateType),
+                  "Points must be stored as contiguous coordinates");
+    static_assert(sizeof(OutputPointType) == OutputDimension * sizeof(OutputCoordinateType),
+                  "Points must be stored as contiguous coordinates");
+
+    const InputCoordinateType * input = inputPoints->CastToSTLConstContainer().data()->GetDataPointer();
+    OutputCoordinateType *      output = outputPoints->CastToSTLContainer().data()->GetDataPointer();
+
+    const itk::SizeValueType numberOfBlocks =
+      std::max<itk::SizeValueType>(1, std::min<itk::SizeValueType>(numberOfWorkUnits, numberOfPoints));
+    const itk::SizeValueType pointsPerBlock = (numberOfPoints + numberOfBlocks - 1) / numberOfBlocks;
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfBlocks,
+      [input, output, numberOfPoints, pointsPerBlock](itk::SizeValueType block) {
+        const itk::SizeValueType begin = block * pointsPerBlock;
+        const itk::SizeValueType end = std::min(begin + pointsPerBlock, numberOfPoints);
+        if constexpr (InputDimension == OutputDimension)
+        {
+          for (itk::SizeValueType ii = begin * OutputDimension; ii < end * OutputDimension; ++ii)
+          {
+            output[ii] = static_cast<OutputCoordinateType>(input[ii]);
+          }
+        }
+        else
+        {
+          for (itk::SizeValueType pointId = begin; pointId < end; ++pointId)
+          {
+            const InputCoordinateType * inputPoint = input + pointId * InputDimension;
+            OutputCoordinateType *      outputPoint = output + pointId * OutputDimension;
+            for (unsigned int ii = 0; ii < CopiedDimension; ++ii)
+            {
+              outputPoint[ii] = static_cast<OutputCoordinateType>(inputPoint[ii]);
+            }
+            for (unsigned int ii = CopiedDimension; ii < OutputDimension; ++ii)
+            {
+              outputPoint[ii] = OutputCoordinateType{ 0 };
+            }
+          }
+        }
+      },
+      nullptr);
+  }
+  else
+  {
+    auto outputPointItr = outputPoints->Begin();
+    for (auto inputPointItr = inputPoints->Begin(); inputPointItr != inputPoints->End();
+         ++inputPointItr, ++outputPointItr)
+    {
+      OutputPointType & outputPoint = outputPointItr.Value();
+      for (unsigned int ii = 0; ii < CopiedDimension; ++ii)
+      {
+        outputPoint[ii] = static_cast<OutputCoordinateType>(inputPointItr.Value()[ii]);
+      }
+      for (unsigned int ii = CopiedDimension; ii < OutputDimension; ++ii)
+      {
+        outputPoint[ii] = OutputCoordinateType{ 0 };
+      }
+    }
+  }
+}
+
+
+// Gather the points of input with ids pointIds[0], ..., pointIds[count - 1]
+// into output in parallel blocks, converting them to the output point type.
+// The coordinates the input does not have are set to 0.0.
+template <typename TInputPointsContainer, typename TIndex, typename TOutputPointsContainer>
+void
+GatherPoints(const TInputPointsContainer * input,
+             const TIndex *                pointIds,
+             itk::SizeValueType            count,
+             TOutputPointsContainer *      output,
+             itk::MultiThreaderBase *      multiThreader,
+             itk::SizeValueType            numberOfWorkUnits)
+{
+  using InputPointType = typename TInputPointsContainer::Element;
+  using OutputPointType = typename TOutputPointsContainer::Element;
+  using OutputCoordinateType = typename OutputPointType::ValueType;
+  constexpr unsigned int InputDimension = InputPointType::PointDimension;
+  constexpr unsigned int OutputDimension = OutputPointType::PointDimension;
+  constexpr unsigned int CopiedDimension = std::min(InputDimension, OutputDimension);
+
+  output->resize(count);
+  if (count == 0)
+  {
+    return;
+  }
+  OutputPointType * outputPoints = output->CastToSTLContainer().data();
+
+  const itk::SizeValueType numberOfBlocks = std::max<itk::SizeValueType>(1, std::min(numberOfWorkUnits, count));
+  const itk::SizeValueType pointsPerBlock = (count + numberOfBlocks - 1) / numberOfBlocks;
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [input, pointIds, count, outputPoints, pointsPerBlock](itk::SizeValueType block) {
+      const itk::SizeValueType end = std::min(count, (block + 1) * pointsPerBlock);
+      for (itk::SizeValueType ii = block * pointsPerBlock; ii < end; ++ii)
+      {
+        const InputPointType & inputPoint = input->ElementAt(pointIds[ii]);
+        OutputPointType &      outputPoint = outputPoints[ii];
+        for (unsigned int dim = 0; dim < CopiedDimension; ++dim)
+        {
+          outputPoint[dim] = static_cast<OutputCoordinateType>(inputPoint[dim]);
+        }
+        for (unsigned int dim = CopiedDimension; dim < OutputDimension; ++dim)
+        {
+          outputPoint[dim] = OutputCoordinateType{ 0 };
+        }
+      }
+    },
+    nullptr);
+}
+
+
+// Split a cell array in the [n p0 p1 ...] layout into about numberOfBlocks
+// blocks of whole cells. Returns the start position of every block, followed
+// by the size of the array.
+template <typename TElement>
+std::vector<itk::SizeValueType>
+SplitCellArray(const std::vector<TElement> & cellArray, itk::SizeValueType numberOfBlocks)
+{
+  const itk::SizeValueType        blockSize = std::max<itk::SizeValueType>(1, cellArray.size() / numberOfBlocks);
+  std::vector<itk::SizeValueType> blockStarts;
+  for (itk::SizeValueType position = 0; position < cellArray.size(); position += cellArray[position] + 1)
+  {
+    if (blockStarts.empty() || position >= blockStarts.back() + blockSize)
+    {
+      blockStarts.push_back(position);
+    }
+  }
+  blockStarts.push_back(cellArray.size());
+  return blockStarts;
+}
+
+
+// Remove the points that no cell of cellArrays uses. The used points keep
+// their relative order: their new ids are the exclusive prefix sum of the
+// used flags, computed in parallel blocks, and the cell arrays are
+// renumbered in place. pointIds receives the input id of every used point.
+// Returns false if a cell uses a point id that is not less than
+// numberOfPoints.
+template <typename TElement>
+bool
+RemoveUnusedPointIds(const std::vector<std::vector<TElement> *> & cellArrays,
+                     itk::SizeValueType                           numberOfPoints,
+                     std::vector<TElement> &                      pointIds,
+                     itk::MultiThreaderBase *                     multiThreader,
+                     itk::SizeValueType                           numberOfWorkUnits)
+{
+  const itk::SizeValueType numberOfBlocks = std::max<itk::SizeValueType>(1, numberOfWorkUnits);
+
+  std::vector<std::vector<itk::SizeValueType>> cellArrayBlocks;
+  for (const std::vector<TElement> * cellArray : cellArrays)
+  {
+    cellArrayBlocks.push_back(SplitCellArray(*cellArray, numberOfBlocks));
+  }
+
+  // Flag the used points. Several blocks may flag the same point, so the
+  // flags are atomic.
+  std::vector<std::atomic<uint8_t>> used(numberOfPoints);
+  std::atomic<bool>                 invalidPointId{ false };
+  const auto                        forEachCellArrayBlock = [&](auto && function) {
+    for (itk::SizeValueType array = 0; array < cellArrays.size(); ++array)
+    {
+      const std::vector<itk::SizeValueType> & blockStarts = cellArrayBlocks[array];
+      multiThreader->ParallelizeArray(
+        0,
+        blockStarts.size() - 1,
+        [&](itk::SizeValueType block) {
+          std::vector<TElement> & cellArray = *cellArrays[array];
+          for (itk::SizeValueType position = blockStarts[block]; position < blockStarts[block + 1];
+               position += cellArray[position] + 1)
+          {
+            for (itk::SizeValueType ii = position + 1; ii <= position + cellArray[position]; ++ii)
+            {
+              function(cellArray[ii]);
+            }
+          }
+        },
+        nullptr);
+    }
+  };
+  forEachCellArrayBlock([&used, &invalidPointId, numberOfPoints](TElement & pointId) {
+    if (pointId < numberOfPoints)
+    {
+      used[pointId].store(1, std::memory_order_relaxed);
+    }
+    else
+    {
+      invalidPointId = true;
+    }
+  });
+  if (invalidPointId)
+  {
+    return false;
+  }
+
+  // Exclusive prefix sum of the flags, by blocks of points
+  const itk::SizeValueType        pointBlocks =
+    std::max<itk::SizeValueType>(1, std::min(numberOfBlocks, numberOfPoints));
+  const itk::SizeValueType        pointsPerBlock = (numberOfPoints + pointBlocks - 1) / pointBlocks;
+  std::vector<itk::SizeValueType> blockOffsets(pointBlocks + 1, 0);
+  multiThreader->ParallelizeArray(
+    0,
+    pointBlocks,
+    [&](itk::SizeValueType block) {
+      const itk::SizeValueType end = std::min(numberOfPoints, (block + 1) * pointsPerBlock);
+      itk::SizeValueType       count = 0;
+      for (itk::SizeValueType pointId = block * pointsPerBlock; pointId < end; ++pointId)
+      {
+        count += used[pointId].load(std::memory_order_relaxed);
+      }
+      blockOffsets[block + 1] = count;
+    },
+    nullptr);
+  for (itk::SizeValueType block = 0; block < pointBlocks; ++block)
+  {
+    blockOffsets[block + 1] += blockOffsets[block];
+  }
+
+  std::vector<TElement> newIds(numberOfPoints);
+  pointIds.resize(blockOffsets.back());
+  multiThreader->ParallelizeArray(
+    0,
+    pointBlocks,
+    [&](itk::SizeValueType block) {
+      const itk::SizeValueType end = std::min(numberOfPoints, (block + 1) * pointsPerBlock);
+      TElement                 newId = static_cast<TElement>(blockOffsets[block]);
+      for (itk::SizeValueType pointId = block * pointsPerBlock; pointId < end; ++pointId)
+      {
+        if (used[pointId].load(std::memory_order_relaxed))
+        {
+          newIds[pointId] = newId;
+          pointIds[newId++] = static_cast<TElement>(pointId);
+        }
+      }
+    },
+    nullptr);
+
+  forEachCellArrayBlock([&newIds](TElement & pointId) { pointId = newIds[pointId]; });
+  return true;
+}
+
+
+// Gather output[ii] = input[permutation[ii]] for ii in [0, count), in
+// parallel blocks into a preallocated output. Contiguous input is read
+// through a raw pointer, so that the loop over scalar pixels can be
+// vectorized.
+template <typename TInputContainer, typename TIndex, typename TOutputContainer>
+void
+GatherPixels(const TInputContainer *  input,
+             const TIndex *           permutation,
+             itk::SizeValueType       count,
+             TOutputContainer *       output,
+             itk::MultiThreaderBase * multiThreader,
+             itk::SizeValueType       numberOfWorkUnits)
+{
+  using InputPixelType = typename TInputContainer::Element;
+  using OutputPixelType = typename TOutputContainer::Element;
+
+  output->resize(count);
+  if (count == 0)
   {
-    m_PolygonsCellIds = cellIds;
+    return;
   }
+  OutputPixelType * outputPixels = output->CastToSTLContainer().data();
+
+  const itk::SizeValueType numberOfBlocks = std::max<itk::SizeValueType>(1, std::min(numberOfWorkUnits, count));
+  const itk::SizeValueType pixelsPerBlock = (count + numberOfBlocks - 1) / numberOfBlocks;
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [input, permutation, count, outputPixels, pixelsPerBlock](itk::SizeValueType block) {
+      const itk::SizeValueType begin = block * pixelsPerBlock;
+      const itk::SizeValueType end = std::min(count, begin + pixelsPerBlock);
+      if constexpr (std::is_same<typename TInputContainer::STLContainerType, std::vector<InputPixelType>>::value)
+      {
+        const InputPixelType * inputPixels = input->CastToSTLConstContainer().data();
+        for (itk::SizeValueType ii = begin; ii < end; ++ii)
+        {
+          outputPixels[ii] = inputPixels[permutation[ii]];
+        }
+      }
+      else
+      {
+        for (itk::SizeValueType ii = begin; ii < end; ++ii)
+        {
+          outputPixels[ii] = input->ElementAt(permutation[ii]);
+        }
+      }
+    },
+    nullptr);
+}
+
+
+// Vertex cache optimization from T. Forsyth, "Linear-Speed Vertex Cache
+// Optimisation", 2006, with its recommended parameters
+constexpr int VertexCacheSize = 32;
+
+
+// Score of a vertex at cachePosition in the simulated cache, -1 when not in
+// the cache, used by remainingFaces faces that are not emitted yet
+inline float
+VertexCacheScore(int cachePosition, itk::SizeValueType remainingFaces)
+{
+  if (remainingFaces == 0)
+  {
+    return -1.0f;
+  }
+  float score = 0.0f;
+  if (cachePosition >= 0)
+  {
+    // The vertices of the last face are scored equally, whatever their
+    // order in the face
+    score = cachePosition < 3 ? 0.75f
+                              : std::pow(1.0f - static_cast<float>(cachePosition - 3) / (VertexCacheSize - 3), 1.5f);
+  }
+  // Favor vertices with few remaining faces, to finish them off
+  return score + 2.0f * std::pow(static_cast<float>(remainingFaces), -0.5f);
+}
+
 
-  // Set the associated input cell id container
+// Reorder the polygons stored in [begin, end) of polygons, in the [n p0 p1
+// ...] layout, to improve the reuse of a GPU vertex cache, and write them in
+// the same range of outputPolygons. The input cell ids of the polygons,
+// cellIds, are reordered along into outputCellIds.
+template <typename TElement, typename TCellId>
+void
+OptimizeVertexCacheBlock(const TElement *   polygons,
+                         itk::SizeValueType begin,
+                         itk::SizeValueType end,
+                         const TCellId *    cellIds,
+                         TElement *         outputPolygons,
+                         TCellId *          outputCellIds)
+{
+  constexpr itk::SizeValueType NoFace = std::numeric_limits<itk::SizeValueType>::max();
+
+  std::vector<itk::SizeValueType> faceStarts;
+  std::vector<itk::SizeValueType> faceCorners;
+  itk::SizeValueType              numberOfCorners = 0;
+  for (itk::SizeValueType position = begin; position < end; position += polygons[position] + 1)
+  {
+    faceStarts.push_back(position);
+    faceCorners.push_back(numberOfCorners);
+    numberOfCorners += polygons[position];
+  }
+  const itk::SizeValueType numberOfFaces = faceStarts.size();
+  faceCorners.push_back(numberOfCorners);
+
+  // Number the vertices of the block by sorting its corners by point id, and
+  // build the list of faces of each vertex
+  std::vector<std::pair<TElement, itk::SizeValueType>> corners;
+  corners.reserve(numberOfCorners);
+  std::vector<itk::SizeValueType> cornerFaces(numberOfCorners);
+  for (itk::SizeValueType face = 0; face < numberOfFaces; ++face)
+  {
+    for (itk::SizeValueType corner = faceCorners[face]; corner < faceCorners[face + 1]; ++corner)
+    {
+      corners.emplace_back(polygons[faceStarts[face] + 1 + corner - faceCorners[face]], corner);
+      cornerFaces[corner] = face;
+    }
+  }
+  std::sort(corners.begin(), corners.end());
+
+  std::vector<itk::SizeValueType> cornerVertices(numberOfCorners);
+  std::vector<itk::SizeValueType> vertexFacesBegin;
+  std::vector<itk::SizeValueType> vertexFaces(numberOfCorners);
+  for (itk::SizeValueType ii = 0; ii < numberOfCorners; ++ii)
+  {
+    if (ii == 0 || corners[ii].first != corners[ii - 1].first)
+    {
+      vertexFacesBegin.push_back(ii);
+    }
+    cornerVertices[corners[ii].second] = vertexFacesBegin.size() - 1;
+    vertexFaces[ii] = cornerFaces[corners[ii].second];
+  }
+  const itk::SizeValueType numberOfVertices = vertexFacesBegin.size();
+  vertexFacesBegin.push_back(numberOfCorners);
+
+  std::vector<itk::SizeValueType> remainingFaces(numberOfVertices);
+  std::vector<int>                cachePositions(numberOfVertices, -1);
+  std::vector<float>              vertexScores(numberOfVertices);
+  for (itk::SizeValueType vertex = 0; vertex < numberOfVertices; ++vertex)
+  {
+    remainingFaces[vertex] = vertexFacesBegin[vertex + 1] - vertexFacesBegin[vertex];
+    vertexScores[vertex] = VertexCacheScore(-1, remainingFaces[vertex]);
+  }
+  std::vector<float>   faceScores(numberOfFaces, 0.0f);
+  std::vector<uint8_t> faceEmitted(numberOfFaces, 0);
+  for (itk::SizeValueType face = 0; face < numberOfFaces; ++face)
+  {
+    for (itk::SizeValueType corner = faceCorners[face]; corner < faceCorners[face + 1]; ++corner)
+    {
+      faceScores[face] += vertexScores[cornerVertices[corner]];
+    }
+  }
+
+  std::vector<itk::SizeValueType> cache;
+  std::vector<itk::SizeValueType> nextCache;
+  itk::SizeValueType              nextInputFace = 0;
+  itk::SizeValueType              bestFace = NoFace;
+  itk::SizeValueType              outputPosition = begin;
+  for (itk::SizeValueType emitted = 0; emitted < numberOfFaces; ++emitted)
+  {
+    // When no face touches the cache, continue with the next face in input
+    // order, which keeps the search linear
+    if (bestFace == NoFace)
+    {
+      while (faceEmitted[nextInputFace])
+      {
+        ++nextInputFace;
+      }
+      bestFace = nextInputFace;
+    }
+
+    const itk::SizeValueType face = bestFace;
+    faceEmitted[face] = 1;
+    std::copy(polygons + faceStarts[face],
+              polygons + faceStarts[face] + polygons[faceStarts[face]] + 1,
+              outputPolygons + outputPosition);
+    outputPosition += polygons[faceStarts[face]] + 1;
+    outputCellIds[emitted] = cellIds[face];
+
+    // Move the vertices of the face to the front of the cache
+    nextCache.clear();
+    for (itk::SizeValueType corner = faceCorners[face]; corner < faceCorners[face + 1]; ++corner)
+    {
+      const itk::SizeValueType vertex = cornerVertices[corner];
+      --remainingFaces[vertex];
+      if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end())
+      {
+        nextCache.push_back(vertex);
+      }
+    }
+    const itk::SizeValueType numberOfFaceVertices = nextCache.size();
+    for (const itk::SizeValueType vertex : cache)
+    {
+      const auto faceVerticesEnd = nextCache.begin() + numberOfFaceVertices;
+      if (std::find(nextCache.begin(), faceVerticesEnd, vertex) == faceVerticesEnd)
+      {
+        nextCache.push_back(vertex);
+      }
+    }
+    std::swap(cache, nextCache);
+
+    // Rescore the vertices whose cache position or remaining faces changed,
+    // including the ones pushed out of the cache, and update the scores of
+    // their faces
+    for (itk::SizeValueType position = 0; position < cache.size(); ++position)
+    {
+      const itk::SizeValueType vertex = cache[position];
+      cachePositions[vertex] = position < VertexCacheSize ? static_cast<int>(position) : -1;
+      const float score = VertexCacheScore(cachePositions[vertex], remainingFaces[vertex]);
+      const float delta = score - vertexScores[vertex];
+      vertexScores[vertex] = score;
+      for (itk::SizeValueType ii = vertexFacesBegin[vertex]; ii < vertexFacesBegin[vertex + 1]; ++ii)
+      {
+        faceScores[vertexFaces[ii]] += delta;
+      }
+    }
+    if (cache.size() > VertexCacheSize)
+    {
+      cache.resize(VertexCacheSize);
+    }
+
+    // The next face is the best one using a vertex in the cache
+    bestFace = NoFace;
+    float bestScore = -std::numeric_limits<float>::max();
+    for (const itk::SizeValueType vertex : cache)
+    {
+      for (itk::SizeValueType ii = vertexFacesBegin[vertex]; ii < vertexFacesBegin[vertex + 1]; ++ii)
+      {
+        const itk::SizeValueType candidate = vertexFaces[ii];
+        if (!faceEmitted[candidate] && faceScores[candidate] > bestScore)
+        {
+          bestScore = faceScores[candidate];
+          bestFace = candidate;
+        }
+      }
+    }
+  }
+}
+
+
+// Faces of the volumetric cells, as indices of the cell points, ordered so
+// that the face normals point outwards
+constexpr unsigned int TetrahedronFaces[4][3] = { { 0, 1, 3 }, { 1, 2, 3 }, { 2, 0, 3 }, { 0, 2, 1 } };
+constexpr unsigned int HexahedronFaces[6][4] = { { 0, 4, 7, 3 }, { 1, 2, 6, 5 }, { 0, 1, 5, 4 },
+                                                 { 3, 7, 6, 2 }, { 0, 3, 2, 1 }, { 4, 5, 6, 7 } };
+
+
+// Hash of a key of point ids, used to distribute records among buckets
+template <typename TElement, size_t VLength>
+uint64_t
+HashKey(const std::array<TElement, VLength> & key)
+{
+  uint64_t hash = 0;
+  for (const TElement pointId : key)
+  {
+    hash = (hash ^ static_cast<uint64_t>(pointId)) * 0x9E3779B97F4A7C15ull;
+  }
+  return hash ^ (hash >> 32);
+}
+
+
+constexpr itk::SizeValueType NumberOfRecordBuckets = 1024;
+
+
+// Group the records generated by forEachRecord(range, function) for each of
+// the rangeCount ranges so that records with equal keys are adjacent. The
+// records of each range are hashed into buckets in parallel, then each
+// bucket is sorted by key in parallel. On return, the records of bucket b
+// are in [bucketBegin[b], bucketBegin[b + 1]), in a deterministic order.
+template <typename TRecord, typename TForEachRecord>
+void
+SortRecordsInBuckets(itk::SizeValueType                rangeCount,
+                     TForEachRecord &&                 forEachRecord,
+                     std::vector<TRecord> &            records,
+                     std::vector<itk::SizeValueType> & bucketBegin,
+                     itk::MultiThreaderBase *          multiThreader)
+{
+  // Count the records of each range that fall in each bucket
+  std::vector<itk::SizeValueType> bucketCounts(rangeCount * NumberOfRecordBuckets, 0);
+  multiThreader->ParallelizeArray(
+    0,
+    rangeCount,
+    [&](itk::SizeValueType range) {
+      itk::SizeValueType * counts = bucketCounts.data() + range * NumberOfRecordBuckets;
+      forEachRecord(range, [counts](const TRecord & record) { ++counts[HashKey(record.Key) % NumberOfRecordBuckets]; });
+    },
+    nullptr);
+
+  // Bucket major prefix sum, so that each bucket is contiguous and each
+  // range writes its part of a bucket at its own offset
+  bucketBegin.assign(NumberOfRecordBuckets + 1, 0);
+  itk::SizeValueType offset = 0;
+  for (itk::SizeValueType bucket = 0; bucket < NumberOfRecordBuckets; ++bucket)
+  {
+    bucketBegin[bucket] = offset;
+    for (itk::SizeValueType range = 0; range < rangeCount; ++range)
+    {
+      const itk::SizeValueType count = bucketCounts[range * NumberOfRecordBuckets + bucket];
+      bucketCounts[range * NumberOfRecordBuckets + bucket] = offset;
+      offset += count;
+    }
+  }
+  bucketBegin[NumberOfRecordBuckets] = offset;
+
+  records.resize(offset);
+  multiThreader->ParallelizeArray(
+    0,
+    rangeCount,
+    [&](itk::SizeValueType range) {
+      itk::SizeValueType * offsets = bucketCounts.data() + range * NumberOfRecordBuckets;
+      forEachRecord(range, [offsets, &records](const TRecord & record) {
+        records[offsets[HashKey(record.Key) % NumberOfRecordBuckets]++] = record;
+      });
+    },
+    nullptr);
+
+  // Records are unique by key and index, so the sorted order does not
+  // depend on the number of ranges
+  multiThreader->ParallelizeArray(
+    0,
+    NumberOfRecordBuckets,
+    [&](itk::SizeValueType bucket) {
+      std::sort(records.begin() + bucketBegin[bucket],
+                records.begin() + bucketBegin[bucket + 1],
+                [](const TRecord & a, const TRecord & b) {
+                  return a.Key < b.Key || (a.Key == b.Key && a.Index < b.Index);
+                });
+    },
+    nullptr);
+}
+
+
+// Call function(begin, end) for each run of records with equal keys, with
+// the buckets processed in parallel
+template <typename TRecord, typename TFunction>
+void
+ForEachRecordRun(const std::vector<TRecord> &            records,
+                 const std::vector<itk::SizeValueType> & bucketBegin,
+                 TFunction &&                            function,
+                 itk::MultiThreaderBase *                multiThreader)
+{
+  multiThreader->ParallelizeArray(
+    0,
+    NumberOfRecordBuckets,
+    [&](itk::SizeValueType bucket) {
+      const auto bucketEnd = records.begin() + bucketBegin[bucket + 1];
+      for (auto runBegin = records.begin() + bucketBegin[bucket]; runBegin != bucketEnd;)
+      {
+        auto runEnd = runBegin + 1;
+        while (runEnd != bucketEnd && runEnd->Key == runBegin->Key)
+        {
+          ++runEnd;
+        }
+        function(runBegin, runEnd);
+        runBegin = runEnd;
+      }
+    },
+    nullptr);
+}
+
+
+// A face of a volumetric cell, identified by its sorted point ids, with the
+// index of the face among all the faces of the volumetric cells. Triangles
+// pad their key with the largest point id.
+template <typename TElement>
+struct VolumeFaceRecord
+{
+  std::array<TElement, 4> Key;
+  itk::SizeValueType      Index;
+};
+
+
+// Call function(record) for each face of the tetrahedra and hexahedra in
+// [begin, end), numbering the faces from firstFace in cell order
+template <typename TElement, typename TMesh, typename TFunction>
+void
+ForEachVolumeFace(typename TMesh::CellsContainer::ConstIterator begin,
+                  typename TMesh::CellsContainer::ConstIterator end,
+                  itk::SizeValueType                            firstFace,
+                  TFunction &&                                  function)
+{
+  VolumeFaceRecord<TElement> record;
+  record.Index = firstFace;
+  const auto addFaces = [&record, &function](const auto * pointIds, const auto & faces) {
+    for (const auto & face : faces)
+    {
+      record.Key.fill(std::numeric_limits<TElement>::max());
+      for (unsigned int ii = 0; ii < std::size(face); ++ii)
+      {
+        record.Key[ii] = static_cast<TElement>(pointIds[face[ii]]);
+      }
+      std::sort(record.Key.begin(), record.Key.begin() + std::size(face));
+      function(record);
+      ++record.Index;
+    }
+  };
+  for (auto cellItr = begin; cellItr != end; ++cellItr)
+  {
+    const typename TMesh::CellType * cell = cellItr.Value();
+    if (!cell)
+    {
+      continue;
+    }
+    const itk::CellGeometryEnum cellType = cell->GetType();
+    if (cellType == itk::CellGeometryEnum::TETRAHEDRON_CELL)
+    {
+      addFaces(cell->PointIdsBegin(), TetrahedronFaces);
+    }
+    else if (cellType == itk::CellGeometryEnum::HEXAHEDRON_CELL)
+    {
+      addFaces(cell->PointIdsBegin(), HexahedronFaces);
+    }
+  }
+}
+
+
+// Find the faces of the tetrahedra and hexahedra that are not shared by two
+// cells. boundaryFaces receives, for every face, its number of points if it
+// is on the boundary and 0 otherwise.
+template <typename TElement, typename TMesh>
+void
+FindBoundaryFaces(const std::vector<typename TMesh::CellsContainer::ConstIterator> & rangeBegin,
+                  const std::vector<itk::SizeValueType> &                            rangeFirstFace,
+                  std::vector<uint8_t> &                                             boundaryFaces,
+                  itk::MultiThreaderBase *                                           multiThreader)
+{
+  using RecordType = VolumeFaceRecord<TElement>;
+
+  std::vector<RecordType>         records;
+  std::vector<itk::SizeValueType> bucketBegin;
+  SortRecordsInBuckets(
+    rangeFirstFace.size() - 1,
+    [&rangeBegin, &rangeFirstFace](itk::SizeValueType range, auto && function) {
+      ForEachVolumeFace<TElement, TMesh>(rangeBegin[range], rangeBegin[range + 1], rangeFirstFace[range], function);
+    },
+    records,
+    bucketBegin,
+    multiThreader);
+
+  // A face is on the boundary when no other face has the same key
+  boundaryFaces.assign(rangeFirstFace.back(), 0);
+  ForEachRecordRun(
+    records,
+    bucketBegin,
+    [&boundaryFaces](auto runBegin, auto runEnd) {
+      if (runEnd - runBegin == 1)
+      {
+        const bool isTriangle = runBegin->Key[3] == std::numeric_limits<TElement>::max();
+        boundaryFaces[runBegin->Index] = isTriangle ? 3 : 4;
+      }
+    },
+    multiThreader);
+}
+
+
+// An edge of a triangle, identified by its sorted point ids, with the index
+// of the half-edge, 3 * triangle + edge, where edge goes from the point edge
+// to the point (edge + 1) % 3 of the triangle
+template <typename TElement>
+struct HalfEdgeRecord
+{
+  std::array<TElement, 2> Key;
+  itk::SizeValueType      Index;
+};
+
+
+constexpr itk::SizeValueType NoNeighbor = std::numeric_limits<itk::SizeValueType>::max();
+
+
+// Pair the half-edges of the triangles with the opposite half-edge of their
+// neighbor. Only edges shared by exactly two triangles with a consistent
+// winding, and where canJoin(triangle, otherTriangle) holds, are paired.
+// neighbors receives the paired half-edge of each half-edge, or NoNeighbor.
+template <typename TElement, typename TCanJoin>
+void
+FindTriangleNeighbors(const std::vector<std::array<TElement, 3>> & triangles,
+                      itk::SizeValueType                           rangeCount,
+                      TCanJoin &&                                  canJoin,
+                      std::vector<itk::SizeValueType> &            neighbors,
+                      itk::MultiThreaderBase *                     multiThreader)
+{
+  using RecordType = HalfEdgeRecord<TElement>;
+
+  const itk::SizeValueType numberOfTriangles = triangles.size();
+  const itk::SizeValueType trianglesPerRange = (numberOfTriangles + rangeCount - 1) / rangeCount;
+
+  std::vector<RecordType>         records;
+  std::vector<itk::SizeValueType> bucketBegin;
+  SortRecordsInBuckets(
+    rangeCount,
+    [&triangles, trianglesPerRange, numberOfTriangles](itk::SizeValueType range, auto && function) {
+      const itk::SizeValueType last = std::min(numberOfTriangles, (range + 1) * trianglesPerRange);
+      RecordType               record;
+      for (itk::SizeValueType triangle = range * trianglesPerRange; triangle < last; ++triangle)
+      {
+        for (unsigned int edge = 0; edge < 3; ++edge)
+        {
+          const TElement first = triangles[triangle][edge];
+          const TElement second = triangles[triangle][(edge + 1) % 3];
+          record.Key = { std::min(first, second), std::max(first, second) };
+          record.Index = 3 * triangle + edge;
+          function(record);
+        }
+      }
+    },
+    records,
+    bucketBegin,
+    multiThreader);
+
+  neighbors.assign(3 * numberOfTriangles, NoNeighbor);
+  ForEachRecordRun(
+    records,
+    bucketBegin,
+    [&triangles, &canJoin, &neighbors](auto runBegin, auto runEnd) {
+      if (runEnd - runBegin != 2)
+      {
+        return;
+      }
+      const itk::SizeValueType first = runBegin->Index;
+      const itk::SizeValueType second = (runBegin + 1)->Index;
+      // Consistently wound neighbors traverse the shared edge in opposite
+      // directions
+      const bool opposite = triangles[first / 3][first % 3] != triangles[second / 3][second % 3];
+      if (opposite && first / 3 != second / 3 && canJoin(first / 3, second / 3))
+      {
+        neighbors[first] = second;
+        neighbors[second] = first;
+      }
+    },
+    multiThreader);
+}
+
+
+// Greedily join the triangles in [first, last) into strips, following the
+// paired half-edges that stay in the range. Every strip is appended to
+// strips as its number of points followed by its points, and its first
+// triangle is appended to stripTriangles.
+template <typename TElement>
+void
+StripTriangleRange(const std::vector<std::array<TElement, 3>> & triangles,
+                   const std::vector<itk::SizeValueType> &      neighbors,
+                   itk::SizeValueType                           first,
+                   itk::SizeValueType                           last,
+                   std::vector<uint8_t> &                       visited,
+                   std::vector<TElement> &                      strips,
+                   std::vector<itk::SizeValueType> &            stripTriangles)
+{
+  const auto nextTriangle = [&](itk::SizeValueType triangle, unsigned int edge) -> itk::SizeValueType {
+    const itk::SizeValueType halfEdge = neighbors[3 * triangle + edge];
+    if (halfEdge == NoNeighbor || halfEdge / 3 < first || halfEdge / 3 >= last || visited[halfEdge / 3])
+    {
+      return NoNeighbor;
+    }
+    return halfEdge;
+  };
+
+  for (itk::SizeValueType start = first; start < last; ++start)
+  {
+    if (visited[start])
+    {
+      continue;
+    }
+    visited[start] = 1;
+
+    // Start so that the edge between the last two points leads to a
+    // neighbor, when there is one
+    unsigned int rotation = 0;
+    while (rotation < 3 && nextTriangle(start, (rotation + 1) % 3) == NoNeighbor)
+    {
+      ++rotation;
+    }
+    rotation %= 3;
+
+    const itk::SizeValueType countPosition = strips.size();
+    strips.push_back(3);
+    for (unsigned int ii = 0; ii < 3; ++ii)
+    {
+      strips.push_back(triangles[start][(rotation + ii) % 3]);
+    }
+    stripTriangles.push_back(start);
+
+    // Each next triangle shares the edge between the last two points of the
+    // strip, and adds its third point
+    itk::SizeValueType triangle = start;
+    unsigned int       edge = (rotation + 1) % 3;
+    // The number of points of a strip stays below the largest TElement,
+    // which is reserved
+    for (itk::SizeValueType halfEdge = nextTriangle(triangle, edge);
+         halfEdge != NoNeighbor && strips[countPosition] < std::numeric_limits<TElement>::max() - 1;
+         halfEdge = nextTriangle(triangle, edge))
+    {
+      triangle = halfEdge / 3;
+      const unsigned int sharedEdge = halfEdge % 3;
+      const TElement     lastPoint = strips.back();
+      strips.push_back(triangles[triangle][(sharedEdge + 2) % 3]);
+      ++strips[countPosition];
+      visited[triangle] = 1;
+      edge = triangles[triangle][(sharedEdge + 1) % 3] == lastPoint ? (sharedEdge + 1) % 3 : (sharedEdge + 2) % 3;
+    }
+  }
+}
+
+
+template <typename TMesh, typename TCursors>
+class VisitCellsClass
+{
+public:
+  using MeshType = TMesh;
+  // typedef the itk cells we are interested in
+  using CellInterfaceType = itk::CellInterface<typename MeshType::PixelType, typename MeshType::CellTraits>;
+
+  using VertexCellType = itk::VertexCell<CellInterfaceType>;
+  using LineCellType = itk::LineCell<CellInterfaceType>;
+  using PolyLineCellType = itk::PolyLineCell<CellInterfaceType>;
+  using TriangleCellType = itk::TriangleCell<CellInterfaceType>;
+  using QuadrilateralCellType = itk::QuadrilateralCell<CellInterfaceType>;
+  using PolygonCellType = itk::PolygonCell<CellInterfaceType>;
+  using TetrahedronCellType = itk::TetrahedronCell<CellInterfaceType>;
+  using HexahedronCellType = itk::HexahedronCell<CellInterfaceType>;
+
+  using CursorsType = TCursors;
+  using CellIdType = typename CursorsType::CellIdType;
+
+  // Set the output positions of the visited range
   void
-  SetTriangleStripsCellIds(CellsContainerType * cellIds)
+  SetCursors(CursorsType * cursors)
   {
-    m_TriangleStripsCellIds = cellIds;
+    m_Cursors = cursors;
   }
 
   // Visit a vertex and create a vertex in the output
@@ -114,9 +1148,9 @@ public:
   Visit(unsigned long cellId, VertexCellType * cell)
   {
     constexpr unsigned int numberOfPoints = VertexCellType::NumberOfPoints;
-    m_Vertices->push_back(numberOfPoints);
-    m_Vertices->push_back(cell->GetPointId());
-    m_VerticesCellIds->push_back(static_cast<unsigned int>(cellId));
+    *m_Cursors->Vertices++ = numberOfPoints;
+    *m_Cursors->Vertices++ = cell->GetPointId();
+    *m_Cursors->VerticesCellIds++ = static_cast<CellIdType>(cellId);
   }
 
   // Visit a line and create a line in the output
@@ -124,14 +1158,14 @@ public:
   Visit(unsigned long cellId, LineCellType * cell)
   {
     constexpr unsigned int numberOfPoints = LineCellType::NumberOfPoints;
-    m_Lines->push_back(numberOfPoints);
+    *m_Cursors->Lines++ = numberOfPoints;
     const typename LineCellType::PointIdConstIterator pointIdEnd = cell->PointIdsEnd();
     for (typename LineCellType::PointIdConstIterator pointIdIt = cell->PointIdsBegin(); pointIdIt != pointIdEnd;
          ++pointIdIt)
     {
-      m_Lines->push_back(*pointIdIt);
+      *m_Cursors->Lines++ = *pointIdIt;
     }
-    m_LinesCellIds->push_back(static_cast<unsigned int>(cellId));
+    *m_Cursors->LinesCellIds++ = static_cast<CellIdType>(cellId);
   }
 
   // Visit a polyline and create a polyline in the output
@@ -139,14 +1173,14 @@ public:
   Visit(unsigned long cellId, PolyLineCellType * cell)
   {
     int numberOfPoints = cell->GetNumberOfPoints();
-    m_Lines->push_back(numberOfPoints);
+    *m_Cursors->PolyLines++ = numberOfPoints;
     const typename PolyLineCellType::PointIdConstIterator pointIdEnd = cell->PointIdsEnd();
     for (typename PolyLineCellType::PointIdConstIterator pointIdIt = cell->PointIdsBegin(); pointIdIt != pointIdEnd;
          ++pointIdIt)
     {
-      m_Lines->push_back(*pointIdIt);
+      *m_Cursors->PolyLines++ = *pointIdIt;
     }
-    m_LinesCellIds->push_back(static_cast<unsigned int>(cellId));
+    *m_Cursors->PolyLinesCellIds++ = static_cast<CellIdType>(cellId);
   }
 
   // Visit a triangle and create a triangle in the output
@@ -154,14 +1188,14 @@ public:
   Visit(unsigned long cellId, TriangleCellType * cell)
   {
     constexpr unsigned int numberOfPoints = TriangleCellType::NumberOfPoints;
-    m_Polygons->push_back(numberOfPoints);
+    *m_Cursors->Polygons++ = numberOfPoints;
     const typename TriangleCellType::PointIdConstIterator pointIdEnd = cell->PointIdsEnd();
     for (typename TriangleCellType::PointIdConstIterator pointIdIt = cell->PointIdsBegin(); pointIdIt != pointIdEnd;
          ++pointIdIt)
     {
-      m_Polygons->push_back(*pointIdIt);
+      *m_Cursors->Polygons++ = *pointIdIt;
     }
-    m_PolygonsCellIds->push_back(static_cast<unsigned int>(cellId));
+    *m_Cursors->PolygonsCellIds++ = static_cast<CellIdType>(cellId);
   }
 
   // Visit a quadrilateral and create a quadrilateral in the output
@@ -169,15 +1203,15 @@ public:
   Visit(unsigned long cellId, QuadrilateralCellType * cell)
   {
     constexpr unsigned int numberOfPoints = QuadrilateralCellType::NumberOfPoints;
-    m_Polygons->push_back(numberOfPoints);
+    *m_Cursors->Polygons++ = numberOfPoints;
     const typename QuadrilateralCellType::PointIdConstIterator pointIdEnd = cell->PointIdsEnd();
     for (typename QuadrilateralCellType::PointIdConstIterator pointIdIt = cell->PointIdsBegin();
          pointIdIt != pointIdEnd;
          ++pointIdIt)
     {
-      m_Polygons->push_back(*pointIdIt);
+      *m_Cursors->Polygons++ = *pointIdIt;
     }
-    m_PolygonsCellIds->push_back(static_cast<unsigned int>(cellId));
+    *m_Cursors->PolygonsCellIds++ = static_cast<CellIdType>(cellId);
   }
 
   // Visit a polygon and create a polygon in the output
@@ -185,99 +1219,97 @@ public:
   Visit(unsigned long cellId, PolygonCellType * cell)
   {
     const unsigned int numberOfPoints = cell->GetNumberOfPoints();
-    m_Polygons->push_back(numberOfPoints);
+    *m_Cursors->Polygons++ = numberOfPoints;
     const typename PolygonCellType::PointIdConstIterator pointIdEnd = cell->PointIdsEnd();
     for (typename PolygonCellType::PointIdConstIterator pointIdIt = cell->PointIdsBegin(); pointIdIt != pointIdEnd;
          ++pointIdIt)
     {
-      m_Polygons->push_back(*pointIdIt);
-    }
-    m_PolygonsCellIds->push_back(static_cast<unsigned int>(cellId));
-  }
-
-  //// Visit a tetrahedron and create a tetrahedron in the output
-  // void Visit(unsigned long, TetrahedronCellType* cell)
-  //{
-  // constexpr unsigned int numberOfPoints = TetrahedronCellType::NumberOfPoints;
-  // constexpr unsigned int numberOfFaces = TetrahedronCellType::NumberOfFaces;
-  // constexpr unsigned int numberOfEdges = TetrahedronCellType::NumberOfFaces;
-  // for( unsigned int faceId = 0; faceId < numberOfFaces; ++faceId )
-  //{
-  // typename TetrahedronCellType::FaceAutoPointer facePointer;
-  // cell->GetFace( faceId, facePointer );
-  //// TODO
-  ////faceIds = vtkIdList::New();
-  ////case VTK_TETRA:
-  ////for (faceId = 0; faceId < 4; faceId++)
-  ////{
-  ////faceIds->Reset();
-  ////faceVerts = vtkTetra::GetFaceArray(faceId);
-  ////faceIds->InsertNextId(pts[faceVerts[0]]);
-  ////faceIds->InsertNextId(pts[faceVerts[1]]);
-  ////faceIds->InsertNextId(pts[faceVerts[2]]);
-  ////numFacePts = 3;
-  ////input->GetCellNeighbors(cellId, faceIds, cellIds);
-  ////if ( cellIds->GetNumberOfIds() <= 0 )
-  ////{
-  ////polys->InsertNextCell(numFacePts);
-  ////for ( int i=0; i < numFacePts; i++)
-  ////{
-  ////polys->InsertCellPoint(pts[faceVerts[i]]);
-  ////}
-  ////polyCellIds.push_back(cellId);
-  ////}
-  ////}
-  ////break;
-  //}
-  //}
-
-  //// Visit a hexahedron and create a hexahedron in the output
-  // void Visit(unsigned long, HexahedronCellType* cell)
-  //{
-  //// TODO
-  ////case VTK_HEXAHEDRON:
-  ////for (faceId = 0; faceId < 6; faceId++)
-  ////{
-  ////faceIds->Reset();
-  ////faceVerts = vtkHexahedron::GetFaceArray(faceId);
-  ////faceIds->InsertNextId(pts[faceVerts[0]]);
-  ////faceIds->InsertNextId(pts[faceVerts[1]]);
-  ////faceIds->InsertNextId(pts[faceVerts[2]]);
-  ////faceIds->InsertNextId(pts[faceVerts[3]]);
-  ////numFacePts = 4;
-  ////input->GetCellNeighbors(cellId, faceIds, cellIds);
-  ////if ( cellIds->GetNumberOfIds() <= 0 )
-  ////{
-  ////polys->InsertNextCell(numFacePts);
-  ////for ( int i=0; i < numFacePts; i++)
-  ////{
-  ////polys->InsertCellPoint(pts[faceVerts[i]]);
-  ////}
-  ////polyCellIds.push_back(cellId);
-  ////}
-  ////}
-  ////break;
-  //}
+      *m_Cursors->Polygons++ = *pointIdIt;
+    }
+    *m_Cursors->PolygonsCellIds++ = static_cast<CellIdType>(cellId);
+  }
+
+  // Visit a tetrahedron and create its boundary faces in the output
+  void
+  Visit(unsigned long cellId, TetrahedronCellType * cell)
+  {
+    this->WriteBoundaryFaces(cellId, cell->PointIdsBegin(), TetrahedronFaces);
+  }
+
+  // Visit a hexahedron and create its boundary faces in the output
+  void
+  Visit(unsigned long cellId, HexahedronCellType * cell)
+  {
+    this->WriteBoundaryFaces(cellId, cell->PointIdsBegin(), HexahedronFaces);
+  }
 
 private:
-  CellsContainerType * m_Vertices;
-  CellsContainerType * m_Lines;
-  CellsContainerType * m_Polygons;
-  CellsContainerType * m_TriangleStrips;
-
-  CellsContainerType * m_VerticesCellIds;
-  CellsContainerType * m_LinesCellIds;
-  CellsContainerType * m_PolygonsCellIds;
-  CellsContainerType * m_TriangleStripsCellIds;
+  // Create the faces of a volumetric cell that are flagged as boundary faces
+  template <typename TPointIdConstIterator, unsigned int VNumberOfFaces, unsigned int VNumberOfFacePoints>
+  void
+  WriteBoundaryFaces(unsigned long                      cellId,
+                     TPointIdConstIterator              pointIds,
+                     const unsigned int                 (&faces)[VNumberOfFaces][VNumberOfFacePoints])
+  {
+    for (unsigned int face = 0; face < VNumberOfFaces; ++face)
+    {
+      if (*m_Cursors->BoundaryFaces++)
+      {
+        *m_Cursors->Polygons++ = VNumberOfFacePoints;
+        for (unsigned int ii = 0; ii < VNumberOfFacePoints; ++ii)
+        {
+          *m_Cursors->Polygons++ = pointIds[faces[face][ii]];
+        }
+        *m_Cursors->PolygonsCellIds++ = static_cast<CellIdType>(cellId);
+      }
+    }
+  }
+
+  CursorsType * m_Cursors{ nullptr };
 };
 
+
+// Add a visitor for the cell topology TCell that writes at cursors
+template <typename TMesh, typename TCursors, typename TCell>
+void
+AddCellRangeVisitor(typename TMesh::CellType::MultiVisitor * multiVisitor, TCursors * cursors)
+{
+  using VisitorType = itk::CellInterfaceVisitorImplementation<typename TMesh::PixelType,
+                                                              typename TMesh::CellTraits,
+                                                              TCell,
+                                                              VisitCellsClass<TMesh, TCursors>>;
+  typename VisitorType::Pointer visitor = VisitorType::New();
+  visitor->SetCursors(cursors);
+  multiVisitor->AddVisitor(visitor.GetPointer());
+}
+
+
+// Create the multivisitor that writes the cells of one range at cursors
+template <typename TMesh, typename TCursors>
+typename TMesh::CellType::MultiVisitor::Pointer
+MakeCellRangeVisitor(TCursors * cursors)
+{
+  using VisitCellsType = VisitCellsClass<TMesh, TCursors>;
+
+  typename TMesh::CellType::MultiVisitor::Pointer multiVisitor = TMesh::CellType::MultiVisitor::New();
+  AddCellRangeVisitor<TMesh, TCursors, typename VisitCellsType::VertexCellType>(multiVisitor, cursors);
+  AddCellRangeVisitor<TMesh, TCursors, typename VisitCellsType::LineCellType>(multiVisitor, cursors);
+  AddCellRangeVisitor<TMesh, TCursors, typename VisitCellsType::PolyLineCellType>(multiVisitor, cursors);
+  AddCellRangeVisitor<TMesh, TCursors, typename VisitCellsType::TriangleCellType>(multiVisitor, cursors);
+  AddCellRangeVisitor<TMesh, TCursors, typename VisitCellsType::QuadrilateralCellType>(multiVisitor, cursors);
+  AddCellRangeVisitor<TMesh, TCursors, typename VisitCellsType::PolygonCellType>(multiVisitor, cursors);
+  AddCellRangeVisitor<TMesh, TCursors, typename VisitCellsType::TetrahedronCellType>(multiVisitor, cursors);
+  AddCellRangeVisitor<TMesh, TCursors, typename VisitCellsType::HexahedronCellType>(multiVisitor, cursors);
+  return multiVisitor;
+}
+
 } // end anonymous namespace
 
 namespace itk
 {
 
-template <typename TInputMesh>
-MeshToPolyDataFilter<TInputMesh>::MeshToPolyDataFilter()
+template <typename TInputMesh, typename TOutputPolyData>
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::MeshToPolyDataFilter()
 {
   // Modify superclass default values, can be overridden by subclasses
   this->SetNumberOfRequiredInputs(1);
@@ -288,76 +1320,122 @@ MeshToPolyDataFilter<TInputMesh>::MeshToPolyDataFilter()
 }
 
 
-template <typename TInputMesh>
+template <typename TInputMesh, typename TOutputPolyData>
 void
-MeshToPolyDataFilter<TInputMesh>::PrintSelf(std::ostream & os, Indent indent) const
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "GenerateTriangleStrips: " << m_GenerateTriangleStrips << std::endl;
+  os << indent << "UseAttributeBuffers: " << m_UseAttributeBuffers << std::endl;
+  os << indent << "OptimizeVertexCache: " << m_OptimizeVertexCache << std::endl;
+  os << indent << "RemoveUnusedPoints: " << m_RemoveUnusedPoints << std::endl;
+  os << indent << "ReuseContainers: " << m_ReuseContainers << std::endl;
+  os << indent << "NumberOfCellsPerChunk: " << m_NumberOfCellsPerChunk << std::endl;
+  os << indent << "ChunkCallback: " << (m_ChunkCallback ? "set" : "not set") << std::endl;
+  os << indent << "Cached Input Cells: " << m_CachedInputCells.GetPointer() << std::endl;
+  os << indent << "Cached Input Cells MTime: " << m_CachedInputCellsMTime << std::endl;
+  os << indent << "Cached Input Cell Data: " << m_CachedInputCellData.GetPointer() << std::endl;
+  os << indent << "Cached Input Cell Data MTime: " << m_CachedInputCellDataMTime << std::endl;
+  os << indent << "Number Of Pooled Containers: " << m_ContainerPool.size() << std::endl;
 }
 
 
-template <typename TInputMesh>
+template <typename TInputMesh, typename TOutputPolyData>
 void
-MeshToPolyDataFilter<TInputMesh>::SetInput(const TInputMesh * input)
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::SetInput(const TInputMesh * input)
 {
   // Process object is not const-correct so the const_cast is required here
   this->ProcessObject::SetNthInput(0, const_cast<TInputMesh *>(input));
 }
 
 
-template <typename TInputMesh>
-const typename MeshToPolyDataFilter<TInputMesh>::InputMeshType *
-MeshToPolyDataFilter<TInputMesh>::GetInput() const
+template <typename TInputMesh, typename TOutputPolyData>
+const typename MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::InputMeshType *
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GetInput() const
 {
   return itkDynamicCastInDebugMode<const TInputMesh *>(this->GetPrimaryInput());
 }
 
 
-template <typename TInputMesh>
-const typename MeshToPolyDataFilter<TInputMesh>::InputMeshType *
-MeshToPolyDataFilter<TInputMesh>::GetInput(unsigned int idx) const
+template <typename TInputMesh, typename TOutputPolyData>
+const typename MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::InputMeshType *
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GetInput(unsigned int idx) const
 {
   return dynamic_cast<const TInputMesh *>(this->ProcessObject::GetInput(idx));
 }
 
 
-template <typename TInputMesh>
+template <typename TInputMesh, typename TOutputPolyData>
+void
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::SetChunkCallback(ChunkCallbackType callback)
+{
+  m_ChunkCallback = std::move(callback);
+  this->Modified();
+}
+
+
+template <typename TInputMesh, typename TOutputPolyData>
+SizeValueType
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GetMaximumCellIndexValue(const InputMeshType * input)
+{
+  SizeValueType maximumValue = input->GetNumberOfPoints();
+  if constexpr (HasCellTraits<TInputMesh>::value)
+  {
+    const auto * cells = input->GetCells();
+    if (cells != nullptr)
+    {
+      for (auto cellItr = cells->Begin(); cellItr != cells->End(); ++cellItr)
+      {
+        const auto * cell = cellItr.Value();
+        if (!cell)
+        {
+          continue;
+        }
+        maximumValue = std::max<SizeValueType>(maximumValue, cell->GetNumberOfPoints());
+      }
+    }
+  }
+  return maximumValue;
+}
+
+
+template <typename TInputMesh, typename TOutputPolyData>
 ProcessObject::DataObjectPointer
-MeshToPolyDataFilter<TInputMesh>::MakeOutput(ProcessObject::DataObjectPointerArraySizeType)
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::MakeOutput(ProcessObject::DataObjectPointerArraySizeType)
 {
   return PolyDataType::New().GetPointer();
 }
 
 
-template <typename TInputMesh>
+template <typename TInputMesh, typename TOutputPolyData>
 ProcessObject::DataObjectPointer
-MeshToPolyDataFilter<TInputMesh>::MakeOutput(const ProcessObject::DataObjectIdentifierType &)
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::MakeOutput(const ProcessObject::DataObjectIdentifierType &)
 {
   return PolyDataType::New().GetPointer();
 }
 
 
-template <typename TInputMesh>
-typename MeshToPolyDataFilter<TInputMesh>::PolyDataType *
-MeshToPolyDataFilter<TInputMesh>::GetOutput()
+template <typename TInputMesh, typename TOutputPolyData>
+typename MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::PolyDataType *
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GetOutput()
 {
   // we assume that the first output is of the templated type
   return itkDynamicCastInDebugMode<PolyDataType *>(this->GetPrimaryOutput());
 }
 
 
-template <typename TInputMesh>
-const typename MeshToPolyDataFilter<TInputMesh>::PolyDataType *
-MeshToPolyDataFilter<TInputMesh>::GetOutput() const
+template <typename TInputMesh, typename TOutputPolyData>
+const typename MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::PolyDataType *
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GetOutput() const
 {
   // we assume that the first output is of the templated type
   return itkDynamicCastInDebugMode<const PolyDataType *>(this->GetPrimaryOutput());
 }
 
 
-template <typename TInputMesh>
-typename MeshToPolyDataFilter<TInputMesh>::PolyDataType *
-MeshToPolyDataFilter<TInputMesh>::GetOutput(unsigned int idx)
+template <typename TInputMesh, typename TOutputPolyData>
+typename MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::PolyDataType *
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GetOutput(unsigned int idx)
 {
   auto * out = dynamic_cast<PolyDataType *>(this->ProcessObject::GetOutput(idx));
 
@@ -369,43 +1447,123 @@ MeshToPolyDataFilter<TInputMesh>::GetOutput(unsigned int idx)
 }
 
 
-template <typename TInputMesh>
+template <typename TInputMesh, typename TOutputPolyData>
+auto
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GetInputCellIdentifiers() const -> const CellIdentifiersContainer *
+{
+  return m_CachedConnectivity.CellIds.GetPointer();
+}
+
+
+template <typename TInputMesh, typename TOutputPolyData>
+auto
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GetInputPointIdentifiers() const -> const CellsContainer *
+{
+  return m_CachedConnectivity.PointIds.GetPointer();
+}
+
+
+template <typename TInputMesh, typename TOutputPolyData>
 void
-MeshToPolyDataFilter<TInputMesh>::GenerateData()
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GenerateData()
 {
   const InputMeshType * inputMesh = this->GetInput();
   PolyDataType *        outputPolyData = this->GetOutput();
 
-  using MeshPointsContainerType = typename InputMeshType::PointsContainer;
-  using PolyDataPointsContainerType = typename PolyDataType::PointsContainer;
-  const MeshPointsContainerType *               inputPoints = inputMesh->GetPoints();
-  typename PolyDataPointsContainerType::Pointer outputPoints = PolyDataPointsContainerType::New();
-  outputPoints->resize(inputPoints->Size());
-  // 2D Mesh -> 3D PolyData, third dimension point locations defaults to 0.0.
-  typename PolyDataType::PointType nullPoint{ 0.0f };
-  outputPoints->assign(inputPoints->Size(), nullPoint);
+  this->PrepareContainerPool();
 
-  typename MeshPointsContainerType::ConstIterator inputPointItr = inputPoints->Begin();
-  typename MeshPointsContainerType::ConstIterator inputPointEnd = inputPoints->End();
+  if constexpr (HasCellTraits<TInputMesh>::value)
+  {
+    if (m_NumberOfCellsPerChunk > 0)
+    {
+      // In streaming mode the pieces are delivered to the chunk callback,
+      // and the output is left empty
+      if (!m_ChunkCallback)
+      {
+        itkExceptionMacro("NumberOfCellsPerChunk is " << m_NumberOfCellsPerChunk << " but no chunk callback is set");
+      }
+      outputPolyData->Initialize();
+      outputPolyData->SetVertices(nullptr);
+      outputPolyData->SetLines(nullptr);
+      outputPolyData->SetPolygons(nullptr);
+      outputPolyData->SetTriangleStrips(nullptr);
+      m_CachedConnectivity = ConnectivityType();
+      m_CachedInputCells = nullptr;
+      GenerateChunks<TInputMesh>();
+      return;
+    }
+    if (m_RemoveUnusedPoints)
+    {
+      // The used points are only known once the cells are converted
+      GenerateDataDispatch<TInputMesh>();
+
+      const typename CellsContainer::Element * pointIds = nullptr;
+      SizeValueType                            numberOfPoints = 0;
+      if (m_CachedConnectivity.PointIds)
+      {
+        pointIds = m_CachedConnectivity.PointIds->CastToSTLConstContainer().data();
+        numberOfPoints = m_CachedConnectivity.PointIds->Size();
+      }
+      const typename InputMeshType::PointsContainer * inputPoints = inputMesh->GetPoints();
+      if (numberOfPoints > 0 && (!inputPoints || pointIds[numberOfPoints - 1] >= inputPoints->Size()))
+      {
+        itkExceptionMacro("The input cells use points that are not in the input mesh");
+      }
+      using PointsContainerType = typename PolyDataType::PointsContainer;
+      typename PointsContainerType::Pointer outputPoints = AcquireContainer<PointsContainerType>(0);
+      if (inputPoints)
+      {
+        GatherPoints(inputPoints,
+                     pointIds,
+                     numberOfPoints,
+                     outputPoints.GetPointer(),
+                     this->GetMultiThreader(),
+                     this->GetNumberOfWorkUnits());
+      }
+      outputPolyData->SetPoints(outputPoints);
+      this->GatherPointData(pointIds, numberOfPoints, outputPolyData);
+      return;
+    }
+  }
 
-  typename PolyDataPointsContainerType::Iterator outputPointItr = outputPoints->Begin();
-  while (inputPointItr != inputPointEnd)
+  using MeshPointsContainerType = typename InputMeshType::PointsContainer;
+  using PolyDataPointsContainerType = typename PolyDataType::PointsContainer;
+  const MeshPointsContainerType * inputPoints = inputMesh->GetPoints();
+  if constexpr (std::is_same<MeshPointsContainerType, PolyDataPointsContainerType>::value)
   {
-    for (unsigned int ii = 0; ii < InputMeshType::PointDimension; ++ii)
+    // 3D float points already have the PolyData layout, share them
+    // Process object is not const-correct so the const_cast is required here
+    outputPolyData->SetPoints(const_cast<PolyDataPointsContainerType *>(inputPoints));
+  }
+  else
+  {
+    typename PolyDataPointsContainerType::Pointer outputPoints = AcquireContainer<PolyDataPointsContainerType>(0);
+    if (inputPoints)
     {
-      outputPointItr.Value()[ii] = inputPointItr.Value()[ii];
+      ConvertPoints(inputPoints, outputPoints.GetPointer(), this->GetMultiThreader(), this->GetNumberOfWorkUnits());
     }
-    ++inputPointItr;
-    ++outputPointItr;
+    outputPolyData->SetPoints(outputPoints);
   }
-  outputPolyData->SetPoints(outputPoints);
 
   using PointDataContainerType = typename PolyDataType::PointDataContainer;
   const PointDataContainerType * inputPointData = inputMesh->GetPointData();
-  if (inputPointData)
+  if (inputPointData && m_UseAttributeBuffers)
+  {
+    typename PointDataBufferType::Pointer outputPointData = AcquireContainer<PointDataBufferType>(0);
+    const unsigned int                    numberOfComponents =
+      PolyDataType::FlattenPixels(inputPointData,
+                                  inputPointData->Size(),
+                                  [](SizeValueType ii) { return ii; },
+                                  outputPointData->CastToSTLContainer(),
+                                  this->GetMultiThreader(),
+                                  this->GetNumberOfWorkUnits());
+    outputPolyData->SetPointData(nullptr);
+    outputPolyData->SetPointDataBuffer(outputPointData, numberOfComponents);
+  }
+  else if (inputPointData)
   {
-    typename PointDataContainerType::Pointer outputPointData = PointDataContainerType::New();
-    outputPointData->Reserve(inputPointData->Size());
+    typename PointDataContainerType::Pointer outputPointData =
+      AcquireContainer<PointDataContainerType>(inputPointData->Size());
 
     typename PointDataContainerType::ConstIterator inputPointDataItr = inputPointData->Begin();
     typename PointDataContainerType::ConstIterator inputPointDataEnd = inputPointData->End();
@@ -419,243 +1577,842 @@ MeshToPolyDataFilter<TInputMesh>::GenerateData()
       ++outputPointDataItr;
     }
     outputPolyData->SetPointData(outputPointData);
+    outputPolyData->SetPointDataBuffer(nullptr, 0);
   }
 
   GenerateDataDispatch<TInputMesh>();
 }
 
 
-template <typename TInputMesh>
+template <typename TInputMesh, typename TOutputPolyData>
+void
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GatherPointData(
+  const typename CellsContainer::Element * pointIds,
+  SizeValueType                            numberOfPoints,
+  PolyDataType *                           output)
+{
+  using PointDataContainerType = typename PolyDataType::PointDataContainer;
+  const PointDataContainerType * inputPointData = this->GetInput()->GetPointData();
+  if (!inputPointData || !inputPointData->Size())
+  {
+    return;
+  }
+
+  if (m_UseAttributeBuffers)
+  {
+    typename PointDataBufferType::Pointer outputPointData = AcquireContainer<PointDataBufferType>(0);
+    const unsigned int                    numberOfComponents =
+      PolyDataType::FlattenPixels(inputPointData,
+                                  numberOfPoints,
+                                  [pointIds](SizeValueType ii) { return pointIds[ii]; },
+                                  outputPointData->CastToSTLContainer(),
+                                  this->GetMultiThreader(),
+                                  this->GetNumberOfWorkUnits());
+    output->SetPointData(nullptr);
+    output->SetPointDataBuffer(outputPointData, numberOfComponents);
+  }
+  else
+  {
+    typename PointDataContainerType::Pointer outputPointData = AcquireContainer<PointDataContainerType>(0);
+    GatherPixels(inputPointData,
+                 pointIds,
+                 numberOfPoints,
+                 outputPointData.GetPointer(),
+                 this->GetMultiThreader(),
+                 this->GetNumberOfWorkUnits());
+    output->SetPointData(outputPointData);
+    output->SetPointDataBuffer(nullptr, 0);
+  }
+}
+
+
+template <typename TInputMesh, typename TOutputPolyData>
 template <typename TInputMeshDispatch, typename std::enable_if<!HasCellTraits<TInputMeshDispatch>::value, int>::type>
 void
-MeshToPolyDataFilter<TInputMesh>::GenerateDataDispatch()
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GenerateDataDispatch()
 {
   // Nothing else to do
 }
 
 
-template <typename TInputMesh>
+template <typename TInputMesh, typename TOutputPolyData>
 template <typename TInputMeshDispatch, typename std::enable_if<HasCellTraits<TInputMeshDispatch>::value, int>::type>
 void
-MeshToPolyDataFilter<TInputMesh>::GenerateDataDispatch()
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GenerateDataDispatch()
 {
   // Also propagate cells and cell data
 
   const InputMeshType * inputMesh = this->GetInput();
   PolyDataType *        outputPolyData = this->GetOutput();
 
-  const IdentifierType numberOfCells = inputMesh->GetNumberOfCells();
+  // The connectivity only depends on the input cells, so it is reused as
+  // long as the cells container and the filter are not modified, e.g. when
+  // only the points or the point data of the input change
+  const typename InputMeshType::CellsContainer * inputCells = inputMesh->GetCells();
+  // Triangles are only joined into strips when their cell data are equal,
+  // so the strips also depend on the input cell data
+  using ElementType = typename CellsContainer::Element;
+  using CellDataContainerType = typename PolyDataType::CellDataContainer;
+  const CellDataContainerType * inputCellData = inputMesh->GetCellData();
+  const bool                    stripsAreCurrent =
+    !m_GenerateTriangleStrips || (m_CachedStripsInputCellData.GetPointer() == inputCellData &&
+                                  m_CachedStripsInputCellDataMTime == (inputCellData ? inputCellData->GetMTime() : 0));
+  const bool connectivityIsCurrent = inputCells != nullptr && m_CachedInputCells.GetPointer() == inputCells &&
+                                     m_CachedInputCellsMTime == inputCells->GetMTime() &&
+                                     m_CachedFilterMTime == this->GetMTime() && stripsAreCurrent;
+  if (!connectivityIsCurrent)
+  {
+    // Detach the previous connectivity from the output, so that its
+    // containers return to the pool unless something else references them
+    outputPolyData->SetVertices(nullptr);
+    outputPolyData->SetLines(nullptr);
+    outputPolyData->SetPolygons(nullptr);
+    outputPolyData->SetTriangleStrips(nullptr);
+    m_CachedConnectivity = ConnectivityType();
+    m_CachedInputCells = nullptr;
+    if (inputCells)
+    {
+      GenerateConnectivity<TInputMeshDispatch>(
+        inputCells->Begin(), inputCells->End(), inputCells->Size(), nullptr, m_CachedConnectivity);
+    }
+    else
+    {
+      GenerateConnectivity<TInputMeshDispatch>({}, {}, 0, nullptr, m_CachedConnectivity);
+    }
+    if (m_OptimizeVertexCache)
+    {
+      ReorderPolygonsForVertexCache(m_CachedConnectivity);
+    }
+    if (m_GenerateTriangleStrips)
+    {
+      JoinTrianglesIntoStrips<TInputMeshDispatch>(m_CachedConnectivity);
+    }
+    if (m_RemoveUnusedPoints)
+    {
+      std::vector<std::vector<ElementType> *> cellArrays;
+      for (CellsContainer * cells : { m_CachedConnectivity.Vertices.GetPointer(),
+                                      m_CachedConnectivity.Lines.GetPointer(),
+                                      m_CachedConnectivity.Polygons.GetPointer(),
+                                      m_CachedConnectivity.TriangleStrips.GetPointer() })
+      {
+        if (cells)
+        {
+          cellArrays.push_back(&cells->CastToSTLContainer());
+        }
+      }
+      m_CachedConnectivity.PointIds = AcquireContainer<CellsContainer>(0);
+      if (!RemoveUnusedPointIds(cellArrays,
+                                inputMesh->GetNumberOfPoints(),
+                                m_CachedConnectivity.PointIds->CastToSTLContainer(),
+                                this->GetMultiThreader(),
+                                this->GetNumberOfWorkUnits()))
+      {
+        m_CachedInputCells = nullptr;
+        itkExceptionMacro("The input cells use points that are not in the input mesh");
+      }
+    }
+    m_CachedInputCells = inputCells;
+    m_CachedInputCellsMTime = inputCells ? inputCells->GetMTime() : 0;
+    m_CachedFilterMTime = this->GetMTime();
+    m_CachedStripsInputCellData = inputCellData;
+    m_CachedStripsInputCellDataMTime = inputCellData ? inputCellData->GetMTime() : 0;
+    m_CachedInputCellData = nullptr;
+  }
+
+  outputPolyData->SetVertices(m_CachedConnectivity.Vertices);
+  outputPolyData->SetLines(m_CachedConnectivity.Lines);
+  outputPolyData->SetPolygons(m_CachedConnectivity.Polygons);
+  outputPolyData->SetTriangleStrips(m_CachedConnectivity.TriangleStrips);
+
+  if (inputCellData && inputCellData->Size())
+  {
+    if (m_CachedInputCellData.GetPointer() != inputCellData || m_CachedInputCellDataMTime != inputCellData->GetMTime())
+    {
+      m_CachedCellData = nullptr;
+      m_CachedCellDataBuffer = nullptr;
+      m_CachedNumberOfCellDataComponents = 0;
+    }
+    // Gather the cell data in the output order: verts / lines / polys /
+    // strips
+    const CellIdentifierElementType * const permutation =
+      m_CachedConnectivity.CellIds->CastToSTLConstContainer().data();
+    const SizeValueType numberOfOutputCells = m_CachedConnectivity.CellIds->Size();
+    if (m_UseAttributeBuffers && !m_CachedCellDataBuffer)
+    {
+      typename CellDataBufferType::Pointer outputCellData = AcquireContainer<CellDataBufferType>(0);
+      m_CachedNumberOfCellDataComponents =
+        PolyDataType::FlattenPixels(inputCellData,
+                                    numberOfOutputCells,
+                                    [permutation](SizeValueType ii) { return permutation[ii]; },
+                                    outputCellData->CastToSTLContainer(),
+                                    this->GetMultiThreader(),
+                                    this->GetNumberOfWorkUnits());
+
+      m_CachedCellDataBuffer = outputCellData;
+      m_CachedInputCellData = inputCellData;
+      m_CachedInputCellDataMTime = inputCellData->GetMTime();
+    }
+    else if (!m_UseAttributeBuffers && !m_CachedCellData)
+    {
+      typename CellDataContainerType::Pointer outputCellData = AcquireContainer<CellDataContainerType>(0);
+      GatherPixels(inputCellData,
+                   permutation,
+                   numberOfOutputCells,
+                   outputCellData.GetPointer(),
+                   this->GetMultiThreader(),
+                   this->GetNumberOfWorkUnits());
+
+      m_CachedCellData = outputCellData;
+      m_CachedInputCellData = inputCellData;
+      m_CachedInputCellDataMTime = inputCellData->GetMTime();
+    }
+    outputPolyData->SetCellData(m_CachedCellData);
+    outputPolyData->SetCellDataBuffer(m_CachedCellDataBuffer, m_CachedNumberOfCellDataComponents);
+  }
+}
+
 
+template <typename TInputMesh, typename TOutputPolyData>
+template <typename TInputMeshDispatch>
+void
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GenerateConnectivity(
+  typename TInputMeshDispatch::CellsContainer::ConstIterator begin,
+  typename TInputMeshDispatch::CellsContainer::ConstIterator end,
+  SizeValueType                                              numberOfCells,
+  const uint8_t *                                            boundaryFaces,
+  ConnectivityType &                                         connectivity)
+{
   using CellsContainerType = typename PolyDataType::CellsContainer;
-  typename CellsContainerType::Pointer vertices = CellsContainerType::New();
-  vertices->reserve(numberOfCells / 4 + 1);
-  typename CellsContainerType::Pointer lines = CellsContainerType::New();
-  lines->reserve(numberOfCells / 4 + 1);
-  typename CellsContainerType::Pointer polylines = CellsContainerType::New();
-  polylines->reserve(numberOfCells / 4 + 1);
-  typename CellsContainerType::Pointer polygons = CellsContainerType::New();
-  polygons->reserve(numberOfCells / 4 + 1);
-  // typename CellsContainerType::Pointer triangleStrips = CellsContainerType::New();
-  // triangleStrips->reserve( numberOfCells / 4 + 1 );
-
-  // These store the cell ids of the input that map to the
-  // new vert/line/poly/strip cells, for copying cell data
-  // in appropriate order.
-  typename CellsContainerType::Pointer verticesCellIds = CellsContainerType::New();
-  verticesCellIds->Reserve(numberOfCells / 4 + 1);
-  typename CellsContainerType::Pointer linesCellIds = CellsContainerType::New();
-  linesCellIds->Reserve(numberOfCells / 4 + 1);
-  typename CellsContainerType::Pointer polygonsCellIds = CellsContainerType::New();
-  polygonsCellIds->Reserve(numberOfCells / 4 + 1);
-  // typename CellsContainerType::Pointer triangleStripsCellIds = CellsContainerType::New();
-  // triangleStripsCellIds->Reserve( numberOfCells / 4 + 1 );
-
-  using CellTraits = typename InputMeshType::CellTraits;
-  using PixelType = typename InputMeshType::PixelType;
-
-  // Setup the vertex visitor
-  typedef CellInterfaceVisitorImplementation<PixelType,
-                                             CellTraits,
-                                             VertexCell<CellInterface<PixelType, CellTraits>>,
-                                             VisitCellsClass<InputMeshType, PolyDataType>>
-                                  VertexVisitor;
-  typename VertexVisitor::Pointer vertexVisitor = VertexVisitor::New();
-  vertexVisitor->SetVertices(vertices);
-  vertexVisitor->SetLines(lines);
-  vertexVisitor->SetPolygons(polygons);
-  // vertexVisitor->SetTriangleStrips( triangleStrips );
-  vertexVisitor->SetVerticesCellIds(verticesCellIds);
-  vertexVisitor->SetLinesCellIds(linesCellIds);
-  vertexVisitor->SetPolygonsCellIds(polygonsCellIds);
-  // vertexVisitor->SetTriangleStripsCellIds( triangleStripsCellIds );
-
-  // Setup the poly line visitor
-  typedef CellInterfaceVisitorImplementation<PixelType,
-                                             CellTraits,
-                                             PolyLineCell<CellInterface<PixelType, CellTraits>>,
-                                             VisitCellsClass<InputMeshType, PolyDataType>>
-                                    PolyLineVisitor;
-  typename PolyLineVisitor::Pointer polyLineVisitor = PolyLineVisitor::New();
-  polyLineVisitor->SetVertices(vertices);
-  polyLineVisitor->SetLines(polylines);
-  polyLineVisitor->SetPolygons(polygons);
-  // lineVisitor->SetTriangleStrips( triangleStrips );
-  polyLineVisitor->SetVerticesCellIds(verticesCellIds);
-  polyLineVisitor->SetLinesCellIds(linesCellIds);
-  polyLineVisitor->SetPolygonsCellIds(polygonsCellIds);
-  // lineVisitor->SetTriangleStripsCellIds( triangleStripsCellIds );
-
-  // Setup the line visitor
-  typedef CellInterfaceVisitorImplementation<PixelType,
-                                             CellTraits,
-                                             LineCell<CellInterface<PixelType, CellTraits>>,
-                                             VisitCellsClass<InputMeshType, PolyDataType>>
-                                LineVisitor;
-  typename LineVisitor::Pointer lineVisitor = LineVisitor::New();
-  lineVisitor->SetVertices(vertices);
-  lineVisitor->SetLines(lines);
-  lineVisitor->SetPolygons(polygons);
-  // lineVisitor->SetTriangleStrips( triangleStrips );
-  lineVisitor->SetVerticesCellIds(verticesCellIds);
-  lineVisitor->SetLinesCellIds(linesCellIds);
-  lineVisitor->SetPolygonsCellIds(polygonsCellIds);
-  // lineVisitor->SetTriangleStripsCellIds( triangleStripsCellIds );
-
-  // Setup the triangle visitor
-  typedef CellInterfaceVisitorImplementation<PixelType,
-                                             CellTraits,
-                                             TriangleCell<CellInterface<PixelType, CellTraits>>,
-                                             VisitCellsClass<InputMeshType, PolyDataType>>
-                                    TriangleVisitor;
-  typename TriangleVisitor::Pointer triangleVisitor = TriangleVisitor::New();
-  triangleVisitor->SetVertices(vertices);
-  triangleVisitor->SetLines(lines);
-  triangleVisitor->SetPolygons(polygons);
-  // triangleVisitor->SetTriangleStrips( triangleStrips );
-  triangleVisitor->SetVerticesCellIds(verticesCellIds);
-  triangleVisitor->SetLinesCellIds(linesCellIds);
-  triangleVisitor->SetPolygonsCellIds(polygonsCellIds);
-  // triangleVisitor->SetTriangleStripsCellIds( triangleStripsCellIds );
-
-  // Setup the quadrilateral visitor
-  typedef CellInterfaceVisitorImplementation<PixelType,
-                                             CellTraits,
-                                             QuadrilateralCell<CellInterface<PixelType, CellTraits>>,
-                                             VisitCellsClass<InputMeshType, PolyDataType>>
-                                         QuadrilateralVisitor;
-  typename QuadrilateralVisitor::Pointer quadrilateralVisitor = QuadrilateralVisitor::New();
-  quadrilateralVisitor->SetVertices(vertices);
-  quadrilateralVisitor->SetLines(lines);
-  quadrilateralVisitor->SetPolygons(polygons);
-  // quadrilateralVisitor->SetTriangleStrips( triangleStrips );
-  quadrilateralVisitor->SetVerticesCellIds(verticesCellIds);
-  quadrilateralVisitor->SetLinesCellIds(linesCellIds);
-  quadrilateralVisitor->SetPolygonsCellIds(polygonsCellIds);
-  // quadrilateralVisitor->SetTriangleStripsCellIds( triangleStripsCellIds );
-
-  // Setup the polygon visitor
-  typedef CellInterfaceVisitorImplementation<PixelType,
-                                             CellTraits,
-                                             PolygonCell<CellInterface<PixelType, CellTraits>>,
-                                             VisitCellsClass<InputMeshType, PolyDataType>>
-                                   PolygonVisitor;
-  typename PolygonVisitor::Pointer polygonVisitor = PolygonVisitor::New();
-  polygonVisitor->SetVertices(vertices);
-  polygonVisitor->SetLines(lines);
-  polygonVisitor->SetPolygons(polygons);
-  // polygonVisitor->SetTriangleStrips( triangleStrips );
-  polygonVisitor->SetVerticesCellIds(verticesCellIds);
-  polygonVisitor->SetLinesCellIds(linesCellIds);
-  polygonVisitor->SetPolygonsCellIds(polygonsCellIds);
-  // polygonVisitor->SetTriangleStripsCellIds( triangleStripsCellIds );
-
-  // TODO
-  // Setup the tetrahedron visitor
-  // typedef CellInterfaceVisitorImplementation<
-  // PixelType, CellTraits,
-  // TetrahedronCell< CellInterface< PixelType, CellTraits > >,
-  // VisitCellsClass< InputMeshType, PolyDataType > > TetrahedronVisitor;
-  // typename TetrahedronVisitor::Pointer tetrahedronVisitor = TetrahedronVisitor::New();
-  // tetrahedronVisitor->SetVertices( vertices );
-  // tetrahedronVisitor->SetLines( lines );
-  // tetrahedronVisitor->SetPolygons( polygons );
-  // tetrahedronVisitor->SetTriangleStrips( triangleStrips );
-  // tetrahedronVisitor->SetVerticesCellIds( verticesCellIds );
-  // tetrahedronVisitor->SetLinesCellIds( linesCellIds );
-  // tetrahedronVisitor->SettetrahedronsCellIds( tetrahedronsCellIds );
-  // tetrahedronVisitor->SetTriangleStripsCellIds( triangleStripsCellIds );
-
-
-  typename InputMeshType::CellType::MultiVisitor::Pointer multiVisitor = InputMeshType::CellType::MultiVisitor::New();
-  multiVisitor->AddVisitor(vertexVisitor.GetPointer());
-  multiVisitor->AddVisitor(lineVisitor.GetPointer());
-  multiVisitor->AddVisitor(polyLineVisitor.GetPointer());
-  multiVisitor->AddVisitor(triangleVisitor.GetPointer());
-  multiVisitor->AddVisitor(quadrilateralVisitor.GetPointer());
-  multiVisitor->AddVisitor(polygonVisitor.GetPointer());
-  // multiVisitor->AddVisitor(tetrahedronVisitor.GetPointer());
-
-  // Now ask the mesh to accept the multivisitor which
-  // will Call Visit for each cell in the mesh that matches the
-  // cell types of the visitors added to the MultiVisitor
-  if (numberOfCells)
-  {
-    inputMesh->Accept(multiVisitor);
-  }
-
-  vertices->shrink_to_fit();
-  outputPolyData->SetVertices(vertices);
-
-  // Append lines to polylines before calling SetLines
-  lines->shrink_to_fit();
-  polylines->shrink_to_fit();
-
-  auto iterator_start_lines = lines->begin();
-  auto iterator_end_lines = lines->end();
-  auto iterator_end_polylines = polylines->end();
-  polylines->insert(iterator_end_polylines, iterator_start_lines, iterator_end_lines);
-
-  outputPolyData->SetLines(polylines);
-  polygons->shrink_to_fit();
-  outputPolyData->SetPolygons(polygons);
-  // triangleStrips->shrink_to_fit();
-  // outputPolyData->SetTriangleStrips( triangleStrips );
+  using ElementType = typename CellsContainerType::Element;
+  using CursorsType = CellRangeCursors<ElementType, CellIdentifierElementType>;
+  using InputCellsContainerType = typename InputMeshType::CellsContainer;
+  using InputCellsConstIterator = typename InputCellsContainerType::ConstIterator;
+  using MultiVisitorType = typename InputMeshType::CellType::MultiVisitor;
+
+  // Split the input cells into contiguous ranges, one per work unit. Each
+  // range writes its cells at its own offsets in the output, so the result
+  // does not depend on the number of ranges.
+  const SizeValueType numberOfRanges =
+    std::max<SizeValueType>(1, std::min<SizeValueType>(this->GetNumberOfWorkUnits(), numberOfCells));
+  const SizeValueType cellsPerRange = std::max<SizeValueType>(1, (numberOfCells + numberOfRanges - 1) / numberOfRanges);
+
+  std::vector<InputCellsConstIterator> rangeBegin;
+  rangeBegin.reserve(numberOfRanges + 1);
+  SizeValueType cellCount = 0;
+  for (InputCellsConstIterator cellItr = begin; cellItr != end; ++cellItr, ++cellCount)
+  {
+    if (cellCount % cellsPerRange == 0)
+    {
+      rangeBegin.push_back(cellItr);
+    }
+  }
+  rangeBegin.push_back(end);
+  const SizeValueType rangeCount = rangeBegin.size() - 1;
+
+  // First pass: count the output of each range
+  std::vector<CellRangeCounts> rangeCounts(rangeCount);
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    rangeCount,
+    [&rangeBegin, &rangeCounts](SizeValueType range) {
+      CountCellRange<InputMeshType>(rangeBegin[range], rangeBegin[range + 1], rangeCounts[range]);
+    },
+    nullptr);
+
+  // The faces of the tetrahedra and hexahedra that are not shared with
+  // another cell form the boundary surface, which is added to the polygons
+  std::vector<SizeValueType> rangeFirstFace(rangeCount + 1, 0);
+  for (SizeValueType range = 0; range < rangeCount; ++range)
+  {
+    rangeFirstFace[range + 1] = rangeFirstFace[range] + rangeCounts[range].VolumeFaces;
+  }
+  std::vector<uint8_t> localBoundaryFaces;
+  if (rangeCount > 0 && rangeFirstFace.back() > 0)
+  {
+    if (!boundaryFaces)
+    {
+      FindBoundaryFaces<typename CellsContainerType::Element, InputMeshType>(
+        rangeBegin, rangeFirstFace, localBoundaryFaces, this->GetMultiThreader());
+      boundaryFaces = localBoundaryFaces.data();
+    }
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      rangeCount,
+      [&rangeFirstFace, boundaryFaces, &rangeCounts](SizeValueType range) {
+        for (SizeValueType face = rangeFirstFace[range]; face < rangeFirstFace[range + 1]; ++face)
+        {
+          if (boundaryFaces[face])
+          {
+            rangeCounts[range].Polygons.AddCell(boundaryFaces[face]);
+          }
+        }
+      },
+      nullptr);
+  }
+
+  // The exclusive prefix sum of the counts is where each range writes
+  std::vector<CellRangeCounts> rangeOffsets(rangeCount);
+  CellRangeCounts              totalCounts;
+  for (SizeValueType range = 0; range < rangeCount; ++range)
+  {
+    rangeOffsets[range] = totalCounts;
+    totalCounts += rangeCounts[range];
+  }
+
+  // The point ids and cell sizes must fit in the cell arrays, and the input
+  // cell ids in the permutation
+  const SizeValueType numberOfInputPoints = this->GetInput()->GetNumberOfPoints();
+  if (!PolyDataType::CanIndex(std::max(numberOfInputPoints, totalCounts.MaximumNumberOfCellPoints)))
+  {
+    itkExceptionMacro("The " << numberOfInputPoints << " input points, or cells of up to "
+                             << totalCounts.MaximumNumberOfCellPoints << " points, cannot be indexed by the "
+                             << sizeof(ElementType) * 8 << "-bit cell arrays of the output PolyData");
+  }
+  if (totalCounts.MaximumCellIdentifier > std::numeric_limits<CellIdentifierElementType>::max())
+  {
+    itkExceptionMacro("Input cell identifier " << totalCounts.MaximumCellIdentifier << " exceeds the range of "
+                                               << sizeof(CellIdentifierElementType) * 8 << "-bit cell ids");
+  }
+
+  // Allocate every output array to its exact size. Polylines come first in
+  // the lines, followed by the two point lines.
+  typename CellsContainerType::Pointer vertices = AcquireContainer<CellsContainerType>(totalCounts.Vertices.Size);
+  typename CellsContainerType::Pointer lines =
+    AcquireContainer<CellsContainerType>(totalCounts.PolyLines.Size + totalCounts.Lines.Size);
+  typename CellsContainerType::Pointer polygons = AcquireContainer<CellsContainerType>(totalCounts.Polygons.Size);
+
+  // Input cell id of every output cell, in the output cell order: vertices,
+  // polylines, lines then polygons. This permutation drives the cell data
+  // gather.
+  const SizeValueType numberOfOutputCells = totalCounts.Vertices.NumberOfCells + totalCounts.PolyLines.NumberOfCells +
+                                            totalCounts.Lines.NumberOfCells + totalCounts.Polygons.NumberOfCells;
+  typename CellIdentifiersContainer::Pointer cellIds = AcquireContainer<CellIdentifiersContainer>(numberOfOutputCells);
+  CellIdentifierElementType * const verticesCellIds = cellIds->CastToSTLContainer().data();
+  CellIdentifierElementType * const polyLinesCellIds = verticesCellIds + totalCounts.Vertices.NumberOfCells;
+  CellIdentifierElementType * const linesCellIds = polyLinesCellIds + totalCounts.PolyLines.NumberOfCells;
+  CellIdentifierElementType * const polygonsCellIds = linesCellIds + totalCounts.Lines.NumberOfCells;
+
+  std::vector<CursorsType> rangeCursors(rangeCount);
+  for (SizeValueType range = 0; range < rangeCount; ++range)
+  {
+    const CellRangeCounts & offsets = rangeOffsets[range];
+    CursorsType &           cursors = rangeCursors[range];
+    cursors.Vertices = vertices->CastToSTLContainer().data() + offsets.Vertices.Size;
+    cursors.PolyLines = lines->CastToSTLContainer().data() + offsets.PolyLines.Size;
+    cursors.Lines = lines->CastToSTLContainer().data() + totalCounts.PolyLines.Size + offsets.Lines.Size;
+    cursors.Polygons = polygons->CastToSTLContainer().data() + offsets.Polygons.Size;
+    cursors.VerticesCellIds = verticesCellIds + offsets.Vertices.NumberOfCells;
+    cursors.PolyLinesCellIds = polyLinesCellIds + offsets.PolyLines.NumberOfCells;
+    cursors.LinesCellIds = linesCellIds + offsets.Lines.NumberOfCells;
+    cursors.PolygonsCellIds = polygonsCellIds + offsets.Polygons.NumberOfCells;
+    cursors.BoundaryFaces = boundaryFaces ? boundaryFaces + rangeFirstFace[range] : nullptr;
+  }
+
+  // Second pass: write the cells of each range at its offsets
+  using CellInterfaceType = typename InputMeshType::CellType;
+  if (totalCounts.IsHomogeneous(CellGeometryEnum::TRIANGLE_CELL))
+  {
+    // Triangle-only meshes are written in a tight loop, without the visitors
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      rangeCount,
+      [&rangeBegin, &rangeCursors](SizeValueType range) {
+        WriteHomogeneousCellRange<TriangleCell<CellInterfaceType>>(
+          rangeBegin[range], rangeBegin[range + 1], rangeCursors[range]);
+      },
+      nullptr);
+  }
+  else if (totalCounts.IsHomogeneous(CellGeometryEnum::QUADRILATERAL_CELL))
+  {
+    // As are quadrilateral-only meshes
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      rangeCount,
+      [&rangeBegin, &rangeCursors](SizeValueType range) {
+        WriteHomogeneousCellRange<QuadrilateralCell<CellInterfaceType>>(
+          rangeBegin[range], rangeBegin[range + 1], rangeCursors[range]);
+      },
+      nullptr);
+  }
+  else
+  {
+    // Visitors are created up front, one set per range, writing at the
+    // range's offsets
+    std::vector<typename MultiVisitorType::Pointer> rangeVisitors;
+    rangeVisitors.reserve(rangeCount);
+    for (auto & cursors : rangeCursors)
+    {
+      rangeVisitors.push_back(MakeCellRangeVisitor<InputMeshType>(&cursors));
+    }
+
+    // Ask each cell to accept its range's multivisitor, which will call
+    // Visit for each cell that matches the cell types of the visitors
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      rangeCount,
+      [&rangeBegin, &rangeVisitors](SizeValueType range) {
+        MultiVisitorType * multiVisitor = rangeVisitors[range];
+        for (InputCellsConstIterator cellItr = rangeBegin[range]; cellItr != rangeBegin[range + 1]; ++cellItr)
+        {
+          if (cellItr.Value())
+          {
+            cellItr.Value()->Accept(cellItr.Index(), multiVisitor);
+          }
+        }
+      },
+      nullptr);
+  }
+
+  connectivity.Vertices = vertices;
+  connectivity.Lines = lines;
+  connectivity.Polygons = polygons;
+  connectivity.TriangleStrips = nullptr;
+  connectivity.CellIds = cellIds;
+}
+
 
+template <typename TInputMesh, typename TOutputPolyData>
+template <typename TInputMeshDispatch>
+void
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::JoinTrianglesIntoStrips(ConnectivityType & connectivity)
+{
+  using ElementType = typename CellsContainer::Element;
   using CellDataContainerType = typename PolyDataType::CellDataContainer;
-  const CellDataContainerType * inputCellData = inputMesh->GetCellData();
-  if (inputCellData && inputCellData->Size())
+
+  // Separate the triangles from the other polygons, which are kept as is
+  const std::vector<ElementType> & polygons = connectivity.Polygons->CastToSTLConstContainer();
+  SizeValueType                    numberOfPolygons = 0;
+  SizeValueType                    numberOfTriangles = 0;
+  SizeValueType                    otherPolygonsSize = 0;
+  for (SizeValueType position = 0; position < polygons.size(); position += polygons[position] + 1, ++numberOfPolygons)
   {
-    typename CellDataContainerType::Pointer outputCellData = CellDataContainerType::New();
-    outputCellData->Reserve(inputCellData->Size());
-    SizeValueType offset = 0;
-    SizeValueType size = verticesCellIds->Size();
+    if (polygons[position] == 3)
+    {
+      ++numberOfTriangles;
+    }
+    else
+    {
+      otherPolygonsSize += polygons[position] + 1;
+    }
+  }
 
-    // Copy the cell data in appropriate order : verts / lines / polys / strips
-    for (SizeValueType ii = 0; ii < verticesCellIds->Size(); ++ii)
+  // The polygons are the last cells of the permutation, which is rebuilt
+  // with the other polygons followed by the strips
+  const std::vector<CellIdentifierElementType> & cellIds = connectivity.CellIds->CastToSTLConstContainer();
+  const SizeValueType                            firstPolygonCell = cellIds.size() - numberOfPolygons;
+  typename CellIdentifiersContainer::Pointer     outputCellIds = AcquireContainer<CellIdentifiersContainer>(0);
+  std::vector<CellIdentifierElementType> &       outputCellIdsVector = outputCellIds->CastToSTLContainer();
+  outputCellIdsVector.reserve(cellIds.size() - numberOfTriangles);
+  outputCellIdsVector.assign(cellIds.begin(), cellIds.begin() + firstPolygonCell);
+
+  std::vector<std::array<ElementType, 3>> triangles;
+  triangles.reserve(numberOfTriangles);
+  std::vector<CellIdentifierElementType> triangleCellIds;
+  triangleCellIds.reserve(numberOfTriangles);
+  typename CellsContainer::Pointer otherPolygons = AcquireContainer<CellsContainer>(0);
+  otherPolygons->CastToSTLContainer().reserve(otherPolygonsSize);
+  SizeValueType polygonCell = firstPolygonCell;
+  for (SizeValueType position = 0; position < polygons.size(); position += polygons[position] + 1, ++polygonCell)
+  {
+    if (polygons[position] == 3)
     {
-      outputCellData->InsertElement(ii, inputCellData->ElementAt(verticesCellIds->ElementAt(ii)));
+      triangles.push_back({ polygons[position + 1], polygons[position + 2], polygons[position + 3] });
+      triangleCellIds.push_back(cellIds[polygonCell]);
     }
-    offset += size;
-    size = linesCellIds->Size();
-    for (SizeValueType ii = 0; ii < size; ++ii)
+    else
     {
-      outputCellData->InsertElement(offset + ii, inputCellData->ElementAt(linesCellIds->ElementAt(ii)));
+      otherPolygons->CastToSTLContainer().insert(otherPolygons->CastToSTLContainer().end(),
+                                                 polygons.begin() + position,
+                                                 polygons.begin() + position + polygons[position] + 1);
+      outputCellIdsVector.push_back(cellIds[polygonCell]);
     }
-    offset += size;
-    size = polygonsCellIds->Size();
-    for (SizeValueType ii = 0; ii < size; ++ii)
+  }
+
+  typename CellsContainer::Pointer strips = AcquireContainer<CellsContainer>(0);
+  if (numberOfTriangles > 0)
+  {
+    const SizeValueType rangeCount =
+      std::max<SizeValueType>(1, std::min<SizeValueType>(this->GetNumberOfWorkUnits(), numberOfTriangles));
+    const SizeValueType trianglesPerRange = (numberOfTriangles + rangeCount - 1) / rangeCount;
+
+    // Triangles with different cell data are not joined, since a strip only
+    // has one cell data value
+    const CellDataContainerType * inputCellData = this->GetInput()->GetCellData();
+    const bool                    hasCellData = inputCellData && inputCellData->Size();
+    std::vector<SizeValueType>    neighbors;
+    FindTriangleNeighbors(
+      triangles,
+      rangeCount,
+      [&triangleCellIds, inputCellData, hasCellData](SizeValueType triangle, SizeValueType otherTriangle) {
+        return !hasCellData || inputCellData->ElementAt(triangleCellIds[triangle]) ==
+                                 inputCellData->ElementAt(triangleCellIds[otherTriangle]);
+      },
+      neighbors,
+      this->GetMultiThreader());
+
+    // Strips are built in parallel within each range of triangles, so the
+    // result only depends on the number of ranges through the range limits
+    std::vector<std::vector<ElementType>>   rangeStrips(rangeCount);
+    std::vector<std::vector<SizeValueType>> rangeStripTriangles(rangeCount);
+    std::vector<uint8_t>                    visited(numberOfTriangles, 0);
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      rangeCount,
+      [&](SizeValueType range) {
+        StripTriangleRange(triangles,
+                           neighbors,
+                           range * trianglesPerRange,
+                           std::min(numberOfTriangles, (range + 1) * trianglesPerRange),
+                           visited,
+                           rangeStrips[range],
+                           rangeStripTriangles[range]);
+      },
+      nullptr);
+
+    std::vector<SizeValueType> rangeStripsOffset(rangeCount + 1, 0);
+    std::vector<SizeValueType> rangeStripsCellIdsOffset(rangeCount + 1, outputCellIdsVector.size());
+    for (SizeValueType range = 0; range < rangeCount; ++range)
     {
-      outputCellData->InsertElement(offset + ii, inputCellData->ElementAt(polygonsCellIds->ElementAt(ii)));
+      rangeStripsOffset[range + 1] = rangeStripsOffset[range] + rangeStrips[range].size();
+      rangeStripsCellIdsOffset[range + 1] = rangeStripsCellIdsOffset[range] + rangeStripTriangles[range].size();
     }
-    offset += size;
-    // size = triangleStripsCellIds->Size();
-    // for( SizeValueType ii = 0; ii < size; ++ii )
-    //{
-    // outputCellData->InsertElement( offset + ii,
-    // inputCellData->ElementAt( triangleStripsCellIds->ElementAt( ii ) ) );
-    //}
+    strips->resize(rangeStripsOffset.back());
+    outputCellIdsVector.resize(rangeStripsCellIdsOffset.back());
+    ElementType *               stripsData = strips->CastToSTLContainer().data();
+    CellIdentifierElementType * stripsCellIdsData = outputCellIdsVector.data();
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      rangeCount,
+      [&](SizeValueType range) {
+        std::copy(rangeStrips[range].begin(), rangeStrips[range].end(), stripsData + rangeStripsOffset[range]);
+        CellIdentifierElementType * stripCellIds = stripsCellIdsData + rangeStripsCellIdsOffset[range];
+        for (const SizeValueType triangle : rangeStripTriangles[range])
+        {
+          *stripCellIds++ = triangleCellIds[triangle];
+        }
+      },
+      nullptr);
+  }
+
+  connectivity.Polygons = otherPolygons;
+  connectivity.TriangleStrips = strips;
+  connectivity.CellIds = outputCellIds;
+}
+
+
+template <typename TInputMesh, typename TOutputPolyData>
+void
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::ReorderPolygonsForVertexCache(ConnectivityType & connectivity)
+{
+  using ElementType = typename CellsContainer::Element;
+
+  const std::vector<ElementType> & polygons = connectivity.Polygons->CastToSTLConstContainer();
+  const std::vector<CellIdentifierElementType> & cellIds = connectivity.CellIds->CastToSTLConstContainer();
+  if (polygons.empty())
+  {
+    return;
+  }
+
+  // The polygons are split in blocks that are reordered independently, in
+  // parallel. Each block keeps its range of the polygons array.
+  const std::vector<SizeValueType> blockStarts = SplitCellArray(polygons, this->GetNumberOfWorkUnits());
+  const SizeValueType              numberOfBlocks = blockStarts.size() - 1;
+  std::vector<SizeValueType>       blockFirstFace(numberOfBlocks + 1, 0);
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&polygons, &blockStarts, &blockFirstFace](SizeValueType block) {
+      SizeValueType numberOfFaces = 0;
+      for (SizeValueType position = blockStarts[block]; position < blockStarts[block + 1];
+           position += polygons[position] + 1)
+      {
+        ++numberOfFaces;
+      }
+      blockFirstFace[block + 1] = numberOfFaces;
+    },
+    nullptr);
+  for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+  {
+    blockFirstFace[block + 1] += blockFirstFace[block];
+  }
+
+  // The polygons are the last cells of the permutation
+  const SizeValueType                        firstPolygonCell = cellIds.size() - blockFirstFace.back();
+  typename CellsContainer::Pointer           outputPolygons = AcquireContainer<CellsContainer>(polygons.size());
+  typename CellIdentifiersContainer::Pointer outputCellIds = AcquireContainer<CellIdentifiersContainer>(cellIds.size());
+  std::copy(cellIds.begin(), cellIds.begin() + firstPolygonCell, outputCellIds->CastToSTLContainer().begin());
+  ElementType *               outputPolygonsData = outputPolygons->CastToSTLContainer().data();
+  CellIdentifierElementType * outputPolygonCellIds = outputCellIds->CastToSTLContainer().data() + firstPolygonCell;
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      OptimizeVertexCacheBlock(polygons.data(),
+                               blockStarts[block],
+                               blockStarts[block + 1],
+                               cellIds.data() + firstPolygonCell + blockFirstFace[block],
+                               outputPolygonsData,
+                               outputPolygonCellIds + blockFirstFace[block]);
+    },
+    nullptr);
+
+  connectivity.Polygons = outputPolygons;
+  connectivity.CellIds = outputCellIds;
+}
+
+
+template <typename TInputMesh, typename TOutputPolyData>
+template <typename TContainer>
+auto
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::AcquireContainer(SizeValueType size) -> typename TContainer::Pointer
+{
+  typename TContainer::Pointer container;
+  if (m_ReuseContainers)
+  {
+    Object *      reused = nullptr;
+    SizeValueType reusedCapacity = 0;
+    for (const Object::Pointer & pooled : m_ContainerPool)
+    {
+      const auto * candidate = dynamic_cast<const TContainer *>(pooled.GetPointer());
+      if (!candidate || pooled->GetReferenceCount() > 1)
+      {
+        continue;
+      }
+      const SizeValueType capacity = candidate->CastToSTLConstContainer().capacity();
+      const bool          reusedFits = reused && reusedCapacity >= size;
+      if (!reused || (capacity >= size && (!reusedFits || capacity < reusedCapacity)) ||
+          (capacity < size && !reusedFits && capacity > reusedCapacity))
+      {
+        reused = pooled.GetPointer();
+        reusedCapacity = capacity;
+      }
+    }
+    if (reused)
+    {
+      container = static_cast<TContainer *>(reused);
+    }
+    else
+    {
+      container = TContainer::New();
+      m_ContainerPool.push_back(container.GetPointer());
+    }
+    container->Modified();
+  }
+  else
+  {
+    container = TContainer::New();
+  }
+  container->CastToSTLContainer().resize(size);
+  return container;
+}
+
+
+template <typename TInputMesh, typename TOutputPolyData>
+void
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::PrepareContainerPool()
+{
+  if (!m_ReuseContainers)
+  {
+    m_ContainerPool.clear();
+    return;
+  }
+  const ModifiedTimeType lastUpdateTime = m_ContainerPoolTime.GetMTime();
+  m_ContainerPool.erase(std::remove_if(m_ContainerPool.begin(),
+                                       m_ContainerPool.end(),
+                                       [lastUpdateTime](const Object::Pointer & pooled) {
+                                         return pooled->GetMTime() <= lastUpdateTime &&
+                                                pooled->GetReferenceCount() == 1;
+                                       }),
+                        m_ContainerPool.end());
+  m_ContainerPoolTime.Modified();
+}
+
+
+template <typename TInputMesh, typename TOutputPolyData>
+template <typename TInputMeshDispatch>
+void
+MeshToPolyDataFilter<TInputMesh, TOutputPolyData>::GenerateChunks()
+{
+  using ElementType = typename CellsContainer::Element;
+  using InputCellsContainerType = typename InputMeshType::CellsContainer;
+  using InputCellsConstIterator = typename InputCellsContainerType::ConstIterator;
+  using PointsContainerType = typename PolyDataType::PointsContainer;
+  using CellDataContainerType = typename PolyDataType::CellDataContainer;
+  const InputMeshType *                           inputMesh = this->GetInput();
+  const InputCellsContainerType *                 inputCells = inputMesh->GetCells();
+  const typename InputMeshType::PointsContainer * inputPoints = inputMesh->GetPoints();
+  const CellDataContainerType *                   inputCellData = inputMesh->GetCellData();
+  const bool                                      hasCellData = inputCellData && inputCellData->Size();
+  if (!inputCells || !inputPoints)
+  {
+    return;
+  }
+
+  // Piece id of the input points used by the current piece, cleared after
+  // each piece, so that its size and cost follow the chunk rather than the
+  // whole mesh
+  std::unordered_map<ElementType, ElementType> pieceIds;
+  std::vector<ElementType>                     inputPointIds;
+  const SizeValueType                          numberOfInputPoints = inputPoints->Size();
+
+  const SizeValueType            numberOfInputCells = inputCells->Size();
+  SizeValueType                  numberOfConvertedCells = 0;
+  SizeValueType                  chunkIndex = 0;
+  InputCellsConstIterator        chunkBegin = inputCells->Begin();
+  const InputCellsConstIterator  cellsEnd = inputCells->End();
+
+  // The boundary faces of the tetrahedra and hexahedra are found once over
+  // the whole mesh, so that a face shared by cells of different chunks is
+  // not output. Each chunk reads the entries of its own faces.
+  const SizeValueType numberOfRanges =
+    std::max<SizeValueType>(1, std::min<SizeValueType>(this->GetNumberOfWorkUnits(), numberOfInputCells));
+  const SizeValueType cellsPerRange =
+    std::max<SizeValueType>(1, (numberOfInputCells + numberOfRanges - 1) / numberOfRanges);
+  std::vector<InputCellsConstIterator> rangeBegin;
+  SizeValueType                        cellCount = 0;
+  for (InputCellsConstIterator cellItr = chunkBegin; cellItr != cellsEnd; ++cellItr, ++cellCount)
+  {
+    if (cellCount % cellsPerRange == 0)
+    {
+      rangeBegin.push_back(cellItr);
+    }
+  }
+  rangeBegin.push_back(cellsEnd);
+  std::vector<CellRangeCounts> rangeCounts(rangeBegin.size() - 1);
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    rangeCounts.size(),
+    [&rangeBegin, &rangeCounts](SizeValueType range) {
+      CountCellRange<InputMeshType>(rangeBegin[range], rangeBegin[range + 1], rangeCounts[range]);
+    },
+    nullptr);
+  std::vector<SizeValueType> rangeFirstFace(rangeBegin.size(), 0);
+  for (SizeValueType range = 0; range < rangeCounts.size(); ++range)
+  {
+    rangeFirstFace[range + 1] = rangeFirstFace[range] + rangeCounts[range].VolumeFaces;
+  }
+  std::vector<uint8_t> boundaryFaces;
+  if (rangeFirstFace.back() > 0)
+  {
+    FindBoundaryFaces<ElementType, InputMeshType>(rangeBegin, rangeFirstFace, boundaryFaces, this->GetMultiThreader());
+  }
+
+  SizeValueType chunkFirstFace = 0;
+  while (chunkBegin != cellsEnd)
+  {
+    InputCellsConstIterator chunkEnd = chunkBegin;
+    SizeValueType           numberOfChunkCells = 0;
+    SizeValueType           numberOfChunkFaces = 0;
+    for (; chunkEnd != cellsEnd && numberOfChunkCells < m_NumberOfCellsPerChunk; ++chunkEnd)
+    {
+      ++numberOfChunkCells;
+      const typename InputMeshType::CellType * cell = chunkEnd.Value();
+      if (cell && cell->GetType() == CellGeometryEnum::TETRAHEDRON_CELL)
+      {
+        numberOfChunkFaces += 4;
+      }
+      else if (cell && cell->GetType() == CellGeometryEnum::HEXAHEDRON_CELL)
+      {
+        numberOfChunkFaces += 6;
+      }
+    }
+
+    ConnectivityType connectivity;
+    GenerateConnectivity<TInputMeshDispatch>(chunkBegin,
+                                             chunkEnd,
+                                             numberOfChunkCells,
+                                             boundaryFaces.empty() ? nullptr : boundaryFaces.data() + chunkFirstFace,
+                                             connectivity);
+    chunkFirstFace += numberOfChunkFaces;
+    if (m_OptimizeVertexCache)
+    {
+      ReorderPolygonsForVertexCache(connectivity);
+    }
+    if (m_GenerateTriangleStrips)
+    {
+      JoinTrianglesIntoStrips<TInputMeshDispatch>(connectivity);
+    }
+
+    // Renumber the points used by the piece in order of first use
+    inputPointIds.clear();
+    for (CellsContainer * cells : { connectivity.Vertices.GetPointer(),
+                                    connectivity.Lines.GetPointer(),
+                                    connectivity.Polygons.GetPointer(),
+                                    connectivity.TriangleStrips.GetPointer() })
+    {
+      if (!cells)
+      {
+        continue;
+      }
+      std::vector<ElementType> & cellArray = cells->CastToSTLContainer();
+      for (SizeValueType position = 0; position < cellArray.size(); position += cellArray[position] + 1)
+      {
+        for (SizeValueType ii = position + 1; ii <= position + cellArray[position]; ++ii)
+        {
+          ElementType & pointId = cellArray[ii];
+          if (pointId >= numberOfInputPoints)
+          {
+            itkExceptionMacro("Cell point id " << pointId << " is not a point of the input mesh");
+          }
+          const auto pieceId = pieceIds.emplace(pointId, static_cast<ElementType>(inputPointIds.size()));
+          if (pieceId.second)
+          {
+            inputPointIds.push_back(pointId);
+          }
+          pointId = pieceId.first->second;
+        }
+      }
+    }
+    pieceIds.clear();
+
+    auto piece = PolyDataType::New();
+    piece->SetVertices(connectivity.Vertices);
+    piece->SetLines(connectivity.Lines);
+    piece->SetPolygons(connectivity.Polygons);
+    piece->SetTriangleStrips(connectivity.TriangleStrips);
+
+    typename PointsContainerType::Pointer piecePoints = AcquireContainer<PointsContainerType>(0);
+    GatherPoints(inputPoints,
+                 inputPointIds.data(),
+                 inputPointIds.size(),
+                 piecePoints.GetPointer(),
+                 this->GetMultiThreader(),
+                 this->GetNumberOfWorkUnits());
+    piece->SetPoints(piecePoints);
+    this->GatherPointData(inputPointIds.data(), inputPointIds.size(), piece);
+
+    const CellIdentifierElementType * const permutation = connectivity.CellIds->CastToSTLConstContainer().data();
+    const SizeValueType                     numberOfPieceCells = connectivity.CellIds->Size();
+    if (hasCellData && m_UseAttributeBuffers)
+    {
+      typename CellDataBufferType::Pointer pieceCellData = AcquireContainer<CellDataBufferType>(0);
+      const unsigned int                   numberOfComponents =
+        PolyDataType::FlattenPixels(inputCellData,
+                                    numberOfPieceCells,
+                                    [permutation](SizeValueType ii) { return permutation[ii]; },
+                                    pieceCellData->CastToSTLContainer(),
+                                    this->GetMultiThreader(),
+                                    this->GetNumberOfWorkUnits());
+      piece->SetCellDataBuffer(pieceCellData, numberOfComponents);
+    }
+    else if (hasCellData)
+    {
+      typename CellDataContainerType::Pointer pieceCellData = AcquireContainer<CellDataContainerType>(0);
+      GatherPixels(inputCellData,
+                   permutation,
+                   numberOfPieceCells,
+                   pieceCellData.GetPointer(),
+                   this->GetMultiThreader(),
+                   this->GetNumberOfWorkUnits());
+      piece->SetCellData(pieceCellData);
+    }
+
+    m_ChunkCallback(piece, chunkIndex);
 
-    outputPolyData->SetCellData(outputCellData);
+    numberOfConvertedCells += numberOfChunkCells;
+    this->UpdateProgress(static_cast<float>(numberOfConvertedCells) / static_cast<float>(numberOfInputCells));
+    ++chunkIndex;
+    chunkBegin = chunkEnd;
   }
 }
 
@@ -20,7 +20,20 @@
 
 #include "itkDataObject.h"
 #include "itkObjectFactory.h"
+#include "itkCommonEnums.h"
 #include "itkDefaultStaticMeshTraits.h"
+#include "itkFixedArray.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumericTraits.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -29,14 +42,55 @@ namespace itk
  *
  * \brief Geometry class compatible with vtk.js PolyData
  *
+ * Point and cell data are stored either as a container of pixels, or as a
+ * flat buffer of pixel components with a number of components per point or
+ * cell, as vtk.js data arrays are. The flat buffers avoid a heap allocation
+ * per pixel for variable length pixel types. When only a buffer is set, the
+ * per point and per cell access routines read from it.
+ *
+ * The entries of the cell arrays, point ids and numbers of cell points, are
+ * stored as TCellIndex, an unsigned integer type of 16, 32 or 64 bits. The
+ * largest value of TCellIndex is reserved as a marker for algorithms, so the
+ * number of points, and of points of each cell, must be less than it. See
+ * CanIndex() and CallWithNarrowestPolyDataType().
+ *
+ * Random access to the cells goes through an index of the offset of each
+ * cell in its cell array, as the offsets array of vtkCellArray. The index is
+ * built on the first access, for the four cell arrays at once in parallel,
+ * and rebuilt when a cell array is set or its container modified. Cells
+ * edited in place must be followed by a call to Modified() on their
+ * container.
+ *
+ * The point data and cell data hold the attribute of the pixel types of
+ * the PolyData, as containers of pixels or as flat buffers of components.
+ * Any other attribute is a named array, attached to the points or to the
+ * cells with its own component type and number of components, see
+ * SetPointDataArray(). Both kinds are carried by PolyDataBinaryFileWriter,
+ * PolyDataEncoder and PolyDataVTKFileWriter.
+ *
+ * Graft() shares the containers of another PolyData. With CopyOnWrite
+ * enabled, a container that is also referenced by another object, such as
+ * the PolyData it was grafted from, is copied before it is returned for
+ * modification: by the non-const container getters, and by SetPoint(),
+ * SetPointData() and SetCellData() with an identifier. The const getters
+ * never copy. Enabling CopyOnWrite on both PolyData lets them share their
+ * unchanged containers.
+ *
+ * The bounds of the points are computed with a parallel reduction on the
+ * first call to GetBounds(), and cached until the points container is set,
+ * modified or resized.
+ *
  * \ingroup MeshToPolyData
  */
-template <typename TPixel, typename TCellPixel = TPixel>
+template <typename TPixel, typename TCellPixel = TPixel, typename TCellIndex = uint32_t>
 class ITK_TEMPLATE_EXPORT PolyData : public DataObject
 {
 public:
   ITK_DISALLOW_COPY_AND_MOVE(PolyData);
 
+  static_assert(std::is_integral<TCellIndex>::value && std::is_unsigned<TCellIndex>::value && sizeof(TCellIndex) >= 2,
+                "TCellIndex must be an unsigned integer type of at least 16 bits");
+
   using Self = PolyData;
   using Superclass = DataObject;
   using Pointer = SmartPointer<Self>;
@@ -65,11 +119,96 @@ public:
   using PointDataContainer = typename MeshTraits::PointDataContainer;
   using CellIdentifier = typename MeshTraits::CellIdentifier;
   using CellDataContainer = typename MeshTraits::CellDataContainer;
-  using CellsContainer = VectorContainer<CellIdentifier, uint32_t>;
+  using CellIndexType = TCellIndex;
+  using CellsContainer = VectorContainer<CellIdentifier, CellIndexType>;
+
+  /** Whether the cell arrays can describe cells of a PolyData with
+   * maximumValue points, and of at most maximumValue points each. */
+  static constexpr bool
+  CanIndex(SizeValueType maximumValue)
+  {
+    return maximumValue <= static_cast<SizeValueType>(std::numeric_limits<CellIndexType>::max() - 1) ||
+           sizeof(CellIndexType) > sizeof(SizeValueType);
+  }
+
+  /** Offset of each cell of a cell array, followed by the size of the cell
+   * array, see GetPolygonOffsets(). */
+  using CellOffsetsContainer = VectorContainer<SizeValueType, SizeValueType>;
+
+  /** Point ids of a cell, viewed in place in its cell array. */
+  class CellPointIdsType
+  {
+  public:
+    CellPointIdsType() = default;
+    CellPointIdsType(const CellIndexType * data, SizeValueType size)
+      : m_Data(data)
+      , m_Size(size)
+    {}
+
+    const CellIndexType *
+    begin() const
+    {
+      return m_Data;
+    }
+    const CellIndexType *
+    end() const
+    {
+      return m_Data + m_Size;
+    }
+    const CellIndexType *
+    data() const
+    {
+      return m_Data;
+    }
+    SizeValueType
+    size() const
+    {
+      return m_Size;
+    }
+    bool
+    empty() const
+    {
+      return m_Size == 0;
+    }
+    const CellIndexType &
+    operator[](SizeValueType index) const
+    {
+      return m_Data[index];
+    }
+
+  private:
+    const CellIndexType * m_Data{ nullptr };
+    SizeValueType         m_Size{ 0 };
+  };
+
+  /** Bounds of the points, as [xmin, xmax, ymin, ymax, zmin, zmax]. */
+  using BoundsArrayType = FixedArray<CoordinateType, 2 * PointDimension>;
+
+  /** Flat storage of the components of the point data and cell data. */
+  using PixelComponentType = typename NumericTraits<PixelType>::ValueType;
+  using CellPixelComponentType = typename NumericTraits<CellPixelType>::ValueType;
+  using PointDataBufferType = VectorContainer<SizeValueType, PixelComponentType>;
+  using CellDataBufferType = VectorContainer<SizeValueType, CellPixelComponentType>;
 
   void
   Initialize() override;
 
+  /** Share the containers of data, which must be a PolyData of the same
+   * type, without copying them. */
+  void
+  Graft(const DataObject * data) override;
+
+  /** Check that data is a PolyData of the same type. A PolyData has no
+   * meta data besides its containers. */
+  void
+  CopyInformation(const DataObject * data) override;
+
+  /** Copy the containers referenced by other objects before modifying
+   * them. Off by default. */
+  itkSetMacro(CopyOnWrite, bool);
+  itkGetConstMacro(CopyOnWrite, bool);
+  itkBooleanMacro(CopyOnWrite);
+
   PointIdentifier
   GetNumberOfPoints() const;
 
@@ -123,6 +262,16 @@ public:
   const PointDataContainer *
   GetPointData() const;
 
+  /** Point data stored as a flat buffer of numberOfComponents components
+   * per point. */
+  void
+  SetPointDataBuffer(PointDataBufferType *, unsigned int numberOfComponents);
+  PointDataBufferType *
+  GetPointDataBuffer();
+  const PointDataBufferType *
+  GetPointDataBuffer() const;
+  itkGetConstMacro(NumberOfPointDataComponents, unsigned int);
+
   /** Access routines to fill the Points container, and get information
    * from it. */
   void SetPoint(PointIdentifier, PointType);
@@ -130,6 +279,12 @@ public:
             GetPoint(PointIdentifier, PointType *) const;
   PointType GetPoint(PointIdentifier) const;
 
+  /** Bounds of the points, all zero when there are none. NaN coordinates
+   * are ignored. Points edited in place must be followed by a call to
+   * Modified() on the points container. */
+  BoundsArrayType
+  GetBounds() const;
+
   /** Access routines to fill the PointData container, and get information
    * from it. */
   void SetPointData(PointIdentifier, PixelType);
@@ -147,12 +302,259 @@ public:
   const CellDataContainer *
   GetCellData() const;
 
+  /** Cell data stored as a flat buffer of numberOfComponents components
+   * per cell. */
+  void
+  SetCellDataBuffer(CellDataBufferType *, unsigned int numberOfComponents);
+  CellDataBufferType *
+  GetCellDataBuffer();
+  const CellDataBufferType *
+  GetCellDataBuffer() const;
+  itkGetConstMacro(NumberOfCellDataComponents, unsigned int);
+
   /** Access routines to fill the CellData container, and get information
    *  from it.  */
   void SetCellData(CellIdentifier, CellPixelType);
   bool
   GetCellData(CellIdentifier, CellPixelType *) const;
 
+  /** Contiguous storage of the tuples of a named attribute array. */
+  template <typename TComponent>
+  using AttributeArrayType = VectorContainer<SizeValueType, TComponent>;
+  using AttributeArrayNamesType = std::vector<std::string>;
+
+  /** Type of the components of an attribute array of TComponent, or
+   * UNKNOWNCOMPONENTTYPE for non arithmetic types. */
+  template <typename TComponent>
+  static constexpr IOComponentEnum
+  GetAttributeComponentType()
+  {
+    if (std::is_same<TComponent, long>::value)
+    {
+      return IOComponentEnum::LONG;
+    }
+    if (std::is_same<TComponent, unsigned long>::value)
+    {
+      return IOComponentEnum::ULONG;
+    }
+    if (std::is_floating_point<TComponent>::value)
+    {
+      return sizeof(TComponent) == sizeof(float)    ? IOComponentEnum::FLOAT
+             : sizeof(TComponent) == sizeof(double) ? IOComponentEnum::DOUBLE
+                                                    : IOComponentEnum::LDOUBLE;
+    }
+    if (!std::is_integral<TComponent>::value || std::is_same<TComponent, bool>::value)
+    {
+      return IOComponentEnum::UNKNOWNCOMPONENTTYPE;
+    }
+    constexpr bool isSigned = std::is_signed<TComponent>::value;
+    switch (sizeof(TComponent))
+    {
+      case 1:
+        return isSigned ? IOComponentEnum::CHAR : IOComponentEnum::UCHAR;
+      case 2:
+        return isSigned ? IOComponentEnum::SHORT : IOComponentEnum::USHORT;
+      case 4:
+        return isSigned ? IOComponentEnum::INT : IOComponentEnum::UINT;
+      default:
+        return isSigned ? IOComponentEnum::LONGLONG : IOComponentEnum::ULONGLONG;
+    }
+  }
+
+  /** Type of the components of an attribute array of floating point, or
+   * else signed or unsigned integer, components of size bytes, as stored by
+   * the writers of named arrays, or UNKNOWNCOMPONENTTYPE when there is no
+   * such type. */
+  static constexpr IOComponentEnum
+  GetAttributeComponentType(bool isFloatingPoint, bool isSigned, unsigned int size)
+  {
+    if (isFloatingPoint)
+    {
+      return size == sizeof(float)    ? GetAttributeComponentType<float>()
+             : size == sizeof(double) ? GetAttributeComponentType<double>()
+                                      : IOComponentEnum::UNKNOWNCOMPONENTTYPE;
+    }
+    switch (size)
+    {
+      case 1:
+        return isSigned ? GetAttributeComponentType<int8_t>() : GetAttributeComponentType<uint8_t>();
+      case 2:
+        return isSigned ? GetAttributeComponentType<int16_t>() : GetAttributeComponentType<uint16_t>();
+      case 4:
+        return isSigned ? GetAttributeComponentType<int32_t>() : GetAttributeComponentType<uint32_t>();
+      case 8:
+        return isSigned ? GetAttributeComponentType<int64_t>() : GetAttributeComponentType<uint64_t>();
+      default:
+        return IOComponentEnum::UNKNOWNCOMPONENTTYPE;
+    }
+  }
+
+  /** Call function with a zero of the component type of componentType, so
+   * that readers and writers can handle the attribute arrays whose type is
+   * only known at run time. Returns false, without calling function, for
+   * UNKNOWNCOMPONENTTYPE. CHAR and UCHAR arrays are handled as signed char
+   * and unsigned char. */
+  template <typename TFunction>
+  static bool
+  CallWithAttributeComponentType(IOComponentEnum componentType, TFunction && function)
+  {
+    switch (componentType)
+    {
+      case IOComponentEnum::CHAR:
+        function(static_cast<signed char>(0));
+        return true;
+      case IOComponentEnum::UCHAR:
+        function(static_cast<unsigned char>(0));
+        return true;
+      case IOComponentEnum::SHORT:
+        function(static_cast<short>(0));
+        return true;
+      case IOComponentEnum::USHORT:
+        function(static_cast<unsigned short>(0));
+        return true;
+      case IOComponentEnum::INT:
+        function(static_cast<int>(0));
+        return true;
+      case IOComponentEnum::UINT:
+        function(static_cast<unsigned int>(0));
+        return true;
+      case IOComponentEnum::LONG:
+        function(static_cast<long>(0));
+        return true;
+      case IOComponentEnum::ULONG:
+        function(static_cast<unsigned long>(0));
+        return true;
+      case IOComponentEnum::LONGLONG:
+        function(static_cast<long long>(0));
+        return true;
+      case IOComponentEnum::ULONGLONG:
+        function(static_cast<unsigned long long>(0));
+        return true;
+      case IOComponentEnum::FLOAT:
+        function(static_cast<float>(0));
+        return true;
+      case IOComponentEnum::DOUBLE:
+        function(static_cast<double>(0));
+        return true;
+      case IOComponentEnum::LDOUBLE:
+        function(static_cast<long double>(0));
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /** Copy the components of the pixels of container with ids pixelId(0),
+   * ..., pixelId(count - 1) into components, in numberOfWorkUnits blocks of
+   * consecutive pixels converted in parallel by multiThreader, so that the
+   * filters, writers and encoder that take pixel containers all flatten
+   * them the same way. Returns the number of components of each pixel, 0
+   * when count is 0, and throws when they differ between pixels. */
+  template <typename TContainer, typename TPixelId, typename TComponent>
+  static unsigned int
+  FlattenPixels(const TContainer *        container,
+                SizeValueType             count,
+                TPixelId &&               pixelId,
+                std::vector<TComponent> & components,
+                MultiThreaderBase *       multiThreader,
+                SizeValueType             numberOfWorkUnits);
+
+  /** Named attribute arrays of the points, of numberOfComponents components
+   * per point. The container is referenced, not copied; setting a null
+   * container removes the array. GetPointDataArray() returns nullptr when
+   * there is no array of that name with components of type TComponent. */
+  template <typename TComponent>
+  void
+  SetPointDataArray(const std::string &              name,
+                    AttributeArrayType<TComponent> * values,
+                    unsigned int                     numberOfComponents = 1);
+  template <typename TComponent>
+  AttributeArrayType<TComponent> *
+  GetPointDataArray(const std::string & name);
+  template <typename TComponent>
+  const AttributeArrayType<TComponent> *
+  GetPointDataArray(const std::string & name) const;
+  void
+  RemovePointDataArray(const std::string & name);
+  /** Names of the point data arrays, in alphabetical order. */
+  AttributeArrayNamesType
+  GetPointDataArrayNames() const;
+  /** Number and type of the components of a point data array, 0 and
+   * UNKNOWNCOMPONENTTYPE when there is no array of that name. */
+  unsigned int
+  GetPointDataArrayNumberOfComponents(const std::string & name) const;
+  IOComponentEnum
+  GetPointDataArrayComponentType(const std::string & name) const;
+  /** Components of a point data array, of the type given by
+   * GetPointDataArrayComponentType(), and their number, for code that does
+   * not know that type at compile time. nullptr, with no values, when there
+   * is no array of that name. */
+  const void *
+  GetPointDataArrayValues(const std::string & name, SizeValueType & numberOfValues) const;
+
+  /** Named attribute arrays of the cells, numbered as the cell data, see
+   * SetPointDataArray(). */
+  template <typename TComponent>
+  void
+  SetCellDataArray(const std::string &              name,
+                   AttributeArrayType<TComponent> * values,
+                   unsigned int                     numberOfComponents = 1);
+  template <typename TComponent>
+  AttributeArrayType<TComponent> *
+  GetCellDataArray(const std::string & name);
+  template <typename TComponent>
+  const AttributeArrayType<TComponent> *
+  GetCellDataArray(const std::string & name) const;
+  void
+  RemoveCellDataArray(const std::string & name);
+  AttributeArrayNamesType
+  GetCellDataArrayNames() const;
+  unsigned int
+  GetCellDataArrayNumberOfComponents(const std::string & name) const;
+  IOComponentEnum
+  GetCellDataArrayComponentType(const std::string & name) const;
+  const void *
+  GetCellDataArrayValues(const std::string & name, SizeValueType & numberOfValues) const;
+
+  /** Offset in its cell array of the count of each vertex, line, polygon
+   * or triangle strip, followed by the size of the cell array, so that
+   * cell i spans [offsets[i], offsets[i + 1]). The returned container is
+   * valid until the cell array is set or modified. */
+  const CellOffsetsContainer *
+  GetVertexOffsets() const;
+  const CellOffsetsContainer *
+  GetLineOffsets() const;
+  const CellOffsetsContainer *
+  GetPolygonOffsets() const;
+  const CellOffsetsContainer *
+  GetTriangleStripOffsets() const;
+
+  /** Number of cells of each cell array. */
+  SizeValueType
+  GetNumberOfVertices() const;
+  SizeValueType
+  GetNumberOfLines() const;
+  SizeValueType
+  GetNumberOfPolygons() const;
+  SizeValueType
+  GetNumberOfTriangleStrips() const;
+
+  /** Point ids of the cell of index id within its cell array, in constant
+   * time. An exception is thrown when id is out of range. */
+  CellPointIdsType
+  GetVertex(SizeValueType id) const;
+  CellPointIdsType
+  GetLine(SizeValueType id) const;
+  CellPointIdsType
+  GetPolygon(SizeValueType id) const;
+  CellPointIdsType
+  GetTriangleStrip(SizeValueType id) const;
+
+  /** Point ids of the cell of identifier cellId, numbered as the cell data:
+   * the vertices, then the lines, the polygons and the triangle strips. */
+  CellPointIdsType
+  GetCellPointIds(CellIdentifier cellId) const;
+
 protected:
   PolyData();
   ~PolyData() override = default;
@@ -177,9 +579,134 @@ protected:
 
   typename CellDataContainer::Pointer m_CellDataContainer;
 
+  /** Flat point data and cell data, optionally used instead of the
+   * containers above. */
+  typename PointDataBufferType::Pointer m_PointDataBuffer;
+  unsigned int                          m_NumberOfPointDataComponents{ 0 };
+  typename CellDataBufferType::Pointer  m_CellDataBuffer;
+  unsigned int                          m_NumberOfCellDataComponents{ 0 };
+
+  bool m_CopyOnWrite{ false };
+
 private:
+  /** Cell arrays, in the order of the cell data. */
+  enum CellArrayIndex : unsigned int
+  {
+    VerticesArray,
+    LinesArray,
+    PolygonsArray,
+    TriangleStripsArray,
+    NumberOfCellArrays
+  };
+
+  /** Container of a named attribute array, with the type and number of its
+   * components. */
+  struct AttributeArray
+  {
+    Object::Pointer Values;
+    IOComponentEnum ComponentType{ IOComponentEnum::UNKNOWNCOMPONENTTYPE };
+    unsigned int    NumberOfComponents{ 0 };
+
+    /** Components and number of components of Values, cast back to its
+     * type. */
+    const void * (*GetValues)(const Object * values, SizeValueType & numberOfValues){ nullptr };
+  };
+  using AttributeArrayMapType = std::map<std::string, AttributeArray>;
+
+  template <typename TComponent>
+  void
+  SetAttributeArray(AttributeArrayMapType &          arrays,
+                    const std::string &              name,
+                    AttributeArrayType<TComponent> * values,
+                    unsigned int                     numberOfComponents);
+
+  /** With CopyOnWrite, the array is copied when it is also referenced by
+   * another object. */
+  template <typename TComponent>
+  AttributeArrayType<TComponent> *
+  GetAttributeArray(AttributeArrayMapType & arrays, const std::string & name);
+
+  template <typename TComponent>
+  static const AttributeArrayType<TComponent> *
+  GetConstAttributeArray(const AttributeArrayMapType & arrays, const std::string & name);
+
+  static AttributeArrayNamesType
+  GetAttributeArrayNames(const AttributeArrayMapType & arrays);
+
+  static const AttributeArray *
+  FindAttributeArray(const AttributeArrayMapType & arrays, const std::string & name);
+
+  static const void *
+  GetAttributeArrayValues(const AttributeArrayMapType & arrays,
+                          const std::string &           name,
+                          SizeValueType &               numberOfValues);
+
+  AttributeArrayMapType m_PointDataArrays;
+  AttributeArrayMapType m_CellDataArrays;
+
+  /** Offsets of a cell array, with the container and modification time
+   * they were built from. */
+  struct CellOffsetsIndex
+  {
+    typename CellsContainer::ConstPointer  Cells;
+    ModifiedTimeType                       CellsMTime{ 0 };
+    typename CellOffsetsContainer::Pointer Offsets;
+  };
+
+  const CellsContainer *
+  GetCellArray(CellArrayIndex cellArray) const;
+
+  /** Rebuild the offsets of the cell arrays that changed. */
+  const CellOffsetsContainer *
+  GetCellOffsets(CellArrayIndex cellArray) const;
+
+  CellPointIdsType
+  GetCellPointIdsInArray(CellArrayIndex cellArray, SizeValueType id) const;
+
+  /** With CopyOnWrite, replace container by a copy when an object other
+   * than this PolyData references it. cachedReference is a cache of this
+   * PolyData that may also reference it. */
+  template <typename TContainer>
+  void
+  PrepareContainerForWrite(SmartPointer<TContainer> & container, const Object * cachedReference = nullptr);
+
+  mutable std::array<CellOffsetsIndex, NumberOfCellArrays> m_CellOffsets;
+  mutable std::mutex                                       m_CellOffsetsMutex;
+
+  /** Bounds of the points, with the container, modification time and size
+   * they were computed from. The container is only compared, never
+   * dereferenced, so that the cache neither keeps a replaced container alive
+   * nor counts as a reference of another owner with CopyOnWrite. A container
+   * allocated at the address of a released one has a later modification
+   * time, so it does not match. */
+  mutable const PointsContainer * m_BoundsPoints{ nullptr };
+  mutable ModifiedTimeType        m_BoundsPointsMTime{ 0 };
+  mutable SizeValueType           m_BoundsNumberOfPoints{ 0 };
+  mutable BoundsArrayType         m_Bounds;
+  mutable std::mutex              m_BoundsMutex;
 };
 
+/** Call function with a null pointer to PolyData<TPixel, TCellPixel,
+ * TCellIndex>, where TCellIndex is the narrowest of uint16_t, uint32_t and
+ * uint64_t for which PolyData::CanIndex(maximumValue) holds, and return its
+ * result. function is typically a generic lambda that instantiates a
+ * pipeline for the PolyData type of its argument, so that small meshes are
+ * stored with 16-bit cell arrays. */
+template <typename TPixel, typename TCellPixel, typename TFunction>
+auto
+CallWithNarrowestPolyDataType(SizeValueType maximumValue, TFunction && function)
+{
+  if (PolyData<TPixel, TCellPixel, uint16_t>::CanIndex(maximumValue))
+  {
+    return function(static_cast<PolyData<TPixel, TCellPixel, uint16_t> *>(nullptr));
+  }
+  if (PolyData<TPixel, TCellPixel, uint32_t>::CanIndex(maximumValue))
+  {
+    return function(static_cast<PolyData<TPixel, TCellPixel, uint32_t> *>(nullptr));
+  }
+  return function(static_cast<PolyData<TPixel, TCellPixel, uint64_t> *>(nullptr));
+}
+
 } // end namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
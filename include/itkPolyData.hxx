@@ -19,12 +19,132 @@
 #define itkPolyData_hxx
 
 #include "itkPolyData.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <atomic>
+#include <typeinfo>
+#include <vector>
+
+namespace
+{
+// Read the pixel of index id from a flat buffer of pixel components
+template <typename TPixel, typename TBuffer>
+bool
+GetPixelFromBuffer(const TBuffer * buffer, unsigned int numberOfComponents, itk::SizeValueType id, TPixel * pixel)
+{
+  if (!buffer || numberOfComponents == 0 || (id + 1) * numberOfComponents > buffer->Size())
+  {
+    return false;
+  }
+  if (pixel)
+  {
+    itk::NumericTraits<TPixel>::SetLength(*pixel, numberOfComponents);
+    const auto * components = buffer->CastToSTLConstContainer().data() + id * numberOfComponents;
+    for (unsigned int component = 0; component < numberOfComponents; ++component)
+    {
+      itk::DefaultConvertPixelTraits<TPixel>::SetNthComponent(component, *pixel, components[component]);
+    }
+  }
+  return true;
+}
+
+// Write the position of the count of each cell of cells, in the [n p0 p1
+// ...] layout, followed by the size of cells, to offsets. Return false when
+// a cell extends past the end of cells. The count is compared with the
+// values left before the position advances, so that a count near the
+// maximum of a 64 bit index cannot wrap the position around.
+template <typename TElement>
+bool
+BuildCellOffsets(const std::vector<TElement> & cells, std::vector<itk::SizeValueType> & offsets)
+{
+  // Most cells are triangles
+  offsets.reserve(cells.size() / 4 + 1);
+  itk::SizeValueType position = 0;
+  while (position < cells.size())
+  {
+    const auto count = static_cast<itk::SizeValueType>(cells[position]);
+    if (count >= cells.size() - position)
+    {
+      offsets.push_back(cells.size());
+      return false;
+    }
+    offsets.push_back(position);
+    position += count + 1;
+  }
+  offsets.push_back(cells.size());
+  return true;
+}
+
+// Minimum and maximum of each coordinate of the numberOfPoints points, in
+// blocks reduced in parallel. The comparisons are written without branches
+// so that the loop over a block vectorizes, and are false for NaN
+// coordinates, which are skipped. An axis without finite coordinates has a
+// minimum above its maximum.
+template <typename TCoordinate, unsigned int VDimension>
+std::array<TCoordinate, 2 * VDimension>
+ComputePointBounds(const TCoordinate * coordinates, itk::SizeValueType numberOfPoints)
+{
+  constexpr itk::SizeValueType PointsPerBlock = 1 << 16;
+  using BoundsType = std::array<TCoordinate, 2 * VDimension>;
+
+  BoundsType emptyBounds;
+  for (unsigned int dim = 0; dim < VDimension; ++dim)
+  {
+    emptyBounds[2 * dim] = std::numeric_limits<TCoordinate>::max();
+    emptyBounds[2 * dim + 1] = std::numeric_limits<TCoordinate>::lowest();
+  }
+
+  const itk::SizeValueType numberOfBlocks = (numberOfPoints + PointsPerBlock - 1) / PointsPerBlock;
+  std::vector<BoundsType>  blockBounds(numberOfBlocks, emptyBounds);
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](itk::SizeValueType block) {
+      TCoordinate minimum[VDimension];
+      TCoordinate maximum[VDimension];
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+      {
+        minimum[dim] = emptyBounds[2 * dim];
+        maximum[dim] = emptyBounds[2 * dim + 1];
+      }
+      const TCoordinate * first = coordinates + block * PointsPerBlock * VDimension;
+      const TCoordinate * last = coordinates + std::min(numberOfPoints, (block + 1) * PointsPerBlock) * VDimension;
+      for (const TCoordinate * point = first; point != last; point += VDimension)
+      {
+        for (unsigned int dim = 0; dim < VDimension; ++dim)
+        {
+          minimum[dim] = point[dim] < minimum[dim] ? point[dim] : minimum[dim];
+          maximum[dim] = point[dim] > maximum[dim] ? point[dim] : maximum[dim];
+        }
+      }
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+      {
+        blockBounds[block][2 * dim] = minimum[dim];
+        blockBounds[block][2 * dim + 1] = maximum[dim];
+      }
+    },
+    nullptr);
+
+  BoundsType bounds = emptyBounds;
+  for (const BoundsType & block : blockBounds)
+  {
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      bounds[2 * dim] = std::min(bounds[2 * dim], block[2 * dim]);
+      bounds[2 * dim + 1] = std::max(bounds[2 * dim + 1], block[2 * dim + 1]);
+    }
+  }
+  return bounds;
+}
+} // end anonymous namespace
 
 namespace itk
 {
 
-template <typename TPixelType, typename TCellPixel>
-PolyData<TPixelType, TCellPixel>::PolyData()
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+PolyData<TPixelType, TCellPixel, TCellIndex>::PolyData()
   : m_PointsContainer(nullptr)
   , m_VerticesContainer(nullptr)
   , m_LinesContainer(nullptr)
@@ -32,12 +152,14 @@ PolyData<TPixelType, TCellPixel>::PolyData()
   , m_TriangleStripsContainer(nullptr)
   , m_PointDataContainer(nullptr)
   , m_CellDataContainer(nullptr)
-{}
+{
+  m_Bounds.Fill(NumericTraits<CoordinateType>::ZeroValue());
+}
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 void
-PolyData<TPixelType, TCellPixel>::PrintSelf(std::ostream & os, Indent indent) const
+PolyData<TPixelType, TCellPixel, TCellIndex>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Number Of Points: " << this->GetNumberOfPoints() << std::endl;
@@ -51,12 +173,27 @@ PolyData<TPixelType, TCellPixel>::PrintSelf(std::ostream & os, Indent indent) co
      << std::endl;
   os << indent << "Size of Cell Data Container: " << ((m_CellDataContainer) ? m_CellDataContainer->Size() : 0)
      << std::endl;
+  os << indent << "Point Data Buffer pointer: " << m_PointDataBuffer.GetPointer() << std::endl;
+  os << indent << "Number Of Point Data Components: " << m_NumberOfPointDataComponents << std::endl;
+  os << indent << "Cell Data Buffer pointer: " << m_CellDataBuffer.GetPointer() << std::endl;
+  os << indent << "Number Of Cell Data Components: " << m_NumberOfCellDataComponents << std::endl;
+  for (const auto & array : m_PointDataArrays)
+  {
+    os << indent << "Point Data Array " << array.first << ": " << array.second.Values.GetPointer() << ", "
+       << array.second.NumberOfComponents << " " << array.second.ComponentType << " components" << std::endl;
+  }
+  for (const auto & array : m_CellDataArrays)
+  {
+    os << indent << "Cell Data Array " << array.first << ": " << array.second.Values.GetPointer() << ", "
+       << array.second.NumberOfComponents << " " << array.second.ComponentType << " components" << std::endl;
+  }
+  os << indent << "CopyOnWrite: " << m_CopyOnWrite << std::endl;
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 void
-PolyData<TPixelType, TCellPixel>::SetPoints(PointsContainer * points)
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetPoints(PointsContainer * points)
 {
   itkDebugMacro("setting Points container to " << points);
   if (m_PointsContainer != points)
@@ -67,176 +204,200 @@ PolyData<TPixelType, TCellPixel>::SetPoints(PointsContainer * points)
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetPoints() -> PointsContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPoints() -> PointsContainer *
 {
   itkDebugMacro("Starting GetPoints()");
   if (!m_PointsContainer)
   {
     this->SetPoints(PointsContainer::New());
   }
+  else
+  {
+    this->PrepareContainerForWrite(m_PointsContainer);
+  }
   itkDebugMacro("returning Points container of " << m_PointsContainer);
   return m_PointsContainer;
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetPoints() const -> const PointsContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPoints() const -> const PointsContainer *
 {
   itkDebugMacro("returning Points container of " << m_PointsContainer);
   return m_PointsContainer.GetPointer();
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 void
-PolyData<TPixelType, TCellPixel>::SetVertices(CellsContainer * vertices)
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetVertices(CellsContainer * vertices)
 {
   itkDebugMacro("setting Vertices container to " << vertices);
   if (m_VerticesContainer != vertices)
   {
     m_VerticesContainer = vertices;
+    m_CellOffsets[VerticesArray] = CellOffsetsIndex();
     this->Modified();
   }
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetVertices() -> CellsContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetVertices() -> CellsContainer *
 {
   itkDebugMacro("Starting GetVertices()");
   if (!m_VerticesContainer)
   {
     this->SetVertices(CellsContainer::New());
   }
+  else
+  {
+    this->PrepareContainerForWrite(m_VerticesContainer, m_CellOffsets[VerticesArray].Cells.GetPointer());
+  }
   itkDebugMacro("returning Vertices container of " << m_VerticesContainer);
   return m_VerticesContainer.GetPointer();
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetVertices() const -> const CellsContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetVertices() const -> const CellsContainer *
 {
   itkDebugMacro("returning Vertices container of " << m_VerticesContainer);
   return m_VerticesContainer.GetPointer();
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 void
-PolyData<TPixelType, TCellPixel>::SetLines(CellsContainer * lines)
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetLines(CellsContainer * lines)
 {
   itkDebugMacro("setting Lines container to " << lines);
   if (m_LinesContainer != lines)
   {
     m_LinesContainer = lines;
+    m_CellOffsets[LinesArray] = CellOffsetsIndex();
     this->Modified();
   }
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetLines() -> CellsContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetLines() -> CellsContainer *
 {
   itkDebugMacro("Starting GetLines()");
   if (!m_LinesContainer)
   {
     this->SetLines(CellsContainer::New());
   }
+  else
+  {
+    this->PrepareContainerForWrite(m_LinesContainer, m_CellOffsets[LinesArray].Cells.GetPointer());
+  }
   itkDebugMacro("returning Lines container of " << m_LinesContainer);
   return m_LinesContainer.GetPointer();
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetLines() const -> const CellsContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetLines() const -> const CellsContainer *
 {
   itkDebugMacro("returning Lines container of " << m_LinesContainer);
   return m_LinesContainer.GetPointer();
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 void
-PolyData<TPixelType, TCellPixel>::SetPolygons(CellsContainer * polygons)
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetPolygons(CellsContainer * polygons)
 {
   itkDebugMacro("setting Polygons container to " << polygons);
   if (m_PolygonsContainer != polygons)
   {
     m_PolygonsContainer = polygons;
+    m_CellOffsets[PolygonsArray] = CellOffsetsIndex();
     this->Modified();
   }
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetPolygons() -> CellsContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPolygons() -> CellsContainer *
 {
   itkDebugMacro("Starting GetPolygons()");
   if (!m_PolygonsContainer)
   {
     this->SetPolygons(CellsContainer::New());
   }
+  else
+  {
+    this->PrepareContainerForWrite(m_PolygonsContainer, m_CellOffsets[PolygonsArray].Cells.GetPointer());
+  }
   itkDebugMacro("returning Polygons container of " << m_PolygonsContainer);
   return m_PolygonsContainer.GetPointer();
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetPolygons() const -> const CellsContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPolygons() const -> const CellsContainer *
 {
   itkDebugMacro("returning Polygons container of " << m_PolygonsContainer);
   return m_PolygonsContainer.GetPointer();
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 void
-PolyData<TPixelType, TCellPixel>::SetTriangleStrips(CellsContainer * polygons)
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetTriangleStrips(CellsContainer * polygons)
 {
   itkDebugMacro("setting TriangleStrips container to " << polygons);
   if (m_TriangleStripsContainer != polygons)
   {
     m_TriangleStripsContainer = polygons;
+    m_CellOffsets[TriangleStripsArray] = CellOffsetsIndex();
     this->Modified();
   }
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetTriangleStrips() -> CellsContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetTriangleStrips() -> CellsContainer *
 {
   itkDebugMacro("Starting GetTriangleStrips()");
   if (!m_TriangleStripsContainer)
   {
     this->SetTriangleStrips(CellsContainer::New());
   }
+  else
+  {
+    this->PrepareContainerForWrite(m_TriangleStripsContainer, m_CellOffsets[TriangleStripsArray].Cells.GetPointer());
+  }
   itkDebugMacro("returning TriangleStrips container of " << m_TriangleStripsContainer);
   return m_TriangleStripsContainer.GetPointer();
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetTriangleStrips() const -> const CellsContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetTriangleStrips() const -> const CellsContainer *
 {
   itkDebugMacro("returning TriangleStrips container of " << m_TriangleStripsContainer);
   return m_TriangleStripsContainer.GetPointer();
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 void
-PolyData<TPixelType, TCellPixel>::SetPointData(PointDataContainer * pointData)
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetPointData(PointDataContainer * pointData)
 {
   itkDebugMacro("setting PointData container to " << pointData);
   if (m_PointDataContainer != pointData)
@@ -247,31 +408,69 @@ PolyData<TPixelType, TCellPixel>::SetPointData(PointDataContainer * pointData)
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetPointData() -> PointDataContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPointData() -> PointDataContainer *
 {
   if (!m_PointDataContainer)
   {
     this->SetPointData(PointDataContainer::New());
   }
+  else
+  {
+    this->PrepareContainerForWrite(m_PointDataContainer);
+  }
   itkDebugMacro("returning PointData container of " << m_PointDataContainer);
   return m_PointDataContainer;
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetPointData() const -> const PointDataContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPointData() const -> const PointDataContainer *
 {
   itkDebugMacro("returning PointData container of " << m_PointDataContainer);
   return m_PointDataContainer.GetPointer();
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 void
-PolyData<TPixelType, TCellPixel>::SetPoint(PointIdentifier ptId, PointType point)
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetPointDataBuffer(PointDataBufferType * pointData,
+                                                                 unsigned int          numberOfComponents)
+{
+  itkDebugMacro("setting PointData buffer to " << pointData << " with " << numberOfComponents << " components");
+  if (m_PointDataBuffer != pointData || m_NumberOfPointDataComponents != numberOfComponents)
+  {
+    m_PointDataBuffer = pointData;
+    m_NumberOfPointDataComponents = numberOfComponents;
+    this->Modified();
+  }
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPointDataBuffer() -> PointDataBufferType *
+{
+  this->PrepareContainerForWrite(m_PointDataBuffer);
+  itkDebugMacro("returning PointData buffer of " << m_PointDataBuffer);
+  return m_PointDataBuffer.GetPointer();
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPointDataBuffer() const -> const PointDataBufferType *
+{
+  itkDebugMacro("returning PointData buffer of " << m_PointDataBuffer);
+  return m_PointDataBuffer.GetPointer();
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+void
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetPoint(PointIdentifier ptId, PointType point)
 {
   /**
    * Make sure a points container exists.
@@ -280,6 +479,10 @@ PolyData<TPixelType, TCellPixel>::SetPoint(PointIdentifier ptId, PointType point
   {
     this->SetPoints(PointsContainer::New());
   }
+  else
+  {
+    this->PrepareContainerForWrite(m_PointsContainer);
+  }
 
   /**
    * Insert the point into the container with the given identifier.
@@ -288,9 +491,9 @@ PolyData<TPixelType, TCellPixel>::SetPoint(PointIdentifier ptId, PointType point
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 bool
-PolyData<TPixelType, TCellPixel>::GetPoint(PointIdentifier ptId, PointType * point) const
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPoint(PointIdentifier ptId, PointType * point) const
 {
   /**
    * If the points container doesn't exist, then the point doesn't either.
@@ -307,9 +510,9 @@ PolyData<TPixelType, TCellPixel>::GetPoint(PointIdentifier ptId, PointType * poi
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetPoint(PointIdentifier ptId) const -> PointType
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPoint(PointIdentifier ptId) const -> PointType
 {
   /**
    * If the points container doesn't exist, then the point doesn't either.
@@ -332,9 +535,9 @@ PolyData<TPixelType, TCellPixel>::GetPoint(PointIdentifier ptId) const -> PointT
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 void
-PolyData<TPixelType, TCellPixel>::SetPointData(PointIdentifier ptId, PixelType data)
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetPointData(PointIdentifier ptId, PixelType data)
 {
   /**
    * Make sure a point data container exists.
@@ -343,6 +546,10 @@ PolyData<TPixelType, TCellPixel>::SetPointData(PointIdentifier ptId, PixelType d
   {
     this->SetPointData(PointDataContainer::New());
   }
+  else
+  {
+    this->PrepareContainerForWrite(m_PointDataContainer);
+  }
 
   /**
    * Insert the point data into the container with the given identifier.
@@ -351,17 +558,17 @@ PolyData<TPixelType, TCellPixel>::SetPointData(PointIdentifier ptId, PixelType d
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 bool
-PolyData<TPixelType, TCellPixel>::GetPointData(PointIdentifier ptId, PixelType * data) const
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPointData(PointIdentifier ptId, PixelType * data) const
 {
   /**
-   * If the point data container doesn't exist, then the point data doesn't
-   * either.
+   * If the point data container doesn't exist, then the point data can only
+   * be in the flat buffer.
    */
   if (!m_PointDataContainer)
   {
-    return false;
+    return GetPixelFromBuffer(m_PointDataBuffer.GetPointer(), m_NumberOfPointDataComponents, ptId, data);
   }
 
   /**
@@ -371,9 +578,9 @@ PolyData<TPixelType, TCellPixel>::GetPointData(PointIdentifier ptId, PixelType *
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetNumberOfPoints() const -> PointIdentifier
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetNumberOfPoints() const -> PointIdentifier
 {
   if (m_PointsContainer)
   {
@@ -383,9 +590,9 @@ PolyData<TPixelType, TCellPixel>::GetNumberOfPoints() const -> PointIdentifier
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 void
-PolyData<TPixelType, TCellPixel>::SetCellData(CellDataContainer * cellData)
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetCellData(CellDataContainer * cellData)
 {
   itkDebugMacro("setting CellData container to " << cellData);
   if (m_CellDataContainer != cellData)
@@ -396,27 +603,62 @@ PolyData<TPixelType, TCellPixel>::SetCellData(CellDataContainer * cellData)
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetCellData() -> CellDataContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellData() -> CellDataContainer *
 {
+  this->PrepareContainerForWrite(m_CellDataContainer);
   itkDebugMacro("returning CellData container of " << m_CellDataContainer);
   return m_CellDataContainer;
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 auto
-PolyData<TPixelType, TCellPixel>::GetCellData() const -> const CellDataContainer *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellData() const -> const CellDataContainer *
 {
   itkDebugMacro("returning CellData container of " << m_CellDataContainer);
   return m_CellDataContainer;
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 void
-PolyData<TPixelType, TCellPixel>::SetCellData(CellIdentifier cellId, TCellPixel data)
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetCellDataBuffer(CellDataBufferType * cellData,
+                                                                unsigned int         numberOfComponents)
+{
+  itkDebugMacro("setting CellData buffer to " << cellData << " with " << numberOfComponents << " components");
+  if (m_CellDataBuffer != cellData || m_NumberOfCellDataComponents != numberOfComponents)
+  {
+    m_CellDataBuffer = cellData;
+    m_NumberOfCellDataComponents = numberOfComponents;
+    this->Modified();
+  }
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellDataBuffer() -> CellDataBufferType *
+{
+  this->PrepareContainerForWrite(m_CellDataBuffer);
+  itkDebugMacro("returning CellData buffer of " << m_CellDataBuffer);
+  return m_CellDataBuffer.GetPointer();
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellDataBuffer() const -> const CellDataBufferType *
+{
+  itkDebugMacro("returning CellData buffer of " << m_CellDataBuffer);
+  return m_CellDataBuffer.GetPointer();
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+void
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetCellData(CellIdentifier cellId, TCellPixel data)
 {
   /**
    * Assign data to a cell identifier.  If a spot for the cell identifier
@@ -431,6 +673,10 @@ PolyData<TPixelType, TCellPixel>::SetCellData(CellIdentifier cellId, TCellPixel
   {
     this->SetCellData(CellDataContainer::New());
   }
+  else
+  {
+    this->PrepareContainerForWrite(m_CellDataContainer);
+  }
 
   /**
    * Insert the cell data into the container with the given identifier.
@@ -439,9 +685,9 @@ PolyData<TPixelType, TCellPixel>::SetCellData(CellIdentifier cellId, TCellPixel
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 bool
-PolyData<TPixelType, TCellPixel>::GetCellData(CellIdentifier cellId, TCellPixel * data) const
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellData(CellIdentifier cellId, TCellPixel * data) const
 {
   /**
    * Check if cell data exists for a given cell identifier.  If a spot for
@@ -452,12 +698,12 @@ PolyData<TPixelType, TCellPixel>::GetCellData(CellIdentifier cellId, TCellPixel
    */
 
   /**
-   * If the cell data container doesn't exist, then the cell data doesn't
-   * either.
+   * If the cell data container doesn't exist, then the cell data can only
+   * be in the flat buffer.
    */
   if (!m_CellDataContainer)
   {
-    return false;
+    return GetPixelFromBuffer(m_CellDataBuffer.GetPointer(), m_NumberOfCellDataComponents, cellId, data);
   }
 
   /**
@@ -467,15 +713,671 @@ PolyData<TPixelType, TCellPixel>::GetCellData(CellIdentifier cellId, TCellPixel
 }
 
 
-template <typename TPixelType, typename TCellPixel>
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetBounds() const -> BoundsArrayType
+{
+  const std::lock_guard<std::mutex> lock(m_BoundsMutex);
+
+  const PointsContainer * points = m_PointsContainer.GetPointer();
+  const SizeValueType     numberOfPoints = points ? points->Size() : 0;
+  if (m_BoundsPoints == points && (!points || m_BoundsPointsMTime == points->GetMTime()) &&
+      m_BoundsNumberOfPoints == numberOfPoints)
+  {
+    return m_Bounds;
+  }
+
+  m_Bounds.Fill(NumericTraits<CoordinateType>::ZeroValue());
+  if (numberOfPoints > 0)
+  {
+    // The points are stored contiguously, as PointDimension coordinates each
+    static_assert(sizeof(PointType) == PointDimension * sizeof(CoordinateType), "PointType must not be padded");
+    const auto bounds = ComputePointBounds<CoordinateType, PointDimension>(
+      points->CastToSTLConstContainer().data()->GetDataPointer(), numberOfPoints);
+    for (unsigned int dim = 0; dim < PointDimension; ++dim)
+    {
+      if (bounds[2 * dim] <= bounds[2 * dim + 1])
+      {
+        m_Bounds[2 * dim] = bounds[2 * dim];
+        m_Bounds[2 * dim + 1] = bounds[2 * dim + 1];
+      }
+    }
+  }
+  m_BoundsPoints = points;
+  m_BoundsPointsMTime = points ? points->GetMTime() : 0;
+  m_BoundsNumberOfPoints = numberOfPoints;
+  return m_Bounds;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellArray(CellArrayIndex cellArray) const -> const CellsContainer *
+{
+  switch (cellArray)
+  {
+    case VerticesArray:
+      return m_VerticesContainer.GetPointer();
+    case LinesArray:
+      return m_LinesContainer.GetPointer();
+    case PolygonsArray:
+      return m_PolygonsContainer.GetPointer();
+    default:
+      return m_TriangleStripsContainer.GetPointer();
+  }
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellOffsets(CellArrayIndex cellArray) const
+  -> const CellOffsetsContainer *
+{
+  const std::lock_guard<std::mutex> lock(m_CellOffsetsMutex);
+
+  std::array<bool, NumberOfCellArrays> stale;
+  unsigned int                         numberOfStaleArrays = 0;
+  for (unsigned int ii = 0; ii < NumberOfCellArrays; ++ii)
+  {
+    const CellsContainer *   cells = this->GetCellArray(static_cast<CellArrayIndex>(ii));
+    const CellOffsetsIndex & index = m_CellOffsets[ii];
+    stale[ii] = !index.Offsets || index.Cells != cells || (cells && index.CellsMTime != cells->GetMTime());
+    numberOfStaleArrays += stale[ii];
+  }
+  if (numberOfStaleArrays == 0)
+  {
+    return m_CellOffsets[cellArray].Offsets.GetPointer();
+  }
+
+  // Each cell array is walked from its start, so the arrays are indexed in
+  // parallel with each other
+  std::array<CellOffsetsIndex, NumberOfCellArrays> built;
+  std::array<bool, NumberOfCellArrays>             malformed{};
+
+  const auto buildOffsets = [this, &stale, &built, &malformed](SizeValueType ii) {
+    if (!stale[ii])
+    {
+      return;
+    }
+    CellOffsetsIndex & index = built[ii];
+    index.Cells = this->GetCellArray(static_cast<CellArrayIndex>(ii));
+    index.Offsets = CellOffsetsContainer::New();
+    if (index.Cells)
+    {
+      index.CellsMTime = index.Cells->GetMTime();
+      malformed[ii] = !BuildCellOffsets(index.Cells->CastToSTLConstContainer(), index.Offsets->CastToSTLContainer());
+    }
+    else
+    {
+      index.Offsets->push_back(0);
+    }
+  };
+  if (numberOfStaleArrays == 1)
+  {
+    for (unsigned int ii = 0; ii < NumberOfCellArrays; ++ii)
+    {
+      buildOffsets(ii);
+    }
+  }
+  else
+  {
+    MultiThreaderBase::New()->ParallelizeArray(0, NumberOfCellArrays, buildOffsets, nullptr);
+  }
+
+  const char * const cellArrayNames[NumberOfCellArrays] = { "vertices", "lines", "polygons", "triangle strips" };
+  for (unsigned int ii = 0; ii < NumberOfCellArrays; ++ii)
+  {
+    if (malformed[ii])
+    {
+      itkExceptionMacro("A cell of the " << cellArrayNames[ii] << " extends past the end of its cell array");
+    }
+  }
+  for (unsigned int ii = 0; ii < NumberOfCellArrays; ++ii)
+  {
+    if (stale[ii])
+    {
+      m_CellOffsets[ii] = std::move(built[ii]);
+    }
+  }
+  return m_CellOffsets[cellArray].Offsets.GetPointer();
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetVertexOffsets() const -> const CellOffsetsContainer *
+{
+  return this->GetCellOffsets(VerticesArray);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetLineOffsets() const -> const CellOffsetsContainer *
+{
+  return this->GetCellOffsets(LinesArray);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPolygonOffsets() const -> const CellOffsetsContainer *
+{
+  return this->GetCellOffsets(PolygonsArray);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetTriangleStripOffsets() const -> const CellOffsetsContainer *
+{
+  return this->GetCellOffsets(TriangleStripsArray);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+SizeValueType
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetNumberOfVertices() const
+{
+  return this->GetCellOffsets(VerticesArray)->Size() - 1;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+SizeValueType
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetNumberOfLines() const
+{
+  return this->GetCellOffsets(LinesArray)->Size() - 1;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+SizeValueType
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetNumberOfPolygons() const
+{
+  return this->GetCellOffsets(PolygonsArray)->Size() - 1;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+SizeValueType
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetNumberOfTriangleStrips() const
+{
+  return this->GetCellOffsets(TriangleStripsArray)->Size() - 1;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellPointIdsInArray(CellArrayIndex cellArray, SizeValueType id) const
+  -> CellPointIdsType
+{
+  const std::vector<SizeValueType> & offsets = this->GetCellOffsets(cellArray)->CastToSTLConstContainer();
+  if (id + 1 >= offsets.size())
+  {
+    itkExceptionMacro("Cell " << id << " is out of range, its cell array has " << offsets.size() - 1 << " cells");
+  }
+  const CellIndexType * cell = this->GetCellArray(cellArray)->CastToSTLConstContainer().data() + offsets[id];
+  return CellPointIdsType(cell + 1, offsets[id + 1] - offsets[id] - 1);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetVertex(SizeValueType id) const -> CellPointIdsType
+{
+  return this->GetCellPointIdsInArray(VerticesArray, id);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetLine(SizeValueType id) const -> CellPointIdsType
+{
+  return this->GetCellPointIdsInArray(LinesArray, id);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPolygon(SizeValueType id) const -> CellPointIdsType
+{
+  return this->GetCellPointIdsInArray(PolygonsArray, id);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetTriangleStrip(SizeValueType id) const -> CellPointIdsType
+{
+  return this->GetCellPointIdsInArray(TriangleStripsArray, id);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellPointIds(CellIdentifier cellId) const -> CellPointIdsType
+{
+  SizeValueType id = cellId;
+  for (unsigned int ii = 0; ii < NumberOfCellArrays; ++ii)
+  {
+    const auto          cellArray = static_cast<CellArrayIndex>(ii);
+    const SizeValueType numberOfCells = this->GetCellOffsets(cellArray)->Size() - 1;
+    if (id < numberOfCells)
+    {
+      return this->GetCellPointIdsInArray(cellArray, id);
+    }
+    id -= numberOfCells;
+  }
+  itkExceptionMacro("Cell " << cellId << " is out of range, the PolyData has " << cellId - id << " cells");
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+template <typename TContainer>
+void
+PolyData<TPixelType, TCellPixel, TCellIndex>::PrepareContainerForWrite(SmartPointer<TContainer> & container,
+                                                                       const Object *             cachedReference)
+{
+  if (!m_CopyOnWrite || !container)
+  {
+    return;
+  }
+  const int numberOfOwnReferences = cachedReference == container.GetPointer() ? 2 : 1;
+  if (container->GetReferenceCount() > numberOfOwnReferences)
+  {
+    itkDebugMacro("copying shared container " << container);
+    const SmartPointer<TContainer> copy = TContainer::New();
+    copy->CastToSTLContainer() = container->CastToSTLConstContainer();
+    container = copy;
+  }
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+template <typename TComponent>
+void
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetAttributeArray(AttributeArrayMapType &          arrays,
+                                                                const std::string &              name,
+                                                                AttributeArrayType<TComponent> * values,
+                                                                unsigned int                     numberOfComponents)
+{
+  static_assert(GetAttributeComponentType<TComponent>() != IOComponentEnum::UNKNOWNCOMPONENTTYPE,
+                "The components of attribute arrays must be of an arithmetic type");
+  if (values == nullptr)
+  {
+    if (arrays.erase(name) > 0)
+    {
+      this->Modified();
+    }
+    return;
+  }
+  if (numberOfComponents == 0)
+  {
+    itkExceptionMacro("The attribute array " << name << " must have at least one component");
+  }
+  AttributeArray & array = arrays[name];
+  array.Values = values;
+  array.ComponentType = GetAttributeComponentType<TComponent>();
+  array.NumberOfComponents = numberOfComponents;
+  array.GetValues = [](const Object * container, SizeValueType & numberOfValues) -> const void * {
+    const auto * typedContainer = static_cast<const AttributeArrayType<TComponent> *>(container);
+    numberOfValues = typedContainer->Size();
+    return typedContainer->CastToSTLConstContainer().data();
+  };
+  this->Modified();
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+template <typename TComponent>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetAttributeArray(AttributeArrayMapType & arrays,
+                                                                const std::string &     name)
+  -> AttributeArrayType<TComponent> *
+{
+  const auto found = arrays.find(name);
+  if (found == arrays.end())
+  {
+    return nullptr;
+  }
+  auto * values = dynamic_cast<AttributeArrayType<TComponent> *>(found->second.Values.GetPointer());
+  if (values && m_CopyOnWrite && values->GetReferenceCount() > 1)
+  {
+    itkDebugMacro("copying shared attribute array " << name);
+    const auto copy = AttributeArrayType<TComponent>::New();
+    copy->CastToSTLContainer() = values->CastToSTLConstContainer();
+    found->second.Values = copy;
+    values = copy.GetPointer();
+  }
+  return values;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+template <typename TComponent>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetConstAttributeArray(const AttributeArrayMapType & arrays,
+                                                                     const std::string &           name)
+  -> const AttributeArrayType<TComponent> *
+{
+  const AttributeArray * array = FindAttributeArray(arrays, name);
+  return array ? dynamic_cast<const AttributeArrayType<TComponent> *>(array->Values.GetPointer()) : nullptr;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetAttributeArrayNames(const AttributeArrayMapType & arrays)
+  -> AttributeArrayNamesType
+{
+  AttributeArrayNamesType names;
+  names.reserve(arrays.size());
+  for (const auto & array : arrays)
+  {
+    names.push_back(array.first);
+  }
+  return names;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::FindAttributeArray(const AttributeArrayMapType & arrays,
+                                                                 const std::string &           name)
+  -> const AttributeArray *
+{
+  const auto found = arrays.find(name);
+  return found == arrays.end() ? nullptr : &found->second;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+const void *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetAttributeArrayValues(const AttributeArrayMapType & arrays,
+                                                                      const std::string &           name,
+                                                                      SizeValueType &               numberOfValues)
+{
+  numberOfValues = 0;
+  const AttributeArray * array = FindAttributeArray(arrays, name);
+  return array ? array->GetValues(array->Values.GetPointer(), numberOfValues) : nullptr;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+template <typename TComponent>
+void
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetPointDataArray(const std::string &              name,
+                                                                AttributeArrayType<TComponent> * values,
+                                                                unsigned int                     numberOfComponents)
+{
+  this->SetAttributeArray(m_PointDataArrays, name, values, numberOfComponents);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+template <typename TComponent>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPointDataArray(const std::string & name)
+  -> AttributeArrayType<TComponent> *
+{
+  return this->template GetAttributeArray<TComponent>(m_PointDataArrays, name);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+template <typename TComponent>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPointDataArray(const std::string & name) const
+  -> const AttributeArrayType<TComponent> *
+{
+  return GetConstAttributeArray<TComponent>(m_PointDataArrays, name);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+void
+PolyData<TPixelType, TCellPixel, TCellIndex>::RemovePointDataArray(const std::string & name)
+{
+  if (m_PointDataArrays.erase(name) > 0)
+  {
+    this->Modified();
+  }
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPointDataArrayNames() const -> AttributeArrayNamesType
+{
+  return GetAttributeArrayNames(m_PointDataArrays);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+unsigned int
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPointDataArrayNumberOfComponents(const std::string & name) const
+{
+  const AttributeArray * array = FindAttributeArray(m_PointDataArrays, name);
+  return array ? array->NumberOfComponents : 0;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+IOComponentEnum
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPointDataArrayComponentType(const std::string & name) const
+{
+  const AttributeArray * array = FindAttributeArray(m_PointDataArrays, name);
+  return array ? array->ComponentType : IOComponentEnum::UNKNOWNCOMPONENTTYPE;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+const void *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetPointDataArrayValues(const std::string & name,
+                                                                      SizeValueType &     numberOfValues) const
+{
+  return GetAttributeArrayValues(m_PointDataArrays, name, numberOfValues);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+template <typename TComponent>
+void
+PolyData<TPixelType, TCellPixel, TCellIndex>::SetCellDataArray(const std::string &              name,
+                                                               AttributeArrayType<TComponent> * values,
+                                                               unsigned int                     numberOfComponents)
+{
+  this->SetAttributeArray(m_CellDataArrays, name, values, numberOfComponents);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+template <typename TComponent>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellDataArray(const std::string & name)
+  -> AttributeArrayType<TComponent> *
+{
+  return this->template GetAttributeArray<TComponent>(m_CellDataArrays, name);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+template <typename TComponent>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellDataArray(const std::string & name) const
+  -> const AttributeArrayType<TComponent> *
+{
+  return GetConstAttributeArray<TComponent>(m_CellDataArrays, name);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+void
+PolyData<TPixelType, TCellPixel, TCellIndex>::RemoveCellDataArray(const std::string & name)
+{
+  if (m_CellDataArrays.erase(name) > 0)
+  {
+    this->Modified();
+  }
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+auto
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellDataArrayNames() const -> AttributeArrayNamesType
+{
+  return GetAttributeArrayNames(m_CellDataArrays);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+unsigned int
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellDataArrayNumberOfComponents(const std::string & name) const
+{
+  const AttributeArray * array = FindAttributeArray(m_CellDataArrays, name);
+  return array ? array->NumberOfComponents : 0;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+IOComponentEnum
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellDataArrayComponentType(const std::string & name) const
+{
+  const AttributeArray * array = FindAttributeArray(m_CellDataArrays, name);
+  return array ? array->ComponentType : IOComponentEnum::UNKNOWNCOMPONENTTYPE;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+const void *
+PolyData<TPixelType, TCellPixel, TCellIndex>::GetCellDataArrayValues(const std::string & name,
+                                                                     SizeValueType &     numberOfValues) const
+{
+  return GetAttributeArrayValues(m_CellDataArrays, name, numberOfValues);
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+template <typename TContainer, typename TPixelId, typename TComponent>
+unsigned int
+PolyData<TPixelType, TCellPixel, TCellIndex>::FlattenPixels(const TContainer *        container,
+                                                            SizeValueType             count,
+                                                            TPixelId &&               pixelId,
+                                                            std::vector<TComponent> & components,
+                                                            MultiThreaderBase *       multiThreader,
+                                                            SizeValueType             numberOfWorkUnits)
+{
+  using ContainerPixelType = typename TContainer::Element;
+  using ConvertPixelTraits = DefaultConvertPixelTraits<ContainerPixelType>;
+
+  if (count == 0)
+  {
+    components.clear();
+    return 0;
+  }
+  const unsigned int numberOfComponents =
+    NumericTraits<ContainerPixelType>::GetLength(container->ElementAt(pixelId(SizeValueType{ 0 })));
+  components.resize(count * numberOfComponents);
+  TComponent * const flatComponents = components.data();
+
+  const SizeValueType numberOfBlocks = std::max<SizeValueType>(1, std::min(numberOfWorkUnits, count));
+  const SizeValueType pixelsPerBlock = (count + numberOfBlocks - 1) / numberOfBlocks;
+  std::atomic<bool>   lengthMismatch{ false };
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      const SizeValueType last = std::min(count, (block + 1) * pixelsPerBlock);
+      for (SizeValueType ii = block * pixelsPerBlock; ii < last; ++ii)
+      {
+        const ContainerPixelType & pixel = container->ElementAt(pixelId(ii));
+        if (NumericTraits<ContainerPixelType>::GetLength(pixel) != numberOfComponents)
+        {
+          lengthMismatch = true;
+          return;
+        }
+        TComponent * pixelComponents = flatComponents + ii * numberOfComponents;
+        for (unsigned int component = 0; component < numberOfComponents; ++component)
+        {
+          pixelComponents[component] = static_cast<TComponent>(ConvertPixelTraits::GetNthComponent(component, pixel));
+        }
+      }
+    },
+    nullptr);
+  if (lengthMismatch)
+  {
+    itkGenericExceptionMacro("The pixels of the " << container->GetNameOfClass()
+                                                  << " do not all have the same number of components");
+  }
+  return numberOfComponents;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+void
+PolyData<TPixelType, TCellPixel, TCellIndex>::Graft(const DataObject * data)
+{
+  if (data == nullptr)
+  {
+    return;
+  }
+  Superclass::Graft(data);
+
+  const auto * polyData = dynamic_cast<const Self *>(data);
+  if (polyData == nullptr)
+  {
+    itkExceptionMacro("itk::PolyData::Graft() cannot cast " << typeid(data).name() << " to "
+                                                            << typeid(const Self *).name());
+  }
+  this->SetPoints(polyData->m_PointsContainer);
+  this->SetVertices(polyData->m_VerticesContainer);
+  this->SetLines(polyData->m_LinesContainer);
+  this->SetPolygons(polyData->m_PolygonsContainer);
+  this->SetTriangleStrips(polyData->m_TriangleStripsContainer);
+  this->SetPointData(polyData->m_PointDataContainer);
+  this->SetCellData(polyData->m_CellDataContainer);
+  this->SetPointDataBuffer(polyData->m_PointDataBuffer, polyData->m_NumberOfPointDataComponents);
+  this->SetCellDataBuffer(polyData->m_CellDataBuffer, polyData->m_NumberOfCellDataComponents);
+  m_PointDataArrays = polyData->m_PointDataArrays;
+  m_CellDataArrays = polyData->m_CellDataArrays;
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
+void
+PolyData<TPixelType, TCellPixel, TCellIndex>::CopyInformation(const DataObject * data)
+{
+  if (data == nullptr)
+  {
+    return;
+  }
+  Superclass::CopyInformation(data);
+
+  if (dynamic_cast<const Self *>(data) == nullptr)
+  {
+    itkExceptionMacro("itk::PolyData::CopyInformation() cannot cast " << typeid(data).name() << " to "
+                                                                      << typeid(const Self *).name());
+  }
+}
+
+
+template <typename TPixelType, typename TCellPixel, typename TCellIndex>
 void
-PolyData<TPixelType, TCellPixel>::Initialize()
+PolyData<TPixelType, TCellPixel, TCellIndex>::Initialize()
 {
   Superclass::Initialize();
 
   m_PointsContainer = nullptr;
   m_PointDataContainer = nullptr;
   m_CellDataContainer = nullptr;
+  m_PointDataBuffer = nullptr;
+  m_NumberOfPointDataComponents = 0;
+  m_CellDataBuffer = nullptr;
+  m_NumberOfCellDataComponents = 0;
+  m_PointDataArrays.clear();
+  m_CellDataArrays.clear();
+  m_BoundsPoints = nullptr;
 }
 
 } // end namespace itk
@@ -0,0 +1,91 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataAppendFilter_h
+#define itkPolyDataAppendFilter_h
+
+#include "itkPolyDataToPolyDataFilter.h"
+
+namespace itk
+{
+/** \class PolyDataAppendFilter
+ *
+ * \brief Append the points, cells, point data and cell data of several
+ * PolyData into one
+ *
+ * The points of the output are those of the inputs, in input order. Each
+ * cell array of the output holds the cells of that array of every input, in
+ * input order, with their point ids offset by the number of points of the
+ * previous inputs. The cell data follows the cell order of the output:
+ * the vertices of every input, then their lines, polygons and triangle
+ * strips. Inputs that are not set are skipped.
+ *
+ * The size of every output container is computed first, and each container
+ * is allocated once. The inputs are then copied in parallel, in blocks of
+ * points and of cells, so that one large input is copied by several work
+ * units.
+ *
+ * The point data container is carried along when every input that has
+ * points has one, and the point data buffer when they all have one with
+ * the same number of components. The same holds for the cell data and the
+ * inputs that have cells. The named attribute arrays are not carried along.
+ *
+ * \ingroup MeshToPolyData
+ */
+template <typename TPolyData>
+class ITK_TEMPLATE_EXPORT PolyDataAppendFilter : public PolyDataToPolyDataFilter<TPolyData>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolyDataAppendFilter);
+
+  /** Standard class typedefs. */
+  using Self = PolyDataAppendFilter<TPolyData>;
+  using Superclass = PolyDataToPolyDataFilter<TPolyData>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Standard New macro. */
+  itkNewMacro(Self);
+
+  /** Run-time type information. */
+  itkOverrideGetNameOfClassMacro(PolyDataAppendFilter);
+
+  using PolyDataType = TPolyData;
+
+  /** Set the input of index idx. */
+  using Superclass::SetInput;
+  void
+  SetInput(unsigned int idx, const PolyDataType * input);
+
+  /** Add an input after the last one. */
+  void
+  AddInput(const PolyDataType * input);
+
+protected:
+  PolyDataAppendFilter() = default;
+  ~PolyDataAppendFilter() override = default;
+
+  void
+  GenerateData() override;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolyDataAppendFilter.hxx"
+#endif
+
+#endif // itkPolyDataAppendFilter_h
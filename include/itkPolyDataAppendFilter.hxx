@@ -0,0 +1,330 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataAppendFilter_hxx
+#define itkPolyDataAppendFilter_hxx
+
+#include "itkPolyDataAppendFilter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace itk
+{
+
+template <typename TPolyData>
+void
+PolyDataAppendFilter<TPolyData>::SetInput(unsigned int idx, const PolyDataType * input)
+{
+  // Process object is not const-correct so the const_cast is required here
+  this->ProcessObject::SetNthInput(idx, const_cast<PolyDataType *>(input));
+}
+
+
+template <typename TPolyData>
+void
+PolyDataAppendFilter<TPolyData>::AddInput(const PolyDataType * input)
+{
+  this->ProcessObject::PushBackInput(input);
+}
+
+
+template <typename TPolyData>
+void
+PolyDataAppendFilter<TPolyData>::GenerateData()
+{
+  using CellIndexType = typename PolyDataType::CellIndexType;
+  using CellsContainer = typename PolyDataType::CellsContainer;
+
+  // Vertices, lines, polygons and triangle strips, in the order of the
+  // cell data
+  constexpr unsigned int NumberOfCellArrays = 4;
+
+  // Where the points, cells and cell array values of an input go in the
+  // output
+  struct InputLayout
+  {
+    unsigned int                       Index;
+    const PolyDataType *               Input;
+    const CellsContainer *             Cells[NumberOfCellArrays];
+    const std::vector<SizeValueType> * CellOffsets[NumberOfCellArrays];
+    SizeValueType                      NumberOfPoints;
+    SizeValueType                      NumberOfCells;
+    SizeValueType                      PointOffset;
+    SizeValueType                      InputCellOffsets[NumberOfCellArrays];
+    SizeValueType                      OutputCellOffsets[NumberOfCellArrays];
+    SizeValueType                      ValueOffsets[NumberOfCellArrays];
+  };
+
+  std::vector<InputLayout> layouts;
+  SizeValueType            numberOfPoints = 0;
+  SizeValueType            numberOfCells[NumberOfCellArrays] = {};
+  SizeValueType            numberOfValues[NumberOfCellArrays] = {};
+  for (unsigned int idx = 0; idx < this->GetNumberOfIndexedInputs(); ++idx)
+  {
+    const PolyDataType * input = this->GetInput(idx);
+    if (!input)
+    {
+      continue;
+    }
+    InputLayout layout;
+    layout.Index = idx;
+    layout.Input = input;
+    layout.NumberOfPoints = input->GetNumberOfPoints();
+    layout.NumberOfCells = 0;
+    layout.PointOffset = numberOfPoints;
+    numberOfPoints += layout.NumberOfPoints;
+
+    const CellsContainer * cells[NumberOfCellArrays] = {
+      input->GetVertices(), input->GetLines(), input->GetPolygons(), input->GetTriangleStrips()
+    };
+    const typename PolyDataType::CellOffsetsContainer * cellOffsets[NumberOfCellArrays] = {
+      input->GetVertexOffsets(), input->GetLineOffsets(), input->GetPolygonOffsets(), input->GetTriangleStripOffsets()
+    };
+    for (unsigned int cellArray = 0; cellArray < NumberOfCellArrays; ++cellArray)
+    {
+      const std::vector<SizeValueType> & offsets = cellOffsets[cellArray]->CastToSTLConstContainer();
+      layout.Cells[cellArray] = cells[cellArray];
+      layout.CellOffsets[cellArray] = &offsets;
+      layout.InputCellOffsets[cellArray] = layout.NumberOfCells;
+      layout.OutputCellOffsets[cellArray] = numberOfCells[cellArray];
+      layout.ValueOffsets[cellArray] = numberOfValues[cellArray];
+      layout.NumberOfCells += offsets.size() - 1;
+      numberOfCells[cellArray] += offsets.size() - 1;
+      numberOfValues[cellArray] += offsets.back();
+    }
+    layouts.push_back(layout);
+  }
+  if (!PolyDataType::CanIndex(numberOfPoints))
+  {
+    itkExceptionMacro("The " << numberOfPoints << " appended points cannot be indexed by the "
+                             << sizeof(CellIndexType) * 8 << "-bit cell arrays of the output PolyData");
+  }
+
+  // The cells of each cell array follow those of the previous arrays in the
+  // cell data
+  SizeValueType firstCells[NumberOfCellArrays];
+  SizeValueType totalNumberOfCells = 0;
+  for (unsigned int cellArray = 0; cellArray < NumberOfCellArrays; ++cellArray)
+  {
+    firstCells[cellArray] = totalNumberOfCells;
+    totalNumberOfCells += numberOfCells[cellArray];
+  }
+
+  // Number of components of a data array carried along, or 0 when an input
+  // with points, or cells, does not have it with the same number of
+  // components as the others
+  const auto carriedComponents = [&layouts](bool cellData, const auto & numberOfComponents) {
+    unsigned int carried = 0;
+    for (const InputLayout & layout : layouts)
+    {
+      if ((cellData ? layout.NumberOfCells : layout.NumberOfPoints) == 0)
+      {
+        continue;
+      }
+      const unsigned int components = numberOfComponents(*layout.Input);
+      if (components == 0 || (carried != 0 && components != carried))
+      {
+        return 0u;
+      }
+      carried = components;
+    }
+    return carried;
+  };
+  const bool carryPointData =
+    carriedComponents(false, [](const PolyDataType & input) { return input.GetPointData() ? 1u : 0u; }) > 0;
+  const unsigned int pointDataComponents = carriedComponents(false, [](const PolyDataType & input) {
+    return input.GetPointDataBuffer() ? input.GetNumberOfPointDataComponents() : 0u;
+  });
+  const bool carryCellData =
+    carriedComponents(true, [](const PolyDataType & input) { return input.GetCellData() ? 1u : 0u; }) > 0;
+  const unsigned int cellDataComponents = carriedComponents(true, [](const PolyDataType & input) {
+    return input.GetCellDataBuffer() ? input.GetNumberOfCellDataComponents() : 0u;
+  });
+  for (const InputLayout & layout : layouts)
+  {
+    const PolyDataType * input = layout.Input;
+    const SizeValueType  pointDataSize = layout.NumberOfPoints * pointDataComponents;
+    const SizeValueType  cellDataSize = layout.NumberOfCells * cellDataComponents;
+    if (layout.NumberOfPoints > 0 &&
+        ((carryPointData && input->GetPointData()->Size() != layout.NumberOfPoints) ||
+         (pointDataComponents > 0 && input->GetPointDataBuffer()->Size() != pointDataSize)))
+    {
+      itkExceptionMacro("The point data of input " << layout.Index << " does not have one value per point");
+    }
+    if (layout.NumberOfCells > 0 &&
+        ((carryCellData && input->GetCellData()->Size() != layout.NumberOfCells) ||
+         (cellDataComponents > 0 && input->GetCellDataBuffer()->Size() != cellDataSize)))
+    {
+      itkExceptionMacro("The cell data of input " << layout.Index << " does not have one value per cell");
+    }
+  }
+
+  // Every output container is allocated to its final size
+  auto points = PolyDataType::PointsContainer::New();
+  points->CastToSTLContainer().resize(numberOfPoints);
+  typename CellsContainer::Pointer outputCells[NumberOfCellArrays];
+  for (unsigned int cellArray = 0; cellArray < NumberOfCellArrays; ++cellArray)
+  {
+    outputCells[cellArray] = CellsContainer::New();
+    outputCells[cellArray]->CastToSTLContainer().resize(numberOfValues[cellArray]);
+  }
+  typename PolyDataType::PointDataContainer::Pointer  pointData;
+  typename PolyDataType::PointDataBufferType::Pointer pointDataBuffer;
+  typename PolyDataType::CellDataContainer::Pointer   cellData;
+  typename PolyDataType::CellDataBufferType::Pointer  cellDataBuffer;
+  if (carryPointData)
+  {
+    pointData = PolyDataType::PointDataContainer::New();
+    pointData->CastToSTLContainer().resize(numberOfPoints);
+  }
+  if (pointDataComponents > 0)
+  {
+    pointDataBuffer = PolyDataType::PointDataBufferType::New();
+    pointDataBuffer->CastToSTLContainer().resize(numberOfPoints * pointDataComponents);
+  }
+  if (carryCellData)
+  {
+    cellData = PolyDataType::CellDataContainer::New();
+    cellData->CastToSTLContainer().resize(totalNumberOfCells);
+  }
+  if (cellDataComponents > 0)
+  {
+    cellDataBuffer = PolyDataType::CellDataBufferType::New();
+    cellDataBuffer->CastToSTLContainer().resize(totalNumberOfCells * cellDataComponents);
+  }
+
+  // Each task copies a block of the points or of the cells of a cell array
+  // of an input, with their point data or cell data
+  constexpr SizeValueType            BlockSize = 1 << 16;
+  std::vector<std::function<void()>> tasks;
+  const auto addBlocks = [&tasks](SizeValueType count, const std::function<void(SizeValueType, SizeValueType)> & copy) {
+    for (SizeValueType first = 0; first < count; first += BlockSize)
+    {
+      const SizeValueType last = std::min(count, first + BlockSize);
+      tasks.emplace_back([copy, first, last]() { copy(first, last); });
+    }
+  };
+  const auto copyTuples = [](const auto *  input,
+                             SizeValueType inputFirst,
+                             auto *        output,
+                             SizeValueType outputFirst,
+                             SizeValueType count,
+                             unsigned int  numberOfComponents) {
+    if (input && output)
+    {
+      std::copy_n(input->CastToSTLConstContainer().data() + inputFirst * numberOfComponents,
+                  count * numberOfComponents,
+                  output->CastToSTLContainer().data() + outputFirst * numberOfComponents);
+    }
+  };
+
+  std::atomic<bool> invalidPointId{ false };
+  for (size_t ii = 0; ii < layouts.size(); ++ii)
+  {
+    addBlocks(layouts[ii].NumberOfPoints, [&, ii](SizeValueType first, SizeValueType last) {
+      const InputLayout & layout = layouts[ii];
+      const auto &        inputPoints = layout.Input->GetPoints()->CastToSTLConstContainer();
+      std::copy(inputPoints.begin() + first,
+                inputPoints.begin() + last,
+                points->CastToSTLContainer().begin() + layout.PointOffset + first);
+      copyTuples(
+        layout.Input->GetPointData(), first, pointData.GetPointer(), layout.PointOffset + first, last - first, 1);
+      copyTuples(layout.Input->GetPointDataBuffer(),
+                 first,
+                 pointDataBuffer.GetPointer(),
+                 layout.PointOffset + first,
+                 last - first,
+                 pointDataComponents);
+    });
+
+    for (unsigned int cellArray = 0; cellArray < NumberOfCellArrays; ++cellArray)
+    {
+      const SizeValueType numberOfInputCells = layouts[ii].CellOffsets[cellArray]->size() - 1;
+      addBlocks(numberOfInputCells, [&, ii, cellArray](SizeValueType first, SizeValueType last) {
+        const InputLayout &                layout = layouts[ii];
+        const std::vector<SizeValueType> & offsets = *layout.CellOffsets[cellArray];
+        const CellIndexType *              source = layout.Cells[cellArray]->CastToSTLConstContainer().data();
+        CellIndexType *                    destination =
+          outputCells[cellArray]->CastToSTLContainer().data() + layout.ValueOffsets[cellArray];
+        const auto pointOffset = static_cast<CellIndexType>(layout.PointOffset);
+        for (SizeValueType position = offsets[first]; position < offsets[last]; position += source[position] + 1)
+        {
+          const SizeValueType count = source[position];
+          destination[position] = source[position];
+          for (SizeValueType jj = position + 1; jj <= position + count; ++jj)
+          {
+            if (source[jj] >= layout.NumberOfPoints)
+            {
+              invalidPointId = true;
+              return;
+            }
+            destination[jj] = static_cast<CellIndexType>(source[jj] + pointOffset);
+          }
+        }
+
+        const SizeValueType inputCell = layout.InputCellOffsets[cellArray] + first;
+        const SizeValueType outputCell = firstCells[cellArray] + layout.OutputCellOffsets[cellArray] + first;
+        copyTuples(layout.Input->GetCellData(), inputCell, cellData.GetPointer(), outputCell, last - first, 1);
+        copyTuples(layout.Input->GetCellDataBuffer(),
+                   inputCell,
+                   cellDataBuffer.GetPointer(),
+                   outputCell,
+                   last - first,
+                   cellDataComponents);
+      });
+    }
+  }
+  if (!tasks.empty())
+  {
+    this->GetMultiThreader()->ParallelizeArray(
+      0, tasks.size(), [&tasks](SizeValueType task) { tasks[task](); }, nullptr);
+  }
+  if (invalidPointId)
+  {
+    itkExceptionMacro("The cells of the inputs use points that are not in their input PolyData");
+  }
+
+  PolyDataType * output = this->GetOutput();
+  output->SetPoints(points);
+  output->SetVertices(outputCells[0]);
+  output->SetLines(outputCells[1]);
+  output->SetPolygons(outputCells[2]);
+  output->SetTriangleStrips(outputCells[3]);
+  if (carryPointData)
+  {
+    output->SetPointData(pointData);
+  }
+  if (pointDataComponents > 0)
+  {
+    output->SetPointDataBuffer(pointDataBuffer, pointDataComponents);
+  }
+  if (carryCellData)
+  {
+    output->SetCellData(cellData);
+  }
+  if (cellDataComponents > 0)
+  {
+    output->SetCellDataBuffer(cellDataBuffer, cellDataComponents);
+  }
+}
+
+} // end namespace itk
+
+#endif // itkPolyDataAppendFilter_hxx
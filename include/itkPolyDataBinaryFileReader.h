@@ -0,0 +1,105 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataBinaryFileReader_h
+#define itkPolyDataBinaryFileReader_h
+
+#include "itkPolyDataBinaryFileWriter.h"
+
+namespace itk
+{
+
+/** \class PolyDataBinaryFileReader
+ *
+ * \brief Read a PolyData written by PolyDataBinaryFileWriter
+ *
+ * Each array of the file is read with a single copy, straight into the
+ * container of the output PolyData, in chunks of BytesPerChunk bytes that
+ * are read in parallel. The component types of the arrays must match those
+ * of the output PolyData: no conversion is done. The point data and cell
+ * data of the output are stored as flat buffers of components, see
+ * PolyData::SetPointDataBuffer(), and the named arrays with the component
+ * type they were written with, see PolyData::SetPointDataArray().
+ *
+ * An exception is thrown when the file is truncated, its header malformed,
+ * or its component types differ from those of the output PolyData. The
+ * point ids of the cell arrays are not checked, to keep loading bound by
+ * the file system.
+ *
+ * \sa PolyDataBinaryFileWriter
+ *
+ * \ingroup MeshToPolyData
+ */
+template <typename TPolyData>
+class ITK_TEMPLATE_EXPORT PolyDataBinaryFileReader : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolyDataBinaryFileReader);
+
+  /** Standard class typedefs. */
+  using Self = PolyDataBinaryFileReader;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(PolyDataBinaryFileReader);
+
+  using PolyDataType = TPolyData;
+  using WriterType = PolyDataBinaryFileWriter<PolyDataType>;
+
+  /** Number of bytes read by each work unit at a time. */
+  static constexpr SizeValueType BytesPerChunk = 1 << 24;
+
+  /** Name of the file to read. */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+
+  /** Threader used to read the chunks in parallel. */
+  itkSetObjectMacro(MultiThreader, MultiThreaderBase);
+  itkGetModifiableObjectMacro(MultiThreader, MultiThreaderBase);
+
+  /** Read the file into the output PolyData. */
+  void
+  Read();
+
+  /** PolyData produced by the last call to Read(). */
+  itkGetModifiableObjectMacro(Output, PolyDataType);
+
+protected:
+  PolyDataBinaryFileReader();
+  ~PolyDataBinaryFileReader() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  std::string                    m_FileName;
+  MultiThreaderBase::Pointer     m_MultiThreader;
+  typename PolyDataType::Pointer m_Output;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolyDataBinaryFileReader.hxx"
+#endif
+
+#endif // itkPolyDataBinaryFileReader_h
@@ -0,0 +1,389 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataBinaryFileReader_hxx
+#define itkPolyDataBinaryFileReader_hxx
+
+#include "itkPolyDataBinaryFileReader.h"
+#include "itkByteSwapper.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+template <typename TUnsigned>
+TUnsigned
+GetPolyDataBinaryFileValue(const uint8_t * position)
+{
+  TUnsigned value = 0;
+  for (unsigned int byte = 0; byte < sizeof(TUnsigned); ++byte)
+  {
+    value |= static_cast<TUnsigned>(position[byte]) << (8 * byte);
+  }
+  return value;
+}
+
+
+// Allocate a container for the values of record, and return its storage
+template <typename TContainer>
+typename TContainer::Pointer
+AllocatePolyDataBinaryFileContainer(const PolyDataBinaryFileRecord & record, itk::SizeValueType valuesPerElement)
+{
+  auto container = TContainer::New();
+  container->resize(record.NumberOfValues / valuesPerElement);
+  return container;
+}
+
+
+// Whether the counts of the cells, in the [n p0 p1 ...] layout, stay within
+// the array and their point ids are below numberOfPoints
+template <typename TElement>
+bool
+IsValidPolyDataBinaryFileCellArray(const std::vector<TElement> & cells, itk::SizeValueType numberOfPoints)
+{
+  itk::SizeValueType position = 0;
+  while (position < cells.size())
+  {
+    const auto count = static_cast<itk::SizeValueType>(cells[position]);
+    if (count >= cells.size() - position)
+    {
+      return false;
+    }
+    const itk::SizeValueType end = position + count + 1;
+    for (++position; position < end; ++position)
+    {
+      if (cells[position] >= numberOfPoints)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // end anonymous namespace
+
+namespace itk
+{
+
+template <typename TPolyData>
+PolyDataBinaryFileReader<TPolyData>::PolyDataBinaryFileReader()
+  : m_MultiThreader(MultiThreaderBase::New())
+{}
+
+
+template <typename TPolyData>
+void
+PolyDataBinaryFileReader<TPolyData>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "MultiThreader: " << m_MultiThreader.GetPointer() << std::endl;
+  os << indent << "Output: " << m_Output.GetPointer() << std::endl;
+}
+
+
+template <typename TPolyData>
+void
+PolyDataBinaryFileReader<TPolyData>::Read()
+{
+  using CoordinateType = typename PolyDataType::CoordinateType;
+  using CellIndexType = typename PolyDataType::CellIndexType;
+  using PixelComponentType = typename PolyDataType::PixelComponentType;
+  using CellPixelComponentType = typename PolyDataType::CellPixelComponentType;
+  using PointsContainer = typename PolyDataType::PointsContainer;
+  using CellsContainer = typename PolyDataType::CellsContainer;
+  using PointDataBufferType = typename PolyDataType::PointDataBufferType;
+  using CellDataBufferType = typename PolyDataType::CellDataBufferType;
+  constexpr unsigned int PointDimension = PolyDataType::PointDimension;
+  constexpr unsigned int NumberOfArrays = WriterType::NumberOfArrays;
+  static_assert(sizeof(typename PolyDataType::PointType) == PointDimension * sizeof(CoordinateType),
+                "The points must be stored as packed coordinates");
+
+  if (m_FileName.empty())
+  {
+    itkExceptionMacro("FileName is not set");
+  }
+  std::ifstream stream(m_FileName, std::ios::in | std::ios::binary);
+  if (!stream)
+  {
+    itkExceptionMacro("Cannot open " << m_FileName << " for reading");
+  }
+  stream.seekg(0, std::ios::end);
+  const auto fileSize = static_cast<uint64_t>(stream.tellg());
+  stream.seekg(0, std::ios::beg);
+
+  std::vector<uint8_t> header(WriterType::HeaderSize);
+  if (fileSize < header.size() || !stream.read(reinterpret_cast<char *>(header.data()), header.size()) ||
+      GetPolyDataBinaryFileValue<uint32_t>(&header[0]) != WriterType::Magic)
+  {
+    itkExceptionMacro("The file " << m_FileName << " is not a PolyData binary file");
+  }
+  if (header[4] != WriterType::Version)
+  {
+    itkExceptionMacro("Unsupported PolyData binary file version " << static_cast<unsigned int>(header[4]));
+  }
+  const uint32_t numberOfFileArrays = GetPolyDataBinaryFileValue<uint32_t>(&header[8]);
+  if (numberOfFileArrays < NumberOfArrays || numberOfFileArrays > (fileSize - header.size()) / WriterType::RecordSize)
+  {
+    itkExceptionMacro("The file " << m_FileName << " has a malformed header");
+  }
+  header.resize(WriterType::HeaderSize + numberOfFileArrays * WriterType::RecordSize);
+  if (!stream.read(reinterpret_cast<char *>(header.data() + WriterType::HeaderSize),
+                   header.size() - WriterType::HeaderSize))
+  {
+    itkExceptionMacro("The file " << m_FileName << " has a malformed header");
+  }
+
+  const char * const arrayNames[] = { "points",     "vertices",        "lines",     "polygons",
+                                      "triangle strips", "point data", "cell data" };
+
+  const uint8_t expectedKinds[] = { WriterType::template GetComponentKind<CoordinateType>(),
+                                    WriterType::template GetComponentKind<CellIndexType>(),
+                                    WriterType::template GetComponentKind<CellIndexType>(),
+                                    WriterType::template GetComponentKind<CellIndexType>(),
+                                    WriterType::template GetComponentKind<CellIndexType>(),
+                                    WriterType::template GetComponentKind<PixelComponentType>(),
+                                    WriterType::template GetComponentKind<CellPixelComponentType>() };
+
+  const uint8_t expectedSizes[] = { sizeof(CoordinateType), sizeof(CellIndexType),      sizeof(CellIndexType),
+                                    sizeof(CellIndexType),  sizeof(CellIndexType),      sizeof(PixelComponentType),
+                                    sizeof(CellPixelComponentType) };
+
+  // The names of the named arrays follow the records
+  std::vector<PolyDataBinaryFileRecord> records(numberOfFileArrays);
+  std::vector<std::string>              namedArrayNames(numberOfFileArrays - NumberOfArrays);
+  uint64_t                              dataBegin = header.size();
+  for (unsigned int array = 0; array < numberOfFileArrays; ++array)
+  {
+    const uint8_t *            position = &header[WriterType::HeaderSize + array * WriterType::RecordSize];
+    PolyDataBinaryFileRecord & record = records[array];
+    record.Offset = GetPolyDataBinaryFileValue<uint64_t>(position);
+    record.NumberOfValues = GetPolyDataBinaryFileValue<uint64_t>(position + 8);
+    record.NumberOfComponents = GetPolyDataBinaryFileValue<uint32_t>(position + 16);
+    record.ComponentKind = position[20];
+    record.ComponentSize = position[21];
+    record.Association = position[22];
+    record.NameSize = GetPolyDataBinaryFileValue<uint32_t>(position + 24);
+    if (array >= NumberOfArrays)
+    {
+      if ((record.Association != WriterType::PointAttribute && record.Association != WriterType::CellAttribute) ||
+          record.NameSize > fileSize - dataBegin)
+      {
+        itkExceptionMacro("The file " << m_FileName << " has a malformed header");
+      }
+      namedArrayNames[array - NumberOfArrays].resize(record.NameSize);
+      dataBegin += record.NameSize;
+    }
+  }
+  for (std::string & name : namedArrayNames)
+  {
+    if (!stream.read(&name[0], name.size()))
+    {
+      itkExceptionMacro("The file " << m_FileName << " has a malformed header");
+    }
+  }
+
+  // Component type of each named array, from the kind and size of its
+  // components
+  std::vector<IOComponentEnum> namedArrayComponentTypes;
+  for (unsigned int array = NumberOfArrays; array < numberOfFileArrays; ++array)
+  {
+    const uint8_t kind = records[array].ComponentKind;
+    namedArrayComponentTypes.push_back(PolyDataType::GetAttributeComponentType(
+      kind == WriterType::FloatComponent, kind == WriterType::SignedIntegerComponent, records[array].ComponentSize));
+    if (kind > WriterType::FloatComponent ||
+        namedArrayComponentTypes.back() == IOComponentEnum::UNKNOWNCOMPONENTTYPE)
+    {
+      itkExceptionMacro("The attribute array " << namedArrayNames[array - NumberOfArrays] << " of " << m_FileName
+                                               << " has an unknown component type");
+    }
+  }
+  for (unsigned int array = 0; array < numberOfFileArrays; ++array)
+  {
+    const PolyDataBinaryFileRecord & record = records[array];
+    if (record.NumberOfValues == 0)
+    {
+      continue;
+    }
+    const std::string name = array < NumberOfArrays
+                               ? std::string(arrayNames[array])
+                               : "values of the attribute array " + namedArrayNames[array - NumberOfArrays];
+    if (array < NumberOfArrays &&
+        (record.ComponentKind != expectedKinds[array] || record.ComponentSize != expectedSizes[array]))
+    {
+      itkExceptionMacro("The " << name << " of " << m_FileName
+                               << " are not stored with the component type of the output PolyData");
+    }
+    // The points are read as packed coordinates and the cell arrays as
+    // single values, which their records must describe
+    if ((array == WriterType::PointsArray && record.NumberOfComponents != PointDimension) ||
+        (array >= WriterType::VerticesArray && array < WriterType::VerticesArray + 4 &&
+         record.NumberOfComponents != 1))
+    {
+      itkExceptionMacro("The " << name << " of " << m_FileName << " have " << record.NumberOfComponents
+                               << " components per value");
+    }
+    if (record.NumberOfComponents == 0 || record.NumberOfValues % record.NumberOfComponents != 0 ||
+        record.Offset % WriterType::ArrayAlignment != 0 || record.Offset < dataBegin || record.Offset > fileSize ||
+        record.NumberOfValues > (fileSize - record.Offset) / record.ComponentSize)
+    {
+      itkExceptionMacro("The " << name << " of " << m_FileName << " are truncated or malformed");
+    }
+  }
+
+  // Read into a new PolyData so that the output is left unchanged on error
+  typename PolyDataType::Pointer output = PolyDataType::New();
+  std::vector<char *>            destinations(numberOfFileArrays, nullptr);
+
+  const auto points =
+    AllocatePolyDataBinaryFileContainer<PointsContainer>(records[WriterType::PointsArray], PointDimension);
+
+  const SizeValueType numberOfPoints = points->Size();
+  if (!PolyDataType::CanIndex(numberOfPoints))
+  {
+    itkExceptionMacro("The " << numberOfPoints << " points of " << m_FileName << " cannot be indexed by the cell "
+                             << "arrays of the output PolyData");
+  }
+  destinations[WriterType::PointsArray] = reinterpret_cast<char *>(points->CastToSTLContainer().data());
+  output->SetPoints(points);
+
+  typename CellsContainer::Pointer cellArrays[4];
+  for (unsigned int cellArray = 0; cellArray < 4; ++cellArray)
+  {
+    cellArrays[cellArray] =
+      AllocatePolyDataBinaryFileContainer<CellsContainer>(records[WriterType::VerticesArray + cellArray], 1);
+    destinations[WriterType::VerticesArray + cellArray] =
+      reinterpret_cast<char *>(cellArrays[cellArray]->CastToSTLContainer().data());
+  }
+  output->SetVertices(cellArrays[0]);
+  output->SetLines(cellArrays[1]);
+  output->SetPolygons(cellArrays[2]);
+  output->SetTriangleStrips(cellArrays[3]);
+
+  typename PointDataBufferType::Pointer pointData;
+  if (records[WriterType::PointDataArray].NumberOfValues > 0)
+  {
+    pointData = AllocatePolyDataBinaryFileContainer<PointDataBufferType>(records[WriterType::PointDataArray], 1);
+    destinations[WriterType::PointDataArray] = reinterpret_cast<char *>(pointData->CastToSTLContainer().data());
+    output->SetPointDataBuffer(pointData, records[WriterType::PointDataArray].NumberOfComponents);
+  }
+  typename CellDataBufferType::Pointer cellData;
+  if (records[WriterType::CellDataArray].NumberOfValues > 0)
+  {
+    cellData = AllocatePolyDataBinaryFileContainer<CellDataBufferType>(records[WriterType::CellDataArray], 1);
+    destinations[WriterType::CellDataArray] = reinterpret_cast<char *>(cellData->CastToSTLContainer().data());
+    output->SetCellDataBuffer(cellData, records[WriterType::CellDataArray].NumberOfComponents);
+  }
+
+  for (unsigned int array = NumberOfArrays; array < numberOfFileArrays; ++array)
+  {
+    const PolyDataBinaryFileRecord & record = records[array];
+    const std::string &              name = namedArrayNames[array - NumberOfArrays];
+    const unsigned int               numberOfComponents = std::max<uint32_t>(record.NumberOfComponents, 1);
+    PolyDataType::CallWithAttributeComponentType(namedArrayComponentTypes[array - NumberOfArrays], [&](auto zero) {
+      using ArrayType = typename PolyDataType::template AttributeArrayType<decltype(zero)>;
+      const auto values = AllocatePolyDataBinaryFileContainer<ArrayType>(record, 1);
+      destinations[array] = reinterpret_cast<char *>(values->CastToSTLContainer().data());
+      if (record.Association == WriterType::PointAttribute)
+      {
+        output->SetPointDataArray(name, values.GetPointer(), numberOfComponents);
+      }
+      else
+      {
+        output->SetCellDataArray(name, values.GetPointer(), numberOfComponents);
+      }
+    });
+  }
+
+  // Split the arrays into chunks, each read by a work unit with its own
+  // stream
+  struct Chunk
+  {
+    unsigned int Array;
+    uint64_t     Begin;
+    uint64_t     End;
+  };
+  std::vector<Chunk> chunks;
+  for (unsigned int array = 0; array < numberOfFileArrays; ++array)
+  {
+    const uint64_t numberOfBytes = records[array].NumberOfValues * records[array].ComponentSize;
+    for (uint64_t begin = 0; begin < numberOfBytes; begin += BytesPerChunk)
+    {
+      chunks.push_back({ array, begin, std::min<uint64_t>(begin + BytesPerChunk, numberOfBytes) });
+    }
+  }
+  std::atomic<bool> readFailed{ false };
+  m_MultiThreader->ParallelizeArray(
+    0,
+    chunks.size(),
+    [&](SizeValueType chunkIndex) {
+      const Chunk & chunk = chunks[chunkIndex];
+      std::ifstream chunkStream(m_FileName, std::ios::in | std::ios::binary);
+      chunkStream.seekg(records[chunk.Array].Offset + chunk.Begin);
+      if (!chunkStream.read(destinations[chunk.Array] + chunk.Begin, chunk.End - chunk.Begin))
+      {
+        readFailed = true;
+      }
+    },
+    nullptr);
+  if (readFailed)
+  {
+    itkExceptionMacro("Failed to read " << m_FileName);
+  }
+
+  ByteSwapper<CoordinateType>::SwapRangeFromSystemToLittleEndian(
+    reinterpret_cast<CoordinateType *>(destinations[WriterType::PointsArray]),
+    records[WriterType::PointsArray].NumberOfValues);
+  for (unsigned int cellArray = 0; cellArray < 4; ++cellArray)
+  {
+    ByteSwapper<CellIndexType>::SwapRangeFromSystemToLittleEndian(cellArrays[cellArray]->CastToSTLContainer().data(),
+                                                                  cellArrays[cellArray]->Size());
+    if (!IsValidPolyDataBinaryFileCellArray(cellArrays[cellArray]->CastToSTLConstContainer(), numberOfPoints))
+    {
+      itkExceptionMacro("The " << arrayNames[WriterType::VerticesArray + cellArray] << " of " << m_FileName
+                               << " have cells that overrun the array or use points the file does not have");
+    }
+  }
+  if (pointData)
+  {
+    ByteSwapper<PixelComponentType>::SwapRangeFromSystemToLittleEndian(pointData->CastToSTLContainer().data(),
+                                                                       pointData->Size());
+  }
+  if (cellData)
+  {
+    ByteSwapper<CellPixelComponentType>::SwapRangeFromSystemToLittleEndian(cellData->CastToSTLContainer().data(),
+                                                                           cellData->Size());
+  }
+  for (unsigned int array = NumberOfArrays; array < numberOfFileArrays; ++array)
+  {
+    PolyDataType::CallWithAttributeComponentType(namedArrayComponentTypes[array - NumberOfArrays], [&](auto zero) {
+      ByteSwapper<decltype(zero)>::SwapRangeFromSystemToLittleEndian(
+        reinterpret_cast<decltype(zero) *>(destinations[array]), records[array].NumberOfValues);
+    });
+  }
+
+  m_Output = output;
+  this->Modified();
+}
+
+} // end namespace itk
+
+#endif // itkPolyDataBinaryFileReader_hxx
@@ -0,0 +1,161 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataBinaryFileWriter_h
+#define itkPolyDataBinaryFileWriter_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkMultiThreaderBase.h"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace itk
+{
+
+/** \class PolyDataBinaryFileWriter
+ *
+ * \brief Write a PolyData to a binary file that loads without conversion
+ *
+ * The file holds the raw contents of the points, the four cell arrays, the
+ * point data and the cell data of the PolyData, so that
+ * PolyDataBinaryFileReader reads them directly into the containers of its
+ * output. The layout, in little-endian byte order, is:
+ *
+ * - a header of HeaderSize bytes: the magic "IPDB" as a uint32, the
+ *   Version as a uint8, three reserved bytes, the number of arrays as a
+ *   uint32 and four reserved bytes;
+ * - a record of RecordSize bytes per array, in the order of ArrayIndex
+ *   followed by the named attribute arrays: the offset of its values in the
+ *   file and their number as uint64, the number of components of each tuple
+ *   as a uint32, the kind and size in bytes of the components as uint8,
+ *   PointAttribute or CellAttribute for a named array as a uint8, a
+ *   reserved byte, the size in bytes of the name of a named array as a
+ *   uint32, and four reserved bytes;
+ * - the names of the named arrays, in the order of their records;
+ * - the values of each array, starting at an offset that is a multiple of
+ *   ArrayAlignment.
+ *
+ * Empty arrays have an offset and a number of values of zero. Point data
+ * and cell data stored as containers of pixels are written as flat buffers
+ * of components, see PolyData::SetPointDataBuffer(). The named point data
+ * and cell data arrays, see PolyData::SetPointDataArray(), are written with
+ * their own component type, which must be at most 8 bytes wide.
+ *
+ * \sa PolyDataBinaryFileReader
+ *
+ * \ingroup MeshToPolyData
+ */
+template <typename TPolyData>
+class ITK_TEMPLATE_EXPORT PolyDataBinaryFileWriter : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolyDataBinaryFileWriter);
+
+  /** Standard class typedefs. */
+  using Self = PolyDataBinaryFileWriter;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(PolyDataBinaryFileWriter);
+
+  using PolyDataType = TPolyData;
+
+  /** First four bytes of the file, "IPDB". */
+  static constexpr uint32_t Magic = 0x42445049;
+
+  /** Version of the file layout. */
+  static constexpr uint8_t Version = 1;
+
+  /** Arrays of the file, in the order of their records. */
+  enum ArrayIndex : unsigned int
+  {
+    PointsArray,
+    VerticesArray,
+    LinesArray,
+    PolygonsArray,
+    TriangleStripsArray,
+    PointDataArray,
+    CellDataArray,
+    NumberOfArrays
+  };
+
+  /** Whether a named array is attached to the points or to the cells. */
+  static constexpr uint8_t PointAttribute = 1;
+  static constexpr uint8_t CellAttribute = 2;
+
+  /** Kinds of array components. */
+  static constexpr uint8_t UnsignedIntegerComponent = 0;
+  static constexpr uint8_t SignedIntegerComponent = 1;
+  static constexpr uint8_t FloatComponent = 2;
+
+  template <typename TComponent>
+  static constexpr uint8_t
+  GetComponentKind()
+  {
+    return std::is_floating_point<TComponent>::value ? FloatComponent
+           : std::is_signed<TComponent>::value      ? SignedIntegerComponent
+                                                    : UnsignedIntegerComponent;
+  }
+
+  static constexpr SizeValueType HeaderSize = 16;
+  static constexpr SizeValueType RecordSize = 32;
+  static constexpr SizeValueType ArrayAlignment = 64;
+
+  /** PolyData to write. */
+  itkSetConstObjectMacro(Input, PolyDataType);
+  itkGetConstObjectMacro(Input, PolyDataType);
+
+  /** Name of the file to write. */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+
+  /** Threader used to flatten the containers of pixels. */
+  itkSetObjectMacro(MultiThreader, MultiThreaderBase);
+  itkGetModifiableObjectMacro(MultiThreader, MultiThreaderBase);
+
+  /** Write the input PolyData to the file. */
+  void
+  Write();
+
+protected:
+  PolyDataBinaryFileWriter();
+  ~PolyDataBinaryFileWriter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  typename PolyDataType::ConstPointer m_Input;
+  std::string                         m_FileName;
+  MultiThreaderBase::Pointer          m_MultiThreader;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolyDataBinaryFileWriter.hxx"
+#endif
+
+#endif // itkPolyDataBinaryFileWriter_h
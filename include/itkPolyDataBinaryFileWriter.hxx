@@ -0,0 +1,320 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataBinaryFileWriter_hxx
+#define itkPolyDataBinaryFileWriter_hxx
+
+#include "itkPolyDataBinaryFileWriter.h"
+#include "itkByteSwapper.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Record of an array of a PolyData binary file
+struct PolyDataBinaryFileRecord
+{
+  uint64_t Offset{ 0 };
+  uint64_t NumberOfValues{ 0 };
+  uint32_t NumberOfComponents{ 0 };
+  uint8_t  ComponentKind{ 0 };
+  uint8_t  ComponentSize{ 0 };
+  uint8_t  Association{ 0 };
+  uint32_t NameSize{ 0 };
+};
+
+
+template <typename TUnsigned>
+void
+PutPolyDataBinaryFileValue(TUnsigned value, uint8_t * position)
+{
+  for (unsigned int byte = 0; byte < sizeof(TUnsigned); ++byte)
+  {
+    position[byte] = static_cast<uint8_t>(value >> (8 * byte));
+  }
+}
+
+
+// Write values in little-endian byte order, swapping a chunk at a time on
+// big-endian systems
+template <typename TComponent>
+void
+WritePolyDataBinaryFileValues(std::ostream & stream, const TComponent * values, itk::SizeValueType numberOfValues)
+{
+  if (!itk::ByteSwapper<TComponent>::SystemIsBigEndian())
+  {
+    stream.write(reinterpret_cast<const char *>(values), numberOfValues * sizeof(TComponent));
+    return;
+  }
+  constexpr itk::SizeValueType ValuesPerChunk = 1 << 16;
+  std::vector<TComponent>      chunk;
+  for (itk::SizeValueType begin = 0; begin < numberOfValues; begin += ValuesPerChunk)
+  {
+    const itk::SizeValueType end = std::min(begin + ValuesPerChunk, numberOfValues);
+    chunk.assign(values + begin, values + end);
+    itk::ByteSwapper<TComponent>::SwapRangeFromSystemToLittleEndian(chunk.data(), chunk.size());
+    stream.write(reinterpret_cast<const char *>(chunk.data()), chunk.size() * sizeof(TComponent));
+  }
+}
+
+
+// Components of the point data or cell data of a PolyData: its flat buffer
+// when set, else its container of pixels flattened into storage
+template <typename TPolyData, typename TBuffer, typename TContainer>
+const typename TBuffer::Element *
+GetPolyDataBinaryFileComponents(const TBuffer *                          buffer,
+                                unsigned int                             numberOfBufferComponents,
+                                const TContainer *                       container,
+                                std::vector<typename TBuffer::Element> & storage,
+                                PolyDataBinaryFileRecord &               record,
+                                itk::MultiThreaderBase *                 multiThreader)
+{
+  if (buffer && numberOfBufferComponents > 0)
+  {
+    record.NumberOfComponents = numberOfBufferComponents;
+    record.NumberOfValues = buffer->Size() - buffer->Size() % numberOfBufferComponents;
+    return buffer->CastToSTLConstContainer().data();
+  }
+  if (container == nullptr || container->Size() == 0)
+  {
+    return nullptr;
+  }
+
+  record.NumberOfComponents = TPolyData::FlattenPixels(container,
+                                                       container->Size(),
+                                                       [](itk::SizeValueType ii) { return ii; },
+                                                       storage,
+                                                       multiThreader,
+                                                       multiThreader->GetNumberOfWorkUnits());
+  record.NumberOfValues = storage.size();
+  return storage.data();
+}
+} // end anonymous namespace
+
+namespace itk
+{
+
+template <typename TPolyData>
+PolyDataBinaryFileWriter<TPolyData>::PolyDataBinaryFileWriter()
+  : m_MultiThreader(MultiThreaderBase::New())
+{}
+
+
+template <typename TPolyData>
+void
+PolyDataBinaryFileWriter<TPolyData>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Input: " << m_Input.GetPointer() << std::endl;
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "MultiThreader: " << m_MultiThreader.GetPointer() << std::endl;
+}
+
+
+template <typename TPolyData>
+void
+PolyDataBinaryFileWriter<TPolyData>::Write()
+{
+  using CoordinateType = typename PolyDataType::CoordinateType;
+  using CellIndexType = typename PolyDataType::CellIndexType;
+  using PixelComponentType = typename PolyDataType::PixelComponentType;
+  using CellPixelComponentType = typename PolyDataType::CellPixelComponentType;
+  constexpr unsigned int PointDimension = PolyDataType::PointDimension;
+  static_assert(sizeof(typename PolyDataType::PointType) == PointDimension * sizeof(CoordinateType),
+                "The points must be stored as packed coordinates");
+
+  const PolyDataType * input = m_Input.GetPointer();
+  if (input == nullptr)
+  {
+    itkExceptionMacro("Input is not set");
+  }
+  if (m_FileName.empty())
+  {
+    itkExceptionMacro("FileName is not set");
+  }
+
+  std::vector<PolyDataBinaryFileRecord> records(NumberOfArrays);
+
+  const typename PolyDataType::PointsContainer * points = input->GetPoints();
+  const CoordinateType *                         coordinates = nullptr;
+  if (points && points->Size() > 0)
+  {
+    coordinates = points->CastToSTLConstContainer().data()->GetDataPointer();
+    records[PointsArray].NumberOfValues = points->Size() * PointDimension;
+    records[PointsArray].NumberOfComponents = PointDimension;
+  }
+  records[PointsArray].ComponentKind = GetComponentKind<CoordinateType>();
+  records[PointsArray].ComponentSize = sizeof(CoordinateType);
+
+  const typename PolyDataType::CellsContainer * cellArrays[] = {
+    input->GetVertices(), input->GetLines(), input->GetPolygons(), input->GetTriangleStrips()
+  };
+  for (unsigned int cellArray = 0; cellArray < 4; ++cellArray)
+  {
+    PolyDataBinaryFileRecord & record = records[VerticesArray + cellArray];
+    if (cellArrays[cellArray] && cellArrays[cellArray]->Size() > 0)
+    {
+      record.NumberOfValues = cellArrays[cellArray]->Size();
+      record.NumberOfComponents = 1;
+    }
+    record.ComponentKind = GetComponentKind<CellIndexType>();
+    record.ComponentSize = sizeof(CellIndexType);
+  }
+
+  std::vector<PixelComponentType> pointDataStorage;
+  const PixelComponentType *      pointData =
+    GetPolyDataBinaryFileComponents<PolyDataType>(input->GetPointDataBuffer(),
+                                                  input->GetNumberOfPointDataComponents(),
+                                                  input->GetPointData(),
+                                                  pointDataStorage,
+                                                  records[PointDataArray],
+                                                  m_MultiThreader);
+  records[PointDataArray].ComponentKind = GetComponentKind<PixelComponentType>();
+  records[PointDataArray].ComponentSize = sizeof(PixelComponentType);
+
+  std::vector<CellPixelComponentType> cellDataStorage;
+  const CellPixelComponentType *      cellData =
+    GetPolyDataBinaryFileComponents<PolyDataType>(input->GetCellDataBuffer(),
+                                                  input->GetNumberOfCellDataComponents(),
+                                                  input->GetCellData(),
+                                                  cellDataStorage,
+                                                  records[CellDataArray],
+                                                  m_MultiThreader);
+  records[CellDataArray].ComponentKind = GetComponentKind<CellPixelComponentType>();
+  records[CellDataArray].ComponentSize = sizeof(CellPixelComponentType);
+
+  // The named arrays follow, with the type of their own components
+  std::vector<std::string>     arrayNames;
+  std::vector<IOComponentEnum> arrayComponentTypes;
+  std::vector<const void *>    arrayValues;
+  SizeValueType                namesSize = 0;
+  for (const uint8_t association : { PointAttribute, CellAttribute })
+  {
+    const bool isPointData = association == PointAttribute;
+    for (const std::string & name : isPointData ? input->GetPointDataArrayNames() : input->GetCellDataArrayNames())
+    {
+      PolyDataBinaryFileRecord record;
+      IOComponentEnum          componentType;
+      SizeValueType            numberOfValues = 0;
+      const void *             values;
+      if (isPointData)
+      {
+        componentType = input->GetPointDataArrayComponentType(name);
+        record.NumberOfComponents = input->GetPointDataArrayNumberOfComponents(name);
+        values = input->GetPointDataArrayValues(name, numberOfValues);
+      }
+      else
+      {
+        componentType = input->GetCellDataArrayComponentType(name);
+        record.NumberOfComponents = input->GetCellDataArrayNumberOfComponents(name);
+        values = input->GetCellDataArrayValues(name, numberOfValues);
+      }
+      PolyDataType::CallWithAttributeComponentType(componentType, [&record](auto zero) {
+        record.ComponentKind = GetComponentKind<decltype(zero)>();
+        record.ComponentSize = sizeof(zero);
+      });
+      if (record.ComponentSize == 0 || record.ComponentSize > sizeof(uint64_t))
+      {
+        itkExceptionMacro("The components of the attribute array " << name << " are too wide to be written");
+      }
+      record.NumberOfValues = numberOfValues - numberOfValues % record.NumberOfComponents;
+      record.Association = association;
+      record.NameSize = static_cast<uint32_t>(name.size());
+      records.push_back(record);
+      arrayNames.push_back(name);
+      arrayComponentTypes.push_back(componentType);
+      arrayValues.push_back(values);
+      namesSize += name.size();
+    }
+  }
+
+  const auto alignUp = [](uint64_t offset) { return (offset + ArrayAlignment - 1) / ArrayAlignment * ArrayAlignment; };
+  std::vector<uint8_t> header(alignUp(HeaderSize + records.size() * RecordSize + namesSize), 0);
+  PutPolyDataBinaryFileValue(Magic, &header[0]);
+  header[4] = Version;
+  PutPolyDataBinaryFileValue(static_cast<uint32_t>(records.size()), &header[8]);
+  uint64_t offset = header.size();
+  for (unsigned int array = 0; array < records.size(); ++array)
+  {
+    PolyDataBinaryFileRecord & record = records[array];
+    if (record.NumberOfValues > 0)
+    {
+      record.Offset = offset;
+      offset = alignUp(offset + record.NumberOfValues * record.ComponentSize);
+    }
+    uint8_t * position = &header[HeaderSize + array * RecordSize];
+    PutPolyDataBinaryFileValue(record.Offset, position);
+    PutPolyDataBinaryFileValue(record.NumberOfValues, position + 8);
+    PutPolyDataBinaryFileValue(record.NumberOfComponents, position + 16);
+    position[20] = record.ComponentKind;
+    position[21] = record.ComponentSize;
+    position[22] = record.Association;
+    PutPolyDataBinaryFileValue(record.NameSize, position + 24);
+  }
+  uint8_t * namePosition = &header[HeaderSize + records.size() * RecordSize];
+  for (const std::string & name : arrayNames)
+  {
+    std::copy(name.begin(), name.end(), namePosition);
+    namePosition += name.size();
+  }
+
+  std::ofstream stream(m_FileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!stream)
+  {
+    itkExceptionMacro("Cannot open " << m_FileName << " for writing");
+  }
+  stream.write(reinterpret_cast<const char *>(header.data()), header.size());
+  uint64_t   position = header.size();
+  const auto writeArray = [&](unsigned int array, const auto * values) {
+    const PolyDataBinaryFileRecord & record = records[array];
+    if (record.NumberOfValues == 0)
+    {
+      return;
+    }
+    const std::vector<char> padding(record.Offset - position, 0);
+    stream.write(padding.data(), padding.size());
+    WritePolyDataBinaryFileValues(stream, values, record.NumberOfValues);
+    position = record.Offset + record.NumberOfValues * record.ComponentSize;
+  };
+  writeArray(PointsArray, coordinates);
+  for (unsigned int cellArray = 0; cellArray < 4; ++cellArray)
+  {
+    writeArray(VerticesArray + cellArray,
+               cellArrays[cellArray] ? cellArrays[cellArray]->CastToSTLConstContainer().data() : nullptr);
+  }
+  writeArray(PointDataArray, pointData);
+  writeArray(CellDataArray, cellData);
+  for (unsigned int namedArray = 0; namedArray < arrayNames.size(); ++namedArray)
+  {
+    PolyDataType::CallWithAttributeComponentType(arrayComponentTypes[namedArray], [&](auto zero) {
+      writeArray(NumberOfArrays + namedArray, static_cast<const decltype(zero) *>(arrayValues[namedArray]));
+    });
+  }
+
+  stream.close();
+  if (stream.fail())
+  {
+    itkExceptionMacro("Failed to write " << m_FileName);
+  }
+}
+
+} // end namespace itk
+
+#endif // itkPolyDataBinaryFileWriter_hxx
@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataDecoder_h
+#define itkPolyDataDecoder_h
+
+#include "itkPolyDataEncoder.h"
+
+namespace itk
+{
+
+/** \class PolyDataDecoder
+ *
+ * \brief Decode a PolyData encoded by PolyDataEncoder
+ *
+ * The blocks of each varint stream are decoded in parallel. The point data
+ * and cell data of the output are stored as flat buffers of components,
+ * see PolyData::SetPointDataBuffer(), and the named arrays with the kind
+ * and size of components they were encoded with, see
+ * PolyData::SetPointDataArray(). An exception is thrown when the encoded
+ * data are truncated or malformed.
+ *
+ * \sa PolyDataEncoder
+ *
+ * \ingroup MeshToPolyData
+ */
+template <typename TPolyData>
+class ITK_TEMPLATE_EXPORT PolyDataDecoder : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolyDataDecoder);
+
+  /** Standard class typedefs. */
+  using Self = PolyDataDecoder;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(PolyDataDecoder);
+
+  using PolyDataType = TPolyData;
+  using EncoderType = PolyDataEncoder<PolyDataType>;
+  using EncodedDataType = typename EncoderType::EncodedDataType;
+
+  /** Data to decode. They are not copied and must outlive the call to
+   * Decode(). */
+  void
+  SetEncodedData(const uint8_t * data, SizeValueType size);
+  void
+  SetEncodedData(const EncodedDataType & data)
+  {
+    this->SetEncodedData(data.data(), data.size());
+  }
+
+  /** Threader used to decode the blocks in parallel. */
+  itkSetObjectMacro(MultiThreader, MultiThreaderBase);
+  itkGetModifiableObjectMacro(MultiThreader, MultiThreaderBase);
+
+  /** Decode the encoded data into the output PolyData. */
+  void
+  Decode();
+
+  /** PolyData produced by the last call to Decode(). */
+  itkGetModifiableObjectMacro(Output, PolyDataType);
+
+protected:
+  PolyDataDecoder();
+  ~PolyDataDecoder() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  const uint8_t *                m_EncodedData{ nullptr };
+  SizeValueType                  m_EncodedDataSize{ 0 };
+  MultiThreaderBase::Pointer     m_MultiThreader;
+  typename PolyDataType::Pointer m_Output;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolyDataDecoder.hxx"
+#endif
+
+#endif // itkPolyDataDecoder_h
@@ -0,0 +1,531 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataDecoder_hxx
+#define itkPolyDataDecoder_hxx
+
+#include "itkPolyDataDecoder.h"
+#include "itkByteSwapper.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+// Read one varint from [position, end). Returns false when it is truncated
+// or longer than 64 bits.
+inline bool
+DecodeVarint(const uint8_t *& position, const uint8_t * end, uint64_t & value)
+{
+  value = 0;
+  for (unsigned int shift = 0; shift < 64 && position != end; shift += 7)
+  {
+    const uint8_t byte = *position++;
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+inline uint64_t
+ZigZagDecode(uint64_t value)
+{
+  return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+
+class EncodedDataReader
+{
+public:
+  EncodedDataReader(const uint8_t * begin, const uint8_t * end)
+    : m_Position(begin)
+    , m_End(end)
+  {}
+
+  itk::SizeValueType
+  GetNumberOfRemainingBytes() const
+  {
+    return static_cast<itk::SizeValueType>(m_End - m_Position);
+  }
+
+  const uint8_t *
+  ReadBytes(itk::SizeValueType count)
+  {
+    if (count > this->GetNumberOfRemainingBytes())
+    {
+      itkGenericExceptionMacro("The encoded PolyData is truncated");
+    }
+    const uint8_t * bytes = m_Position;
+    m_Position += count;
+    return bytes;
+  }
+
+  uint64_t
+  ReadVarint()
+  {
+    uint64_t value;
+    if (!DecodeVarint(m_Position, m_End, value))
+    {
+      itkGenericExceptionMacro("The encoded PolyData is truncated");
+    }
+    return value;
+  }
+
+  template <typename TUnsigned>
+  TUnsigned
+  ReadLittleEndian()
+  {
+    const uint8_t * bytes = this->ReadBytes(sizeof(TUnsigned));
+    TUnsigned       value = 0;
+    for (unsigned int byte = 0; byte < sizeof(TUnsigned); ++byte)
+    {
+      value |= static_cast<TUnsigned>(static_cast<TUnsigned>(bytes[byte]) << (8 * byte));
+    }
+    return value;
+  }
+
+  double
+  ReadFloat64()
+  {
+    const auto bits = this->ReadLittleEndian<uint64_t>();
+    double     value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+private:
+  const uint8_t * m_Position;
+  const uint8_t * m_End;
+};
+
+
+struct EncodedBlock
+{
+  itk::SizeValueType ValueBegin;
+  itk::SizeValueType ValueEnd;
+  const uint8_t *    Bytes;
+  itk::SizeValueType NumberOfBytes;
+};
+
+
+// Read the table of a block stream written by the encoder, and skip over
+// its blocks.
+inline std::vector<EncodedBlock>
+ReadEncodedBlocks(EncodedDataReader & reader)
+{
+  const uint64_t numberOfBlocks = reader.ReadVarint();
+  // Each block takes at least two bytes of the table
+  if (numberOfBlocks > reader.GetNumberOfRemainingBytes() / 2)
+  {
+    itkGenericExceptionMacro("The encoded PolyData is truncated");
+  }
+  std::vector<EncodedBlock> blocks(numberOfBlocks);
+  itk::SizeValueType        valueBegin = 0;
+  for (auto & block : blocks)
+  {
+    const uint64_t numberOfValues = reader.ReadVarint();
+    block.NumberOfBytes = reader.ReadVarint();
+    // Each value takes at least one byte
+    if (numberOfValues > block.NumberOfBytes || block.NumberOfBytes > reader.GetNumberOfRemainingBytes())
+    {
+      itkGenericExceptionMacro("The encoded PolyData is malformed");
+    }
+    block.ValueBegin = valueBegin;
+    valueBegin += numberOfValues;
+    block.ValueEnd = valueBegin;
+  }
+  for (auto & block : blocks)
+  {
+    block.Bytes = reader.ReadBytes(block.NumberOfBytes);
+  }
+  return blocks;
+}
+
+
+template <typename TPointsContainer>
+typename TPointsContainer::Pointer
+DecodePositions(EncodedDataReader & reader, itk::SizeValueType valuesPerBlock, itk::MultiThreaderBase * multiThreader)
+{
+  constexpr unsigned int Dimension = 3;
+  constexpr double       MaximumQuantizedValue = 65535.0;
+  using PointType = typename TPointsContainer::Element;
+  using CoordinateType = typename PointType::ValueType;
+
+  auto           points = TPointsContainer::New();
+  const uint64_t numberOfPoints = reader.ReadVarint();
+  if (numberOfPoints == 0)
+  {
+    return points;
+  }
+  double origin[Dimension];
+  double spacing[Dimension];
+  for (unsigned int dim = 0; dim < Dimension; ++dim)
+  {
+    origin[dim] = reader.ReadFloat64();
+    spacing[dim] = reader.ReadFloat64() / MaximumQuantizedValue;
+  }
+  if (numberOfPoints > reader.GetNumberOfRemainingBytes() / (Dimension * sizeof(uint16_t)))
+  {
+    itkGenericExceptionMacro("The encoded PolyData is truncated");
+  }
+  const uint8_t * quantized = reader.ReadBytes(numberOfPoints * Dimension * sizeof(uint16_t));
+
+  points->resize(numberOfPoints);
+  PointType *              pointsData = points->CastToSTLContainer().data();
+  const itk::SizeValueType numberOfBlocks = (numberOfPoints + valuesPerBlock - 1) / valuesPerBlock;
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](itk::SizeValueType block) {
+      const itk::SizeValueType last = std::min<itk::SizeValueType>(numberOfPoints, (block + 1) * valuesPerBlock);
+      for (itk::SizeValueType ii = block * valuesPerBlock; ii < last; ++ii)
+      {
+        for (unsigned int dim = 0; dim < Dimension; ++dim)
+        {
+          const uint8_t * bytes = quantized + (ii * Dimension + dim) * sizeof(uint16_t);
+          const auto      value = static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+          pointsData[ii][dim] = static_cast<CoordinateType>(origin[dim] + value * spacing[dim]);
+        }
+      }
+    },
+    nullptr);
+  return points;
+}
+
+
+template <typename TCellsContainer>
+typename TCellsContainer::Pointer
+DecodeCellArray(EncodedDataReader & reader, itk::SizeValueType numberOfPoints, itk::MultiThreaderBase * multiThreader)
+{
+  using ElementType = typename TCellsContainer::Element;
+
+  const std::vector<EncodedBlock> blocks = ReadEncodedBlocks(reader);
+  auto                            cellArray = TCellsContainer::New();
+  cellArray->resize(blocks.empty() ? 0 : blocks.back().ValueEnd);
+  ElementType * cells = cellArray->CastToSTLContainer().data();
+
+  std::atomic<bool> malformed{ false };
+  multiThreader->ParallelizeArray(
+    0,
+    blocks.size(),
+    [&](itk::SizeValueType blockIndex) {
+      const EncodedBlock & block = blocks[blockIndex];
+      const uint8_t *      position = block.Bytes;
+      const uint8_t *      end = block.Bytes + block.NumberOfBytes;
+      uint64_t             previousId = 0;
+      for (itk::SizeValueType ii = block.ValueBegin; ii < block.ValueEnd;)
+      {
+        uint64_t numberOfCellPoints;
+        if (!DecodeVarint(position, end, numberOfCellPoints) || numberOfCellPoints > block.ValueEnd - ii - 1 ||
+            numberOfCellPoints >= std::numeric_limits<ElementType>::max())
+        {
+          malformed = true;
+          return;
+        }
+        cells[ii++] = static_cast<ElementType>(numberOfCellPoints);
+        for (uint64_t point = 0; point < numberOfCellPoints; ++point)
+        {
+          uint64_t delta;
+          if (!DecodeVarint(position, end, delta))
+          {
+            malformed = true;
+            return;
+          }
+          // Unsigned arithmetic wraps invalid ids out of range instead of overflowing
+          const uint64_t id = previousId + ZigZagDecode(delta);
+          if (id >= numberOfPoints)
+          {
+            malformed = true;
+            return;
+          }
+          cells[ii++] = static_cast<ElementType>(id);
+          previousId = id;
+        }
+      }
+      if (position != end)
+      {
+        malformed = true;
+      }
+    },
+    nullptr);
+  if (malformed)
+  {
+    itkGenericExceptionMacro("The encoded PolyData has a malformed cell array");
+  }
+  return cellArray;
+}
+
+
+template <typename TComponent>
+TComponent
+CastDecodedComponent(double value)
+{
+  if constexpr (std::is_integral<TComponent>::value)
+  {
+    value = std::round(value);
+    value = std::max(value, static_cast<double>(std::numeric_limits<TComponent>::lowest()));
+    value = std::min(value, static_cast<double>(std::numeric_limits<TComponent>::max()));
+  }
+  return static_cast<TComponent>(value);
+}
+
+
+// Decode the components of an attribute written by EncodeAttribute(). Returns
+// nullptr, with 0 components, when the attribute is absent.
+template <typename TBuffer>
+typename TBuffer::Pointer
+DecodeAttribute(EncodedDataReader & reader, unsigned int & numberOfComponents, itk::MultiThreaderBase * multiThreader)
+{
+  using ComponentType = typename TBuffer::Element;
+  constexpr uint8_t Lossless = 0;
+  constexpr uint8_t Quantized = 1;
+
+  const uint64_t encodedNumberOfComponents = reader.ReadVarint();
+  numberOfComponents = 0;
+  if (encodedNumberOfComponents == 0)
+  {
+    return nullptr;
+  }
+  const uint64_t numberOfTuples = reader.ReadVarint();
+  // Each value takes at least one byte
+  if (encodedNumberOfComponents > std::numeric_limits<unsigned int>::max() ||
+      numberOfTuples > reader.GetNumberOfRemainingBytes() / encodedNumberOfComponents)
+  {
+    itkGenericExceptionMacro("The encoded PolyData is truncated");
+  }
+  const itk::SizeValueType numberOfValues = numberOfTuples * encodedNumberOfComponents;
+  const auto               mode = reader.ReadLittleEndian<uint8_t>();
+
+  auto buffer = TBuffer::New();
+  buffer->resize(numberOfValues);
+  ComponentType * values = buffer->CastToSTLContainer().data();
+  if (mode == Lossless)
+  {
+    const uint8_t * bytes = reader.ReadBytes(numberOfValues * sizeof(ComponentType));
+    std::memcpy(values, bytes, numberOfValues * sizeof(ComponentType));
+    itk::ByteSwapper<ComponentType>::SwapRangeFromSystemToLittleEndian(values, numberOfValues);
+  }
+  else if (mode == Quantized)
+  {
+    std::vector<double> minimum(encodedNumberOfComponents);
+    for (auto & componentMinimum : minimum)
+    {
+      componentMinimum = reader.ReadFloat64();
+    }
+    const double                    step = reader.ReadFloat64();
+    const std::vector<EncodedBlock> blocks = ReadEncodedBlocks(reader);
+    if ((blocks.empty() ? 0 : blocks.back().ValueEnd) != numberOfValues)
+    {
+      itkGenericExceptionMacro("The encoded PolyData has a malformed attribute");
+    }
+    std::atomic<bool> malformed{ false };
+    multiThreader->ParallelizeArray(
+      0,
+      blocks.size(),
+      [&](itk::SizeValueType blockIndex) {
+        const EncodedBlock &  block = blocks[blockIndex];
+        const uint8_t *       position = block.Bytes;
+        const uint8_t *       end = block.Bytes + block.NumberOfBytes;
+        std::vector<uint64_t> previous(minimum.size(), 0);
+        for (itk::SizeValueType ii = block.ValueBegin; ii < block.ValueEnd; ++ii)
+        {
+          const itk::SizeValueType component = ii % minimum.size();
+          uint64_t                 delta;
+          if (!DecodeVarint(position, end, delta))
+          {
+            malformed = true;
+            return;
+          }
+          previous[component] += ZigZagDecode(delta);
+          values[ii] = CastDecodedComponent<ComponentType>(minimum[component] +
+                                                           static_cast<double>(previous[component]) * step);
+        }
+        if (position != end)
+        {
+          malformed = true;
+        }
+      },
+      nullptr);
+    if (malformed)
+    {
+      itkGenericExceptionMacro("The encoded PolyData has a malformed attribute");
+    }
+  }
+  else
+  {
+    itkGenericExceptionMacro("Unknown attribute encoding " << static_cast<unsigned int>(mode));
+  }
+  numberOfComponents = static_cast<unsigned int>(encodedNumberOfComponents);
+  return buffer;
+}
+
+
+// Decode the named arrays of the points, or of the cells, written by
+// EncodeAttributeArrays() into output.
+template <typename TPolyData>
+void
+DecodeAttributeArrays(EncodedDataReader &      reader,
+                      bool                     pointData,
+                      TPolyData *              output,
+                      itk::MultiThreaderBase * multiThreader)
+{
+  const uint64_t numberOfArrays = reader.ReadVarint();
+  // Each array takes at least four bytes
+  if (numberOfArrays > reader.GetNumberOfRemainingBytes() / 4)
+  {
+    itkGenericExceptionMacro("The encoded PolyData is truncated");
+  }
+  for (uint64_t array = 0; array < numberOfArrays; ++array)
+  {
+    const uint64_t nameSize = reader.ReadVarint();
+    if (nameSize > reader.GetNumberOfRemainingBytes())
+    {
+      itkGenericExceptionMacro("The encoded PolyData is truncated");
+    }
+    const auto *      nameBytes = reinterpret_cast<const char *>(reader.ReadBytes(nameSize));
+    const std::string name(nameBytes, nameBytes + nameSize);
+    const auto        kind = reader.ReadLittleEndian<uint8_t>();
+    const auto        size = reader.ReadLittleEndian<uint8_t>();
+    const auto        componentType = TPolyData::GetAttributeComponentType(kind == 2, kind == 1, size);
+    if (kind > 2 || componentType == itk::IOComponentEnum::UNKNOWNCOMPONENTTYPE)
+    {
+      itkGenericExceptionMacro("The attribute array " << name << " has an unknown component type");
+    }
+    TPolyData::CallWithAttributeComponentType(componentType, [&](auto zero) {
+      using ArrayType = typename TPolyData::template AttributeArrayType<decltype(zero)>;
+      unsigned int                numberOfComponents;
+      typename ArrayType::Pointer values = DecodeAttribute<ArrayType>(reader, numberOfComponents, multiThreader);
+      if (!values)
+      {
+        values = ArrayType::New();
+        numberOfComponents = 1;
+      }
+      if (pointData)
+      {
+        output->SetPointDataArray(name, values.GetPointer(), numberOfComponents);
+      }
+      else
+      {
+        output->SetCellDataArray(name, values.GetPointer(), numberOfComponents);
+      }
+    });
+  }
+}
+} // end anonymous namespace
+
+namespace itk
+{
+
+template <typename TPolyData>
+PolyDataDecoder<TPolyData>::PolyDataDecoder()
+  : m_MultiThreader(MultiThreaderBase::New())
+  , m_Output(PolyDataType::New())
+{}
+
+
+template <typename TPolyData>
+void
+PolyDataDecoder<TPolyData>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Encoded Data: " << static_cast<const void *>(m_EncodedData) << std::endl;
+  os << indent << "Size of Encoded Data: " << m_EncodedDataSize << std::endl;
+  os << indent << "MultiThreader: " << m_MultiThreader.GetPointer() << std::endl;
+  os << indent << "Output: " << m_Output.GetPointer() << std::endl;
+}
+
+
+template <typename TPolyData>
+void
+PolyDataDecoder<TPolyData>::SetEncodedData(const uint8_t * data, SizeValueType size)
+{
+  m_EncodedData = data;
+  m_EncodedDataSize = size;
+  this->Modified();
+}
+
+
+template <typename TPolyData>
+void
+PolyDataDecoder<TPolyData>::Decode()
+{
+  if (m_EncodedData == nullptr)
+  {
+    itkExceptionMacro("Encoded data are not set");
+  }
+  EncodedDataReader reader(m_EncodedData, m_EncodedData + m_EncodedDataSize);
+  if (m_EncodedDataSize < sizeof(uint32_t) || reader.ReadLittleEndian<uint32_t>() != EncoderType::Magic)
+  {
+    itkExceptionMacro("The data are not an encoded PolyData");
+  }
+  const auto version = reader.ReadLittleEndian<uint8_t>();
+  if (version != EncoderType::Version)
+  {
+    itkExceptionMacro("Unsupported encoded PolyData version " << static_cast<unsigned int>(version));
+  }
+  reader.ReadBytes(3);
+
+  // Decode into a new PolyData so that the output is left unchanged on error
+  typename PolyDataType::Pointer output = PolyDataType::New();
+
+  using PointsContainer = typename PolyDataType::PointsContainer;
+  using CellsContainer = typename PolyDataType::CellsContainer;
+  typename PointsContainer::Pointer points =
+    DecodePositions<PointsContainer>(reader, EncoderType::ValuesPerBlock, m_MultiThreader);
+  output->SetPoints(points);
+  const SizeValueType numberOfPoints = points->Size();
+  if (!PolyDataType::CanIndex(numberOfPoints))
+  {
+    itkExceptionMacro("The " << numberOfPoints << " encoded points cannot be indexed by the cell arrays of "
+                             << "the output PolyData");
+  }
+  output->SetVertices(DecodeCellArray<CellsContainer>(reader, numberOfPoints, m_MultiThreader));
+  output->SetLines(DecodeCellArray<CellsContainer>(reader, numberOfPoints, m_MultiThreader));
+  output->SetPolygons(DecodeCellArray<CellsContainer>(reader, numberOfPoints, m_MultiThreader));
+  output->SetTriangleStrips(DecodeCellArray<CellsContainer>(reader, numberOfPoints, m_MultiThreader));
+
+  unsigned int numberOfComponents;
+  const auto   pointData =
+    DecodeAttribute<typename PolyDataType::PointDataBufferType>(reader, numberOfComponents, m_MultiThreader);
+  output->SetPointDataBuffer(pointData, numberOfComponents);
+  const auto cellData =
+    DecodeAttribute<typename PolyDataType::CellDataBufferType>(reader, numberOfComponents, m_MultiThreader);
+  output->SetCellDataBuffer(cellData, numberOfComponents);
+  DecodeAttributeArrays(reader, true, output.GetPointer(), m_MultiThreader.GetPointer());
+  DecodeAttributeArrays(reader, false, output.GetPointer(), m_MultiThreader.GetPointer());
+
+  if (reader.GetNumberOfRemainingBytes() != 0)
+  {
+    itkExceptionMacro("Unexpected data after the encoded PolyData");
+  }
+  m_Output = output;
+  this->Modified();
+}
+
+} // end namespace itk
+
+#endif // itkPolyDataDecoder_hxx
@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataEncoder_h
+#define itkPolyDataEncoder_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkMultiThreaderBase.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+
+/** \class PolyDataEncoder
+ *
+ * \brief Encode a PolyData into a compact byte stream for transfer
+ *
+ * The points are quantized to 16 bits per coordinate in the frame of the
+ * bounding box of their finite coordinates, which is computed at each
+ * Encode(), so the error on each coordinate is at most the extent of the
+ * bounding box along its axis divided by 131070.
+ *
+ * The point ids of the vertices, lines, polygons and triangle strips are
+ * encoded as the zigzag varint of their difference with the previous point
+ * id, which takes one or two bytes per id on meshes with a coherent point
+ * order. The number of points of each cell is stored as a plain varint.
+ *
+ * The point data components are quantized to a multiple of twice the
+ * PointDataErrorBound, offset by the minimum of their component, and
+ * encoded as zigzag varints of their difference with the component of the
+ * previous point. With the default error bound of zero, or when the
+ * quantized values would not fit in 32 bits, the point data are stored
+ * losslessly. The cell data are always stored losslessly, as are the named
+ * point data and cell data arrays, see PolyData::SetPointDataArray(), which
+ * follow with the kind and size of their components.
+ *
+ * Varint streams are split into blocks of ValuesPerBlock values, cut at
+ * cell boundaries, that are encoded in parallel and can be decoded in
+ * parallel, see PolyDataDecoder. The block sizes do not depend on the
+ * number of threads, so the encoded data are identical for any number of
+ * work units. All values are stored in little-endian byte order.
+ *
+ * \sa PolyDataDecoder
+ *
+ * \ingroup MeshToPolyData
+ */
+template <typename TPolyData>
+class ITK_TEMPLATE_EXPORT PolyDataEncoder : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolyDataEncoder);
+
+  /** Standard class typedefs. */
+  using Self = PolyDataEncoder;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(PolyDataEncoder);
+
+  using PolyDataType = TPolyData;
+  using EncodedDataType = std::vector<uint8_t>;
+
+  /** First four bytes of the encoded data, "IPDQ". */
+  static constexpr uint32_t Magic = 0x51445049;
+
+  /** Version of the encoded data layout. */
+  static constexpr uint8_t Version = 1;
+
+  /** Number of values of each independently decodable block. */
+  static constexpr SizeValueType ValuesPerBlock = 1 << 16;
+
+  /** Number of bits of each quantized point coordinate. */
+  static constexpr unsigned int PositionBits = 16;
+
+  /** PolyData to encode. */
+  itkSetConstObjectMacro(Input, PolyDataType);
+  itkGetConstObjectMacro(Input, PolyDataType);
+
+  /** Largest absolute error allowed on each point data component. Zero, the
+   * default, stores the point data losslessly. */
+  itkSetMacro(PointDataErrorBound, double);
+  itkGetConstMacro(PointDataErrorBound, double);
+
+  /** Threader used to encode the blocks in parallel. */
+  itkSetObjectMacro(MultiThreader, MultiThreaderBase);
+  itkGetModifiableObjectMacro(MultiThreader, MultiThreaderBase);
+
+  /** Encode the input PolyData. */
+  void
+  Encode();
+
+  /** Data produced by the last call to Encode(). */
+  const EncodedDataType &
+  GetEncodedData() const
+  {
+    return m_EncodedData;
+  }
+
+protected:
+  PolyDataEncoder();
+  ~PolyDataEncoder() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  typename PolyDataType::ConstPointer m_Input;
+  double                              m_PointDataErrorBound{ 0.0 };
+  MultiThreaderBase::Pointer          m_MultiThreader;
+  EncodedDataType                     m_EncodedData;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolyDataEncoder.hxx"
+#endif
+
+#endif // itkPolyDataEncoder_h
@@ -0,0 +1,548 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataEncoder_hxx
+#define itkPolyDataEncoder_hxx
+
+#include "itkPolyDataEncoder.h"
+#include "itkByteSwapper.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace
+{
+inline uint64_t
+ZigZagEncode(int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+
+inline void
+WriteVarint(uint64_t value, std::vector<uint8_t> & output)
+{
+  while (value >= 0x80)
+  {
+    output.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<uint8_t>(value));
+}
+
+
+template <typename TUnsigned>
+void
+WriteLittleEndian(TUnsigned value, std::vector<uint8_t> & output)
+{
+  for (unsigned int byte = 0; byte < sizeof(TUnsigned); ++byte)
+  {
+    output.push_back(static_cast<uint8_t>(value >> (8 * byte)));
+  }
+}
+
+
+inline void
+WriteFloat64(double value, std::vector<uint8_t> & output)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  WriteLittleEndian(bits, output);
+}
+
+
+// Append values in little-endian byte order
+template <typename TComponent>
+void
+WriteRawComponents(const TComponent * values, itk::SizeValueType count, std::vector<uint8_t> & output)
+{
+  const itk::SizeValueType offset = output.size();
+  output.resize(offset + count * sizeof(TComponent));
+  std::vector<TComponent> swapped;
+  if (itk::ByteSwapper<TComponent>::SystemIsBigEndian())
+  {
+    swapped.assign(values, values + count);
+    itk::ByteSwapper<TComponent>::SwapRangeFromSystemToLittleEndian(swapped.data(), count);
+    values = swapped.data();
+  }
+  std::memcpy(output.data() + offset, values, count * sizeof(TComponent));
+}
+
+
+// Encode the blocks delimited by blockStarts in parallel, then append the
+// number of blocks, the number of values and of bytes of each block, and
+// the blocks themselves.
+template <typename TEncodeBlock>
+void
+WriteBlocks(const std::vector<itk::SizeValueType> & blockStarts,
+            TEncodeBlock &&                         encodeBlock,
+            std::vector<uint8_t> &                  output,
+            itk::MultiThreaderBase *                multiThreader)
+{
+  const itk::SizeValueType          numberOfBlocks = blockStarts.size() - 1;
+  std::vector<std::vector<uint8_t>> blocks(numberOfBlocks);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](itk::SizeValueType block) { encodeBlock(blockStarts[block], blockStarts[block + 1], blocks[block]); },
+    nullptr);
+
+  WriteVarint(numberOfBlocks, output);
+  itk::SizeValueType numberOfBytes = 0;
+  for (itk::SizeValueType block = 0; block < numberOfBlocks; ++block)
+  {
+    WriteVarint(blockStarts[block + 1] - blockStarts[block], output);
+    WriteVarint(blocks[block].size(), output);
+    numberOfBytes += blocks[block].size();
+  }
+  output.reserve(output.size() + numberOfBytes);
+  for (const auto & block : blocks)
+  {
+    output.insert(output.end(), block.begin(), block.end());
+  }
+}
+
+
+// Start of the blocks of a cell array, cut at the first cell boundary after
+// each valuesPerBlock values, followed by the size of the array. Returns an
+// empty vector when the counts of the cells overrun the array.
+template <typename TElement>
+std::vector<itk::SizeValueType>
+SplitCellArrayIntoBlocks(const TElement * cells, itk::SizeValueType size, itk::SizeValueType valuesPerBlock)
+{
+  std::vector<itk::SizeValueType> blockStarts{ 0 };
+  itk::SizeValueType              ii = 0;
+  while (ii < size)
+  {
+    if (ii - blockStarts.back() >= valuesPerBlock)
+    {
+      blockStarts.push_back(ii);
+    }
+    ii += static_cast<itk::SizeValueType>(cells[ii]) + 1;
+  }
+  if (ii != size)
+  {
+    return {};
+  }
+  if (size > 0)
+  {
+    blockStarts.push_back(size);
+  }
+  return blockStarts;
+}
+
+
+template <typename TCellsContainer>
+bool
+EncodeCellArray(const TCellsContainer *  cellArray,
+                itk::SizeValueType       valuesPerBlock,
+                std::vector<uint8_t> &   output,
+                itk::MultiThreaderBase * multiThreader)
+{
+  const itk::SizeValueType size = cellArray ? cellArray->Size() : 0;
+  const auto *             cells = size ? cellArray->CastToSTLConstContainer().data() : nullptr;
+
+  const std::vector<itk::SizeValueType> blockStarts = SplitCellArrayIntoBlocks(cells, size, valuesPerBlock);
+  if (blockStarts.empty())
+  {
+    return false;
+  }
+  WriteBlocks(
+    blockStarts,
+    [cells](itk::SizeValueType begin, itk::SizeValueType end, std::vector<uint8_t> & block) {
+      block.reserve(2 * (end - begin));
+      int64_t previousId = 0;
+      for (itk::SizeValueType ii = begin; ii < end;)
+      {
+        const itk::SizeValueType numberOfCellPoints = cells[ii++];
+        WriteVarint(numberOfCellPoints, block);
+        for (itk::SizeValueType point = 0; point < numberOfCellPoints; ++point, ++ii)
+        {
+          const auto id = static_cast<int64_t>(cells[ii]);
+          WriteVarint(ZigZagEncode(id - previousId), block);
+          previousId = id;
+        }
+      }
+    },
+    output,
+    multiThreader);
+  return true;
+}
+
+
+// Append the number of points, the origin and extent of the bounding box of
+// their finite coordinates, and their coordinates quantized to 16 bits in
+// that box. The box is computed here rather than taken from
+// PolyData::GetBounds(), which is cached on the modification time of the
+// points and misses edits made through their STL container.
+template <typename TPointsContainer>
+void
+EncodePositions(const TPointsContainer * points,
+                itk::SizeValueType       valuesPerBlock,
+                std::vector<uint8_t> &   output,
+                itk::MultiThreaderBase * multiThreader)
+{
+  constexpr unsigned int Dimension = 3;
+  constexpr double       MaximumQuantizedValue = 65535.0;
+  using BoundsType = std::array<double, 2 * Dimension>;
+
+  const itk::SizeValueType numberOfPoints = points ? points->Size() : 0;
+  WriteVarint(numberOfPoints, output);
+  if (numberOfPoints == 0)
+  {
+    return;
+  }
+  const auto *             pointsData = points->CastToSTLConstContainer().data();
+  const itk::SizeValueType numberOfBlocks = (numberOfPoints + valuesPerBlock - 1) / valuesPerBlock;
+
+  BoundsType emptyBounds;
+  for (unsigned int dim = 0; dim < Dimension; ++dim)
+  {
+    emptyBounds[2 * dim] = std::numeric_limits<double>::infinity();
+    emptyBounds[2 * dim + 1] = -std::numeric_limits<double>::infinity();
+  }
+  std::vector<BoundsType> blockBounds(numberOfBlocks, emptyBounds);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](itk::SizeValueType block) {
+      BoundsType &             bounds = blockBounds[block];
+      const itk::SizeValueType last = std::min(numberOfPoints, (block + 1) * valuesPerBlock);
+      for (itk::SizeValueType ii = block * valuesPerBlock; ii < last; ++ii)
+      {
+        for (unsigned int dim = 0; dim < Dimension; ++dim)
+        {
+          const double coordinate = pointsData[ii][dim];
+          if (std::isfinite(coordinate))
+          {
+            bounds[2 * dim] = std::min(bounds[2 * dim], coordinate);
+            bounds[2 * dim + 1] = std::max(bounds[2 * dim + 1], coordinate);
+          }
+        }
+      }
+    },
+    nullptr);
+
+  std::array<double, Dimension> origin;
+  std::array<double, Dimension> extent;
+  for (unsigned int dim = 0; dim < Dimension; ++dim)
+  {
+    double minimum = emptyBounds[2 * dim];
+    double maximum = emptyBounds[2 * dim + 1];
+    for (const BoundsType & bounds : blockBounds)
+    {
+      minimum = std::min(minimum, bounds[2 * dim]);
+      maximum = std::max(maximum, bounds[2 * dim + 1]);
+    }
+    origin[dim] = minimum <= maximum ? minimum : 0.0;
+    extent[dim] = minimum <= maximum ? maximum - minimum : 0.0;
+    WriteFloat64(origin[dim], output);
+    WriteFloat64(extent[dim], output);
+  }
+
+  const itk::SizeValueType offset = output.size();
+  output.resize(offset + numberOfPoints * Dimension * sizeof(uint16_t));
+  uint8_t * quantized = output.data() + offset;
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](itk::SizeValueType block) {
+      std::array<double, Dimension> scale;
+      for (unsigned int dim = 0; dim < Dimension; ++dim)
+      {
+        scale[dim] = extent[dim] > 0.0 ? MaximumQuantizedValue / extent[dim] : 0.0;
+      }
+      const itk::SizeValueType last = std::min(numberOfPoints, (block + 1) * valuesPerBlock);
+      for (itk::SizeValueType ii = block * valuesPerBlock; ii < last; ++ii)
+      {
+        for (unsigned int dim = 0; dim < Dimension; ++dim)
+        {
+          const double scaled = (pointsData[ii][dim] - origin[dim]) * scale[dim];
+          // Every finite coordinate is in the box, so only rounding is
+          // clamped. Written so that NaN coordinates are quantized to 0
+          const auto value =
+            static_cast<uint16_t>(std::lround(scaled > 0.0 ? std::min(scaled, MaximumQuantizedValue) : 0.0));
+          uint8_t * bytes = quantized + (ii * Dimension + dim) * sizeof(uint16_t);
+          bytes[0] = static_cast<uint8_t>(value);
+          bytes[1] = static_cast<uint8_t>(value >> 8);
+        }
+      }
+    },
+    nullptr);
+}
+
+
+// Append the number of components and of tuples of an attribute, then its
+// components, either losslessly or quantized with the given error bound.
+template <typename TComponent>
+void
+EncodeAttribute(const TComponent *       values,
+                itk::SizeValueType       numberOfValues,
+                unsigned int             numberOfComponents,
+                double                   errorBound,
+                itk::SizeValueType       valuesPerBlock,
+                std::vector<uint8_t> &   output,
+                itk::MultiThreaderBase * multiThreader)
+{
+  constexpr uint8_t Lossless = 0;
+  constexpr uint8_t Quantized = 1;
+
+  if (numberOfComponents == 0 || numberOfValues == 0)
+  {
+    WriteVarint(0, output);
+    return;
+  }
+  WriteVarint(numberOfComponents, output);
+  WriteVarint(numberOfValues / numberOfComponents, output);
+
+  std::vector<double> minimum(numberOfComponents, std::numeric_limits<double>::infinity());
+  std::vector<double> maximum(numberOfComponents, -std::numeric_limits<double>::infinity());
+  const double        step = 2.0 * errorBound;
+  bool                quantize = step > 0.0;
+  if (quantize)
+  {
+    for (itk::SizeValueType ii = 0; ii < numberOfValues; ++ii)
+    {
+      const unsigned int component = ii % numberOfComponents;
+      const double       value = values[ii];
+      if (!std::isfinite(value))
+      {
+        quantize = false;
+        break;
+      }
+      minimum[component] = std::min(minimum[component], value);
+      maximum[component] = std::max(maximum[component], value);
+    }
+  }
+  for (unsigned int component = 0; quantize && component < numberOfComponents; ++component)
+  {
+    quantize = (maximum[component] - minimum[component]) / step < std::numeric_limits<uint32_t>::max();
+  }
+  if (!quantize)
+  {
+    output.push_back(Lossless);
+    WriteRawComponents(values, numberOfValues, output);
+    return;
+  }
+
+  output.push_back(Quantized);
+  for (unsigned int component = 0; component < numberOfComponents; ++component)
+  {
+    WriteFloat64(minimum[component], output);
+  }
+  WriteFloat64(step, output);
+
+  const itk::SizeValueType        valuesPerAttributeBlock = std::max<itk::SizeValueType>(
+    numberOfComponents, valuesPerBlock - valuesPerBlock % numberOfComponents);
+  std::vector<itk::SizeValueType> blockStarts;
+  for (itk::SizeValueType ii = 0; ii < numberOfValues; ii += valuesPerAttributeBlock)
+  {
+    blockStarts.push_back(ii);
+  }
+  blockStarts.push_back(numberOfValues);
+  WriteBlocks(
+    blockStarts,
+    [&](itk::SizeValueType begin, itk::SizeValueType end, std::vector<uint8_t> & block) {
+      block.reserve(2 * (end - begin));
+      std::vector<int64_t> previous(numberOfComponents, 0);
+      for (itk::SizeValueType ii = begin; ii < end; ++ii)
+      {
+        const unsigned int component = ii % numberOfComponents;
+        const auto         quantized = static_cast<int64_t>(std::llround((values[ii] - minimum[component]) / step));
+        WriteVarint(ZigZagEncode(quantized - previous[component]), block);
+        previous[component] = quantized;
+      }
+    },
+    output,
+    multiThreader);
+}
+
+
+template <typename TPolyData, typename TBuffer, typename TContainer>
+void
+EncodePixels(const TBuffer *          buffer,
+             unsigned int             numberOfBufferComponents,
+             const TContainer *       container,
+             double                   errorBound,
+             itk::SizeValueType       valuesPerBlock,
+             std::vector<uint8_t> &   output,
+             itk::MultiThreaderBase * multiThreader)
+{
+  using ComponentType = typename TBuffer::Element;
+  if (buffer && numberOfBufferComponents > 0)
+  {
+    const itk::SizeValueType numberOfValues = buffer->Size() - buffer->Size() % numberOfBufferComponents;
+    EncodeAttribute(buffer->CastToSTLConstContainer().data(),
+                    numberOfValues,
+                    numberOfBufferComponents,
+                    errorBound,
+                    valuesPerBlock,
+                    output,
+                    multiThreader);
+  }
+  else if (container)
+  {
+    std::vector<ComponentType> components;
+    const unsigned int         numberOfComponents =
+      TPolyData::FlattenPixels(container,
+                               container->Size(),
+                               [](itk::SizeValueType ii) { return ii; },
+                               components,
+                               multiThreader,
+                               multiThreader->GetNumberOfWorkUnits());
+    EncodeAttribute(components.data(),
+                    components.size(),
+                    numberOfComponents,
+                    errorBound,
+                    valuesPerBlock,
+                    output,
+                    multiThreader);
+  }
+  else
+  {
+    WriteVarint(0, output);
+  }
+}
+
+
+// Append the number of named arrays of the points, or of the cells, then
+// for each of them its name, the kind of its components, 0 for unsigned
+// integers, 1 for signed integers and 2 for floating point, their size in
+// bytes, and its values, losslessly.
+template <typename TPolyData>
+void
+EncodeAttributeArrays(const TPolyData *        input,
+                      bool                     pointData,
+                      itk::SizeValueType       valuesPerBlock,
+                      std::vector<uint8_t> &   output,
+                      itk::MultiThreaderBase * multiThreader)
+{
+  const std::vector<std::string> names = pointData ? input->GetPointDataArrayNames() : input->GetCellDataArrayNames();
+  WriteVarint(names.size(), output);
+  for (const std::string & name : names)
+  {
+    itk::SizeValueType numberOfValues = 0;
+    const void *       values = pointData ? input->GetPointDataArrayValues(name, numberOfValues)
+                                          : input->GetCellDataArrayValues(name, numberOfValues);
+    const unsigned int numberOfComponents = pointData ? input->GetPointDataArrayNumberOfComponents(name)
+                                                      : input->GetCellDataArrayNumberOfComponents(name);
+    const itk::IOComponentEnum componentType =
+      pointData ? input->GetPointDataArrayComponentType(name) : input->GetCellDataArrayComponentType(name);
+    WriteVarint(name.size(), output);
+    output.insert(output.end(), name.begin(), name.end());
+    TPolyData::CallWithAttributeComponentType(componentType, [&](auto zero) {
+      using ComponentType = decltype(zero);
+      if (sizeof(ComponentType) > sizeof(uint64_t))
+      {
+        itkGenericExceptionMacro("The components of the attribute array " << name << " are too wide to be encoded");
+      }
+      output.push_back(std::is_floating_point<ComponentType>::value ? 2
+                       : std::is_signed<ComponentType>::value        ? 1
+                                                                     : 0);
+      output.push_back(sizeof(ComponentType));
+      EncodeAttribute(static_cast<const ComponentType *>(values),
+                      numberOfValues - numberOfValues % numberOfComponents,
+                      numberOfComponents,
+                      0.0,
+                      valuesPerBlock,
+                      output,
+                      multiThreader);
+    });
+  }
+}
+} // end anonymous namespace
+
+namespace itk
+{
+
+template <typename TPolyData>
+PolyDataEncoder<TPolyData>::PolyDataEncoder()
+  : m_MultiThreader(MultiThreaderBase::New())
+{}
+
+
+template <typename TPolyData>
+void
+PolyDataEncoder<TPolyData>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Input: " << m_Input.GetPointer() << std::endl;
+  os << indent << "PointDataErrorBound: " << m_PointDataErrorBound << std::endl;
+  os << indent << "MultiThreader: " << m_MultiThreader.GetPointer() << std::endl;
+  os << indent << "Size of Encoded Data: " << m_EncodedData.size() << std::endl;
+}
+
+
+template <typename TPolyData>
+void
+PolyDataEncoder<TPolyData>::Encode()
+{
+  const PolyDataType * input = m_Input.GetPointer();
+  if (input == nullptr)
+  {
+    itkExceptionMacro("Input PolyData is not set");
+  }
+  if (!(m_PointDataErrorBound >= 0.0))
+  {
+    itkExceptionMacro("PointDataErrorBound must be positive or zero, got " << m_PointDataErrorBound);
+  }
+
+  EncodedDataType & output = m_EncodedData;
+  output.clear();
+  WriteLittleEndian(Magic, output);
+  output.push_back(Version);
+  output.insert(output.end(), 3, uint8_t{ 0 });
+
+  EncodePositions(input->GetPoints(), ValuesPerBlock, output, m_MultiThreader);
+
+  const typename PolyDataType::CellsContainer * cellArrays[] = {
+    input->GetVertices(), input->GetLines(), input->GetPolygons(), input->GetTriangleStrips()
+  };
+  for (const auto * cellArray : cellArrays)
+  {
+    if (!EncodeCellArray(cellArray, ValuesPerBlock, output, m_MultiThreader))
+    {
+      itkExceptionMacro("The number of points of a cell overruns its cell array");
+    }
+  }
+
+  EncodePixels<PolyDataType>(input->GetPointDataBuffer(),
+                             input->GetNumberOfPointDataComponents(),
+                             input->GetPointData(),
+                             m_PointDataErrorBound,
+                             ValuesPerBlock,
+                             output,
+                             m_MultiThreader);
+  EncodePixels<PolyDataType>(input->GetCellDataBuffer(),
+                             input->GetNumberOfCellDataComponents(),
+                             input->GetCellData(),
+                             0.0,
+                             ValuesPerBlock,
+                             output,
+                             m_MultiThreader);
+  EncodeAttributeArrays(input, true, ValuesPerBlock, output, m_MultiThreader);
+  EncodeAttributeArrays(input, false, ValuesPerBlock, output, m_MultiThreader);
+}
+
+} // end namespace itk
+
+#endif // itkPolyDataEncoder_hxx
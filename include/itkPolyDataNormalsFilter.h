@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataNormalsFilter_h
+#define itkPolyDataNormalsFilter_h
+
+#include "itkPolyDataToPolyDataFilter.h"
+
+#include <string>
+
+namespace itk
+{
+/** \class PolyDataNormalsFilter
+ *
+ * \brief Compute the point and cell normals of the polygons and triangle
+ * strips of a PolyData
+ *
+ * The output shares the containers of the input, and holds the normals as
+ * float attribute arrays of three components named NormalsArrayName,
+ * "Normals" by default, see PolyData::SetPointDataArray().
+ *
+ * The normal of a polygon is computed with the method of Newell, which
+ * handles non-planar polygons, and follows the order of its points. Each
+ * triangle of a triangle strip has its own normal, with the alternating
+ * winding of the strip. The cell normal of a strip is the normalized sum of
+ * the normals of its triangles. Vertices, lines and degenerate cells have a
+ * zero normal.
+ *
+ * The normal of a point is the normalized sum of the unit normals of the
+ * polygons and strip triangles that use it, and is zero for the points no
+ * such cell uses. The normals of the cells are computed in parallel over
+ * blocks of cells, which write the contribution of each of their points to
+ * the bucket of its range of point ids. A first pass counts the
+ * contributions, so that the buckets are slices of a single array
+ * allocated once. Each range of point ids then sums its buckets in
+ * parallel, so that the accumulation needs neither atomics nor locks. The
+ * contributions are summed in cell order, and the normals are identical for
+ * any number of work units.
+ *
+ * \ingroup MeshToPolyData
+ */
+template <typename TPolyData>
+class ITK_TEMPLATE_EXPORT PolyDataNormalsFilter : public PolyDataToPolyDataFilter<TPolyData>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolyDataNormalsFilter);
+
+  /** Standard class typedefs. */
+  using Self = PolyDataNormalsFilter<TPolyData>;
+  using Superclass = PolyDataToPolyDataFilter<TPolyData>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Standard New macro. */
+  itkNewMacro(Self);
+
+  /** Run-time type information. */
+  itkOverrideGetNameOfClassMacro(PolyDataNormalsFilter);
+
+  using PolyDataType = TPolyData;
+  using NormalComponentType = float;
+  using NormalsArrayType = typename PolyDataType::template AttributeArrayType<NormalComponentType>;
+
+  /** Compute the point normals. On by default. */
+  itkSetMacro(ComputePointNormals, bool);
+  itkGetConstMacro(ComputePointNormals, bool);
+  itkBooleanMacro(ComputePointNormals);
+
+  /** Compute the cell normals, numbered as the cell data. Off by default. */
+  itkSetMacro(ComputeCellNormals, bool);
+  itkGetConstMacro(ComputeCellNormals, bool);
+  itkBooleanMacro(ComputeCellNormals);
+
+  /** Name of the point data and cell data arrays of the normals. */
+  itkSetStringMacro(NormalsArrayName);
+  itkGetStringMacro(NormalsArrayName);
+
+protected:
+  PolyDataNormalsFilter() = default;
+  ~PolyDataNormalsFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  GenerateData() override;
+
+private:
+  bool        m_ComputePointNormals{ true };
+  bool        m_ComputeCellNormals{ false };
+  std::string m_NormalsArrayName{ "Normals" };
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolyDataNormalsFilter.hxx"
+#endif
+
+#endif // itkPolyDataNormalsFilter_h
@@ -0,0 +1,312 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataNormalsFilter_hxx
+#define itkPolyDataNormalsFilter_hxx
+
+#include "itkPolyDataNormalsFilter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+// Add the normal of the polygon of points pointIds[0], ...,
+// pointIds[count - 1] to normal, with the method of Newell. Its norm is
+// twice the area of the polygon.
+template <typename TPoint, typename TIndex>
+void
+AddPolyDataNewellNormal(const TPoint * points, const TIndex * pointIds, itk::SizeValueType count, double normal[3])
+{
+  for (itk::SizeValueType ii = 0; ii < count; ++ii)
+  {
+    const TPoint & point = points[pointIds[ii]];
+    const TPoint & next = points[pointIds[ii + 1 == count ? 0 : ii + 1]];
+    normal[0] += (static_cast<double>(point[1]) - next[1]) * (static_cast<double>(point[2]) + next[2]);
+    normal[1] += (static_cast<double>(point[2]) - next[2]) * (static_cast<double>(point[0]) + next[0]);
+    normal[2] += (static_cast<double>(point[0]) - next[0]) * (static_cast<double>(point[1]) + next[1]);
+  }
+}
+
+
+// Scale normal to unit length, or set it to zero when it is degenerate
+template <typename TValue>
+void
+NormalizePolyDataNormal(TValue normal[3])
+{
+  double squaredNorm = 0.0;
+  for (unsigned int ii = 0; ii < 3; ++ii)
+  {
+    squaredNorm += static_cast<double>(normal[ii]) * normal[ii];
+  }
+  const double norm = std::sqrt(squaredNorm);
+  for (unsigned int ii = 0; ii < 3; ++ii)
+  {
+    normal[ii] = norm > 0.0 ? static_cast<TValue>(normal[ii] / norm) : TValue{ 0 };
+  }
+}
+
+
+// Unit normal of a cell added to one of its points
+template <typename TIndex>
+struct PolyDataNormalContribution
+{
+  TIndex PointId;
+  float  Normal[3];
+};
+
+} // namespace
+
+namespace itk
+{
+
+template <typename TPolyData>
+void
+PolyDataNormalsFilter<TPolyData>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "ComputePointNormals: " << m_ComputePointNormals << std::endl;
+  os << indent << "ComputeCellNormals: " << m_ComputeCellNormals << std::endl;
+  os << indent << "NormalsArrayName: " << m_NormalsArrayName << std::endl;
+}
+
+
+template <typename TPolyData>
+void
+PolyDataNormalsFilter<TPolyData>::GenerateData()
+{
+  using CellIndexType = typename PolyDataType::CellIndexType;
+  using PointType = typename PolyDataType::PointType;
+  using ContributionType = PolyDataNormalContribution<CellIndexType>;
+
+  const PolyDataType * input = this->GetInput();
+  PolyDataType *       output = this->GetOutput();
+  output->Graft(input);
+  if (!m_ComputePointNormals && !m_ComputeCellNormals)
+  {
+    return;
+  }
+
+  const typename PolyDataType::PointsContainer * inputPoints = input->GetPoints();
+  const SizeValueType                            numberOfPoints = inputPoints ? inputPoints->Size() : 0;
+
+  const PointType * points = inputPoints ? inputPoints->CastToSTLConstContainer().data() : nullptr;
+
+  // The polygons and the triangle strips are the last cells, in the order
+  // of the cell data
+  const auto *          inputPolygons = input->GetPolygons();
+  const auto *          inputStrips = input->GetTriangleStrips();
+  const CellIndexType * polygons = inputPolygons ? inputPolygons->CastToSTLConstContainer().data() : nullptr;
+  const CellIndexType * strips = inputStrips ? inputStrips->CastToSTLConstContainer().data() : nullptr;
+
+  const std::vector<SizeValueType> & polygonOffsets = input->GetPolygonOffsets()->CastToSTLConstContainer();
+  const std::vector<SizeValueType> & stripOffsets = input->GetTriangleStripOffsets()->CastToSTLConstContainer();
+  const SizeValueType                numberOfPolygons = polygonOffsets.size() - 1;
+  const SizeValueType                numberOfCells = numberOfPolygons + stripOffsets.size() - 1;
+  const SizeValueType                firstCell = input->GetNumberOfVertices() + input->GetNumberOfLines();
+
+  typename NormalsArrayType::Pointer cellNormals;
+  if (m_ComputeCellNormals)
+  {
+    cellNormals = NormalsArrayType::New();
+    cellNormals->CastToSTLContainer().assign(3 * (firstCell + numberOfCells), NormalComponentType{ 0 });
+  }
+  NormalComponentType * const cellNormalsData = cellNormals ? cellNormals->CastToSTLContainer().data() : nullptr;
+
+  // The cells are split in blocks, and the point ids in partitions. Each
+  // block writes the contributions to the points of each partition in its
+  // own bucket, a slice of a single array sized by a counting pass.
+  const SizeValueType numberOfBlocks =
+    std::max<SizeValueType>(1, std::min<SizeValueType>(this->GetNumberOfWorkUnits(), numberOfCells));
+  const SizeValueType cellsPerBlock = (numberOfCells + numberOfBlocks - 1) / numberOfBlocks;
+  const SizeValueType numberOfPartitions =
+    m_ComputePointNormals
+      ? std::max<SizeValueType>(1, std::min<SizeValueType>(this->GetNumberOfWorkUnits(), numberOfPoints))
+      : 0;
+  const SizeValueType pointsPerPartition =
+    numberOfPoints > 0 && numberOfPartitions > 0 ? (numberOfPoints + numberOfPartitions - 1) / numberOfPartitions : 1;
+  const auto getCellPointIds = [&](SizeValueType cell, SizeValueType & count) {
+    const bool            isPolygon = cell < numberOfPolygons;
+    const CellIndexType * cellArray = isPolygon ? polygons : strips;
+    const SizeValueType   offset = isPolygon ? polygonOffsets[cell] : stripOffsets[cell - numberOfPolygons];
+    count = cellArray[offset];
+    return cellArray + offset + 1;
+  };
+
+  std::vector<SizeValueType> bucketStarts(numberOfBlocks * numberOfPartitions + 1, 0);
+  std::atomic<bool>          invalidPointId{ false };
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      // Bucket sizes are counted in the following entry, ready for the
+      // prefix sum
+      SizeValueType * const bucketSizes = bucketStarts.data() + block * numberOfPartitions + 1;
+      const SizeValueType   lastCell = std::min(numberOfCells, (block + 1) * cellsPerBlock);
+      for (SizeValueType cell = block * cellsPerBlock; cell < lastCell; ++cell)
+      {
+        SizeValueType         count;
+        const CellIndexType * pointIds = getCellPointIds(cell, count);
+        if (std::any_of(pointIds, pointIds + count, [numberOfPoints](CellIndexType pointId) {
+              return pointId >= numberOfPoints;
+            }))
+        {
+          invalidPointId = true;
+          return;
+        }
+        if (numberOfPartitions == 0)
+        {
+          continue;
+        }
+        if (cell < numberOfPolygons)
+        {
+          for (SizeValueType ii = 0; ii < count; ++ii)
+          {
+            ++bucketSizes[pointIds[ii] / pointsPerPartition];
+          }
+        }
+        else
+        {
+          // Each triangle of a strip contributes to its three points
+          for (SizeValueType triangle = 0; triangle + 2 < count; ++triangle)
+          {
+            for (SizeValueType ii = triangle; ii < triangle + 3; ++ii)
+            {
+              ++bucketSizes[pointIds[ii] / pointsPerPartition];
+            }
+          }
+        }
+      }
+    },
+    nullptr);
+  if (invalidPointId)
+  {
+    itkExceptionMacro("The cells of the input use points that are not in the input PolyData");
+  }
+  for (SizeValueType bucket = 1; bucket < bucketStarts.size(); ++bucket)
+  {
+    bucketStarts[bucket] += bucketStarts[bucket - 1];
+  }
+  std::vector<ContributionType> contributions(bucketStarts.back());
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      std::vector<SizeValueType> cursors(bucketStarts.begin() + block * numberOfPartitions,
+                                         bucketStarts.begin() + (block + 1) * numberOfPartitions);
+      ContributionType           contribution;
+      const auto                 addContributions = [&](const CellIndexType * pointIds, SizeValueType count) {
+        for (SizeValueType ii = 0; ii < count; ++ii)
+        {
+          contribution.PointId = pointIds[ii];
+          contributions[cursors[pointIds[ii] / pointsPerPartition]++] = contribution;
+        }
+      };
+      const SizeValueType lastCell = std::min(numberOfCells, (block + 1) * cellsPerBlock);
+      for (SizeValueType cell = block * cellsPerBlock; cell < lastCell; ++cell)
+      {
+        SizeValueType         count;
+        const CellIndexType * pointIds = getCellPointIds(cell, count);
+        double                cellNormal[3] = { 0.0, 0.0, 0.0 };
+        if (cell < numberOfPolygons)
+        {
+          AddPolyDataNewellNormal(points, pointIds, count, cellNormal);
+          NormalizePolyDataNormal(cellNormal);
+          std::copy(cellNormal, cellNormal + 3, contribution.Normal);
+          if (numberOfPartitions > 0)
+          {
+            addContributions(pointIds, count);
+          }
+        }
+        else
+        {
+          // Every other triangle of a strip has its first two points swapped
+          for (SizeValueType triangle = 0; triangle + 2 < count; ++triangle)
+          {
+            const CellIndexType triangleIds[3] = { pointIds[triangle + (triangle % 2)],
+                                                   pointIds[triangle + 1 - (triangle % 2)],
+                                                   pointIds[triangle + 2] };
+            double              triangleNormal[3] = { 0.0, 0.0, 0.0 };
+            AddPolyDataNewellNormal(points, triangleIds, 3, triangleNormal);
+            NormalizePolyDataNormal(triangleNormal);
+            for (unsigned int ii = 0; ii < 3; ++ii)
+            {
+              cellNormal[ii] += triangleNormal[ii];
+            }
+            std::copy(triangleNormal, triangleNormal + 3, contribution.Normal);
+            if (numberOfPartitions > 0)
+            {
+              addContributions(triangleIds, 3);
+            }
+          }
+          NormalizePolyDataNormal(cellNormal);
+        }
+        if (cellNormalsData)
+        {
+          std::copy(cellNormal, cellNormal + 3, cellNormalsData + 3 * (firstCell + cell));
+        }
+      }
+    },
+    nullptr);
+
+  if (m_ComputeCellNormals)
+  {
+    output->SetCellDataArray(m_NormalsArrayName, cellNormals.GetPointer(), 3);
+  }
+  if (!m_ComputePointNormals)
+  {
+    return;
+  }
+
+  // Each partition sums the contributions to its points, in cell order
+  typename NormalsArrayType::Pointer pointNormals = NormalsArrayType::New();
+  pointNormals->CastToSTLContainer().assign(3 * numberOfPoints, NormalComponentType{ 0 });
+  NormalComponentType * const pointNormalsData = pointNormals->CastToSTLContainer().data();
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfPartitions,
+    [&](SizeValueType partition) {
+      for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+      {
+        const SizeValueType bucket = block * numberOfPartitions + partition;
+        for (SizeValueType ii = bucketStarts[bucket]; ii < bucketStarts[bucket + 1]; ++ii)
+        {
+          const ContributionType & contribution = contributions[ii];
+          NormalComponentType * pointNormal = pointNormalsData + 3 * static_cast<SizeValueType>(contribution.PointId);
+          for (unsigned int component = 0; component < 3; ++component)
+          {
+            pointNormal[component] += contribution.Normal[component];
+          }
+        }
+      }
+      const SizeValueType lastPoint = std::min(numberOfPoints, (partition + 1) * pointsPerPartition);
+      for (SizeValueType pointId = partition * pointsPerPartition; pointId < lastPoint; ++pointId)
+      {
+        NormalizePolyDataNormal(pointNormalsData + 3 * pointId);
+      }
+    },
+    nullptr);
+  output->SetPointDataArray(m_NormalsArrayName, pointNormals.GetPointer(), 3);
+}
+
+} // end namespace itk
+
+#endif // itkPolyDataNormalsFilter_hxx
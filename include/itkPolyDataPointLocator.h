@@ -0,0 +1,189 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataPointLocator_h
+#define itkPolyDataPointLocator_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkMultiThreaderBase.h"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+
+/** \class PolyDataPointLocator
+ *
+ * \brief Find the points of a PolyData nearest to query points
+ *
+ * The points of the PolyData are sorted into a uniform grid of bins that
+ * covers their bounds, see PolyData::GetBounds(), with about
+ * PointsPerBin points per bin, and never more bins than that. An axis
+ * thinner than a bin gets a single bin. The grid is built in parallel, with a
+ * counting sort of the points by bin, on the first query, and rebuilt
+ * when the points container of the PolyData is set, modified or resized.
+ * Points edited in place must be followed by a call to Modified() on the
+ * points container. Points with NaN coordinates are never found.
+ *
+ * The queries are const and can be called from several threads at once.
+ * Each query searches the grid of the points at its start: a query that
+ * rebuilds the grid, after the points were modified between queries, does
+ * not change the grid that the queries already running search. The points
+ * must not be modified while a query runs. The batched queries split their
+ * query points across the work units of the MultiThreader.
+ *
+ * \ingroup MeshToPolyData
+ */
+template <typename TPolyData>
+class ITK_TEMPLATE_EXPORT PolyDataPointLocator : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolyDataPointLocator);
+
+  /** Standard class typedefs. */
+  using Self = PolyDataPointLocator;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(PolyDataPointLocator);
+
+  using PolyDataType = TPolyData;
+  using PointType = typename PolyDataType::PointType;
+  using PointIdentifier = typename PolyDataType::PointIdentifier;
+  using PointsContainer = typename PolyDataType::PointsContainer;
+  using NeighborsType = std::vector<PointIdentifier>;
+
+  static constexpr unsigned int PointDimension = PolyDataType::PointDimension;
+
+  /** Average number of points per bin of the grid. */
+  static constexpr SizeValueType PointsPerBin = 4;
+
+  /** PolyData whose points are searched. */
+  itkSetConstObjectMacro(PolyData, PolyDataType);
+  itkGetConstObjectMacro(PolyData, PolyDataType);
+
+  /** Threader used to build the grid and run the batched queries. */
+  itkSetObjectMacro(MultiThreader, MultiThreaderBase);
+  itkGetModifiableObjectMacro(MultiThreader, MultiThreaderBase);
+
+  /** Build the grid now, instead of on the first query. */
+  void
+  Initialize() const;
+
+  /** Number of bins of the grid, which is built if needed. It is at most
+   * the number of points divided by PointsPerBin, and at least one. */
+  SizeValueType
+  GetNumberOfBins() const;
+
+  /** Identifier of the point nearest to query. An exception is thrown when
+   * the PolyData has no points. */
+  PointIdentifier
+  FindClosestPoint(const PointType & query) const;
+
+  /** Identifiers of the numberOfNeighbors points nearest to query, or of
+   * all points when there are fewer, by increasing distance. */
+  void
+  FindClosestNPoints(const PointType & query, unsigned int numberOfNeighbors, NeighborsType & neighbors) const;
+
+  /** Identifiers of the points within radius of query, in increasing
+   * order. */
+  void
+  FindPointsWithinRadius(const PointType & query, double radius, NeighborsType & neighbors) const;
+
+  /** Batched queries. The neighbors of queries[i] are
+   * neighbors[i * n, (i + 1) * n), with n the smaller of numberOfNeighbors
+   * and the number of points. */
+  void
+  FindClosestNPoints(const PointsContainer * queries, unsigned int numberOfNeighbors, NeighborsType & neighbors) const;
+  void
+  FindPointsWithinRadius(const PointsContainer *      queries,
+                         double                       radius,
+                         std::vector<NeighborsType> & neighbors) const;
+
+protected:
+  PolyDataPointLocator();
+  ~PolyDataPointLocator() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  using BinIndexType = std::array<SizeValueType, PointDimension>;
+
+  /** Grid, with the points container, modification time and size it was
+   * built from. The container is only compared, like the bounds cache of
+   * the PolyData, so that the grid does not hold a reference to it. The
+   * points of bin b are BinPointIds[BinStarts[b], BinStarts[b + 1]), with
+   * their coordinates in BinPoints. A grid is never changed once built. */
+  struct Grid
+  {
+    const PointsContainer *            Points{ nullptr };
+    ModifiedTimeType                   PointsMTime{ 0 };
+    SizeValueType                      NumberOfPoints{ 0 };
+    std::array<double, PointDimension> Origin{};
+    std::array<double, PointDimension> BinSize{};
+    BinIndexType                       Size{};
+    std::vector<SizeValueType>         BinStarts;
+    std::vector<PointIdentifier>       BinPointIds;
+    std::vector<PointType>             BinPoints;
+
+    BinIndexType
+    GetBinIndex(const PointType & point) const;
+
+    SizeValueType
+    GetBinId(const BinIndexType & binIndex) const;
+  };
+  using GridConstPointer = std::shared_ptr<const Grid>;
+
+  /** Grid of the current points, rebuilt if the points changed since the
+   * last grid was built. Each query searches the grid returned here, so a
+   * rebuild by another query replaces m_Grid without changing it. */
+  GridConstPointer
+  UpdateGrid() const;
+
+  static void
+  FindClosestNPointsInGrid(const Grid &      grid,
+                           const PointType & query,
+                           SizeValueType     numberOfNeighbors,
+                           PointIdentifier * neighbors);
+
+  static void
+  FindPointsWithinRadiusInGrid(const Grid & grid, const PointType & query, double radius, NeighborsType & neighbors);
+
+  typename PolyDataType::ConstPointer m_PolyData;
+  MultiThreaderBase::Pointer          m_MultiThreader;
+
+  mutable GridConstPointer m_Grid;
+  mutable std::mutex       m_GridMutex;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolyDataPointLocator.hxx"
+#endif
+
+#endif // itkPolyDataPointLocator_h
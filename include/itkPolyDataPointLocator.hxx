@@ -0,0 +1,484 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataPointLocator_hxx
+#define itkPolyDataPointLocator_hxx
+
+#include "itkPolyDataPointLocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace itk
+{
+
+template <typename TPolyData>
+PolyDataPointLocator<TPolyData>::PolyDataPointLocator()
+  : m_MultiThreader(MultiThreaderBase::New())
+{}
+
+
+template <typename TPolyData>
+void
+PolyDataPointLocator<TPolyData>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "PolyData: " << m_PolyData.GetPointer() << std::endl;
+  os << indent << "MultiThreader: " << m_MultiThreader.GetPointer() << std::endl;
+  GridConstPointer grid;
+  {
+    const std::lock_guard<std::mutex> lock(m_GridMutex);
+    grid = m_Grid;
+  }
+  if (grid)
+  {
+    os << indent << "Grid Points: " << grid->Points << std::endl;
+    os << indent << "Grid Size: " << grid->Size[0] << ' ' << grid->Size[1] << ' ' << grid->Size[2] << std::endl;
+  }
+  else
+  {
+    os << indent << "Grid: (none)" << std::endl;
+  }
+}
+
+
+template <typename TPolyData>
+void
+PolyDataPointLocator<TPolyData>::Initialize() const
+{
+  this->UpdateGrid();
+}
+
+
+template <typename TPolyData>
+SizeValueType
+PolyDataPointLocator<TPolyData>::GetNumberOfBins() const
+{
+  return this->UpdateGrid()->BinStarts.size() - 1;
+}
+
+
+template <typename TPolyData>
+auto
+PolyDataPointLocator<TPolyData>::Grid::GetBinIndex(const PointType & point) const -> BinIndexType
+{
+  BinIndexType binIndex;
+  for (unsigned int dim = 0; dim < PointDimension; ++dim)
+  {
+    // Written so that NaN coordinates fall in the first bin
+    const double position = (point[dim] - Origin[dim]) / BinSize[dim];
+    const auto   lastBin = static_cast<double>(Size[dim] - 1);
+    binIndex[dim] = position > 0.0 ? static_cast<SizeValueType>(std::min(position, lastBin)) : 0;
+  }
+  return binIndex;
+}
+
+
+template <typename TPolyData>
+SizeValueType
+PolyDataPointLocator<TPolyData>::Grid::GetBinId(const BinIndexType & binIndex) const
+{
+  return (binIndex[2] * Size[1] + binIndex[1]) * Size[0] + binIndex[0];
+}
+
+
+template <typename TPolyData>
+auto
+PolyDataPointLocator<TPolyData>::UpdateGrid() const -> GridConstPointer
+{
+  const std::lock_guard<std::mutex> lock(m_GridMutex);
+
+  if (m_PolyData == nullptr)
+  {
+    itkExceptionMacro("PolyData is not set");
+  }
+  const PointsContainer * points = m_PolyData->GetPoints();
+  const SizeValueType     numberOfPoints = points ? points->Size() : 0;
+  if (m_Grid && m_Grid->Points == points && (!points || m_Grid->PointsMTime == points->GetMTime()) &&
+      m_Grid->NumberOfPoints == numberOfPoints)
+  {
+    return m_Grid;
+  }
+  const auto grid = std::make_shared<Grid>();
+
+  // Bins of about equal extent along the axes with a finite extent of at
+  // least one bin, with PointsPerBin points per bin on average. An axis
+  // thinner than a bin gets a single bin, and the bin size is recomputed
+  // over the other axes until no more axis is flattened, so that a nearly
+  // flat cloud is binned like a flat one.
+  const typename PolyDataType::BoundsArrayType bounds = m_PolyData->GetBounds();
+
+  const double targetNumberOfBins = std::max<double>(1.0, static_cast<double>(numberOfPoints) / PointsPerBin);
+
+  std::array<double, PointDimension> extents;
+  std::array<bool, PointDimension>   binnedAxes;
+  for (unsigned int dim = 0; dim < PointDimension; ++dim)
+  {
+    extents[dim] = static_cast<double>(bounds[2 * dim + 1]) - bounds[2 * dim];
+    binnedAxes[dim] = extents[dim] > 0.0 && std::isfinite(extents[dim]);
+  }
+  double binSize = 1.0;
+  bool   flattened = true;
+  while (flattened)
+  {
+    double       volume = 1.0;
+    unsigned int numberOfBinnedAxes = 0;
+    for (unsigned int dim = 0; dim < PointDimension; ++dim)
+    {
+      if (binnedAxes[dim])
+      {
+        volume *= extents[dim];
+        ++numberOfBinnedAxes;
+      }
+    }
+    if (numberOfBinnedAxes == 0)
+    {
+      break;
+    }
+    binSize = std::pow(volume / targetNumberOfBins, 1.0 / numberOfBinnedAxes);
+    flattened = false;
+    for (unsigned int dim = 0; dim < PointDimension; ++dim)
+    {
+      if (binnedAxes[dim] && extents[dim] < binSize)
+      {
+        binnedAxes[dim] = false;
+        flattened = true;
+      }
+    }
+  }
+
+  // Every binned axis spans at least one bin, so rounding the number of
+  // bins of each axis down keeps the total at most targetNumberOfBins
+  SizeValueType numberOfBins = 1;
+  for (unsigned int dim = 0; dim < PointDimension; ++dim)
+  {
+    grid->Origin[dim] = std::isfinite(extents[dim]) ? bounds[2 * dim] : 0.0;
+    grid->Size[dim] = 1;
+    grid->BinSize[dim] = 1.0;
+    if (binnedAxes[dim])
+    {
+      grid->Size[dim] = std::max<SizeValueType>(static_cast<SizeValueType>(extents[dim] / binSize), 1);
+      grid->BinSize[dim] = extents[dim] / grid->Size[dim];
+    }
+    else if (extents[dim] > 0.0 && std::isfinite(extents[dim]))
+    {
+      grid->BinSize[dim] = extents[dim];
+    }
+    numberOfBins *= grid->Size[dim];
+  }
+
+  // Counting sort of the points by bin. Points with NaN coordinates are
+  // left out.
+  constexpr SizeValueType NoBin = std::numeric_limits<SizeValueType>::max();
+  const PointType *       pointsData = numberOfPoints > 0 ? points->CastToSTLConstContainer().data() : nullptr;
+
+  std::vector<SizeValueType>              pointBins(numberOfPoints);
+  std::vector<std::atomic<SizeValueType>> binCursors(numberOfBins);
+  m_MultiThreader->ParallelizeArray(
+    0,
+    numberOfPoints,
+    [&](SizeValueType pointId) {
+      const PointType & point = pointsData[pointId];
+      if (std::isnan(point[0]) || std::isnan(point[1]) || std::isnan(point[2]))
+      {
+        pointBins[pointId] = NoBin;
+        return;
+      }
+      pointBins[pointId] = grid->GetBinId(grid->GetBinIndex(point));
+      binCursors[pointBins[pointId]].fetch_add(1, std::memory_order_relaxed);
+    },
+    nullptr);
+
+  grid->BinStarts.assign(numberOfBins + 1, 0);
+  for (SizeValueType bin = 0; bin < numberOfBins; ++bin)
+  {
+    grid->BinStarts[bin + 1] = grid->BinStarts[bin] + binCursors[bin].load(std::memory_order_relaxed);
+    binCursors[bin].store(grid->BinStarts[bin], std::memory_order_relaxed);
+  }
+  grid->BinPointIds.resize(grid->BinStarts.back());
+  m_MultiThreader->ParallelizeArray(
+    0,
+    numberOfPoints,
+    [&](SizeValueType pointId) {
+      if (pointBins[pointId] != NoBin)
+      {
+        grid->BinPointIds[binCursors[pointBins[pointId]].fetch_add(1, std::memory_order_relaxed)] = pointId;
+      }
+    },
+    nullptr);
+
+  // Sort the points of each bin by id, so that the grid does not depend on
+  // the order in which the work units placed them
+  grid->BinPoints.resize(grid->BinPointIds.size());
+  m_MultiThreader->ParallelizeArray(
+    0,
+    numberOfBins,
+    [&](SizeValueType bin) {
+      std::sort(grid->BinPointIds.begin() + grid->BinStarts[bin], grid->BinPointIds.begin() + grid->BinStarts[bin + 1]);
+      for (SizeValueType position = grid->BinStarts[bin]; position < grid->BinStarts[bin + 1]; ++position)
+      {
+        grid->BinPoints[position] = pointsData[grid->BinPointIds[position]];
+      }
+    },
+    nullptr);
+
+  grid->Points = points;
+  grid->PointsMTime = points ? points->GetMTime() : 0;
+  grid->NumberOfPoints = numberOfPoints;
+  m_Grid = grid;
+  return m_Grid;
+}
+
+
+template <typename TPolyData>
+void
+PolyDataPointLocator<TPolyData>::FindClosestNPointsInGrid(const Grid &      grid,
+                                                          const PointType & query,
+                                                          SizeValueType     numberOfNeighbors,
+                                                          PointIdentifier * neighbors)
+{
+  if (numberOfNeighbors == 0)
+  {
+    return;
+  }
+
+  // Max-heap of the nearest points found so far, by squared distance then
+  // id, so that ties are broken in favor of the smallest id
+  using CandidateType = std::pair<double, PointIdentifier>;
+  std::vector<CandidateType> nearest;
+  nearest.reserve(numberOfNeighbors + 1);
+
+  const BinIndexType center = grid.GetBinIndex(query);
+  for (SizeValueType ring = 0;; ++ring)
+  {
+    // Visit the bins at a Chebyshev distance of ring from the center bin
+    BinIndexType first;
+    BinIndexType last;
+    bool         coversGrid = true;
+    for (unsigned int dim = 0; dim < PointDimension; ++dim)
+    {
+      first[dim] = center[dim] > ring ? center[dim] - ring : 0;
+      last[dim] = std::min(center[dim] + ring, grid.Size[dim] - 1);
+      coversGrid = coversGrid && first[dim] == 0 && last[dim] == grid.Size[dim] - 1;
+    }
+    BinIndexType binIndex;
+    for (binIndex[2] = first[2]; binIndex[2] <= last[2]; ++binIndex[2])
+    {
+      for (binIndex[1] = first[1]; binIndex[1] <= last[1]; ++binIndex[1])
+      {
+        for (binIndex[0] = first[0]; binIndex[0] <= last[0]; ++binIndex[0])
+        {
+          bool onRing = false;
+          for (unsigned int dim = 0; dim < PointDimension; ++dim)
+          {
+            onRing = onRing || binIndex[dim] + ring == center[dim] || binIndex[dim] == center[dim] + ring;
+          }
+          if (!onRing)
+          {
+            continue;
+          }
+          const SizeValueType bin = grid.GetBinId(binIndex);
+          for (SizeValueType position = grid.BinStarts[bin]; position < grid.BinStarts[bin + 1]; ++position)
+          {
+            const CandidateType candidate(query.SquaredEuclideanDistanceTo(grid.BinPoints[position]),
+                                          grid.BinPointIds[position]);
+            if (nearest.size() < numberOfNeighbors || candidate < nearest.front())
+            {
+              nearest.push_back(candidate);
+              std::push_heap(nearest.begin(), nearest.end());
+              if (nearest.size() > numberOfNeighbors)
+              {
+                std::pop_heap(nearest.begin(), nearest.end());
+                nearest.pop_back();
+              }
+            }
+          }
+        }
+      }
+    }
+    if (coversGrid)
+    {
+      break;
+    }
+
+    // The points of the bins not visited yet are at least as far as the
+    // nearest face of the visited box that is inside the grid
+    if (nearest.size() == numberOfNeighbors)
+    {
+      double lowerBound = std::numeric_limits<double>::infinity();
+      for (unsigned int dim = 0; dim < PointDimension; ++dim)
+      {
+        if (first[dim] > 0)
+        {
+          lowerBound = std::min(lowerBound, query[dim] - (grid.Origin[dim] + first[dim] * grid.BinSize[dim]));
+        }
+        if (last[dim] < grid.Size[dim] - 1)
+        {
+          lowerBound = std::min(lowerBound, grid.Origin[dim] + (last[dim] + 1) * grid.BinSize[dim] - query[dim]);
+        }
+      }
+      lowerBound = std::max(lowerBound, 0.0);
+      if (nearest.front().first < lowerBound * lowerBound)
+      {
+        break;
+      }
+    }
+  }
+
+  std::sort_heap(nearest.begin(), nearest.end());
+  for (SizeValueType ii = 0; ii < nearest.size(); ++ii)
+  {
+    neighbors[ii] = nearest[ii].second;
+  }
+}
+
+
+template <typename TPolyData>
+void
+PolyDataPointLocator<TPolyData>::FindPointsWithinRadiusInGrid(const Grid &      grid,
+                                                              const PointType & query,
+                                                              double            radius,
+                                                              NeighborsType &   neighbors)
+{
+  neighbors.clear();
+  if (!(radius >= 0.0))
+  {
+    return;
+  }
+  PointType lowerCorner;
+  PointType upperCorner;
+  for (unsigned int dim = 0; dim < PointDimension; ++dim)
+  {
+    lowerCorner[dim] = query[dim] - radius;
+    upperCorner[dim] = query[dim] + radius;
+  }
+  const BinIndexType first = grid.GetBinIndex(lowerCorner);
+  const BinIndexType last = grid.GetBinIndex(upperCorner);
+  const double       squaredRadius = radius * radius;
+
+  BinIndexType binIndex;
+  for (binIndex[2] = first[2]; binIndex[2] <= last[2]; ++binIndex[2])
+  {
+    for (binIndex[1] = first[1]; binIndex[1] <= last[1]; ++binIndex[1])
+    {
+      for (binIndex[0] = first[0]; binIndex[0] <= last[0]; ++binIndex[0])
+      {
+        const SizeValueType bin = grid.GetBinId(binIndex);
+        for (SizeValueType position = grid.BinStarts[bin]; position < grid.BinStarts[bin + 1]; ++position)
+        {
+          if (query.SquaredEuclideanDistanceTo(grid.BinPoints[position]) <= squaredRadius)
+          {
+            neighbors.push_back(grid.BinPointIds[position]);
+          }
+        }
+      }
+    }
+  }
+  std::sort(neighbors.begin(), neighbors.end());
+}
+
+
+template <typename TPolyData>
+auto
+PolyDataPointLocator<TPolyData>::FindClosestPoint(const PointType & query) const -> PointIdentifier
+{
+  const GridConstPointer grid = this->UpdateGrid();
+  if (grid->BinPointIds.empty())
+  {
+    itkExceptionMacro("The PolyData has no points");
+  }
+  PointIdentifier closest;
+  FindClosestNPointsInGrid(*grid, query, 1, &closest);
+  return closest;
+}
+
+
+template <typename TPolyData>
+void
+PolyDataPointLocator<TPolyData>::FindClosestNPoints(const PointType & query,
+                                                    unsigned int      numberOfNeighbors,
+                                                    NeighborsType &   neighbors) const
+{
+  const GridConstPointer grid = this->UpdateGrid();
+  neighbors.resize(std::min<SizeValueType>(numberOfNeighbors, grid->BinPointIds.size()));
+  FindClosestNPointsInGrid(*grid, query, neighbors.size(), neighbors.data());
+}
+
+
+template <typename TPolyData>
+void
+PolyDataPointLocator<TPolyData>::FindPointsWithinRadius(const PointType & query,
+                                                        double            radius,
+                                                        NeighborsType &   neighbors) const
+{
+  FindPointsWithinRadiusInGrid(*this->UpdateGrid(), query, radius, neighbors);
+}
+
+
+template <typename TPolyData>
+void
+PolyDataPointLocator<TPolyData>::FindClosestNPoints(const PointsContainer * queries,
+                                                    unsigned int            numberOfNeighbors,
+                                                    NeighborsType &         neighbors) const
+{
+  const GridConstPointer grid = this->UpdateGrid();
+  const SizeValueType    numberOfQueries = queries ? queries->Size() : 0;
+  const SizeValueType    neighborsPerQuery = std::min<SizeValueType>(numberOfNeighbors, grid->BinPointIds.size());
+  neighbors.resize(numberOfQueries * neighborsPerQuery);
+  if (neighborsPerQuery == 0)
+  {
+    return;
+  }
+  const PointType * queriesData = queries->CastToSTLConstContainer().data();
+  m_MultiThreader->ParallelizeArray(
+    0,
+    numberOfQueries,
+    [&](SizeValueType query) {
+      FindClosestNPointsInGrid(
+        *grid, queriesData[query], neighborsPerQuery, neighbors.data() + query * neighborsPerQuery);
+    },
+    nullptr);
+}
+
+
+template <typename TPolyData>
+void
+PolyDataPointLocator<TPolyData>::FindPointsWithinRadius(const PointsContainer *      queries,
+                                                        double                       radius,
+                                                        std::vector<NeighborsType> & neighbors) const
+{
+  const GridConstPointer grid = this->UpdateGrid();
+  const SizeValueType    numberOfQueries = queries ? queries->Size() : 0;
+  neighbors.resize(numberOfQueries);
+  if (numberOfQueries == 0)
+  {
+    return;
+  }
+  const PointType * queriesData = queries->CastToSTLConstContainer().data();
+  m_MultiThreader->ParallelizeArray(
+    0,
+    numberOfQueries,
+    [&](SizeValueType query) { FindPointsWithinRadiusInGrid(*grid, queriesData[query], radius, neighbors[query]); },
+    nullptr);
+}
+
+} // end namespace itk
+
+#endif // itkPolyDataPointLocator_hxx
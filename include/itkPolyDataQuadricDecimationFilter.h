@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataQuadricDecimationFilter_h
+#define itkPolyDataQuadricDecimationFilter_h
+
+#include "itkPolyDataToPolyDataFilter.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class PolyDataQuadricDecimationFilter
+ *
+ * \brief Decimate the triangles of a PolyData into several levels of detail
+ *
+ * Each output is a level of detail that keeps a fraction of the input
+ * triangles, see SetLevelFractions(). The levels are produced in one pass:
+ * the edges are collapsed in order of increasing quadric error, in the
+ * manner of Garland and Heckbert, and each level is a snapshot of the
+ * decimated surface once it has few enough triangles. Each level is thus
+ * decimated further from the previous one. A level keeps more triangles
+ * than requested when no more edge can be collapsed.
+ *
+ * The polygons are split into triangle fans and the triangle strips into
+ * triangles, and the triangles with a repeated point, such as those that
+ * stitch strips together, are dropped. The vertices and lines are not part
+ * of the output. The quadrics of the boundary edges are weighted by
+ * BoundaryWeight so that open boundaries keep their shape. A collapse is
+ * rejected when it would flip a triangle or make the surface non-manifold.
+ *
+ * The quadrics of the points and the error of every edge of the input are
+ * computed in parallel. The collapses are then applied in sequence, and
+ * the errors of the edges around a collapsed edge are updated. The output
+ * does not depend on the number of work units.
+ *
+ * A collapsed edge is replaced by the point that minimizes its quadric
+ * error, or by the best of its end points and middle when that point is not
+ * unique. The point takes the point data of the nearest end point, and
+ * every output triangle the cell data of its input cell. The point data and
+ * cell data containers and flat buffers are carried along, the named
+ * attribute arrays are not.
+ *
+ * \ingroup MeshToPolyData
+ */
+template <typename TPolyData>
+class ITK_TEMPLATE_EXPORT PolyDataQuadricDecimationFilter : public PolyDataToPolyDataFilter<TPolyData>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolyDataQuadricDecimationFilter);
+
+  /** Standard class typedefs. */
+  using Self = PolyDataQuadricDecimationFilter<TPolyData>;
+  using Superclass = PolyDataToPolyDataFilter<TPolyData>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Standard New macro. */
+  itkNewMacro(Self);
+
+  /** Run-time type information. */
+  itkOverrideGetNameOfClassMacro(PolyDataQuadricDecimationFilter);
+
+  using PolyDataType = TPolyData;
+  using LevelFractionsType = std::vector<double>;
+
+  /** Fraction of the input triangles kept by each level of detail, in
+   * (0, 1] and in decreasing order. Output i is level i. { 0.5, 0.25,
+   * 0.125 } by default. */
+  void
+  SetLevelFractions(const LevelFractionsType & levelFractions);
+  itkGetConstReferenceMacro(LevelFractions, LevelFractionsType);
+
+  /** Number of levels of detail, and of outputs. */
+  unsigned int
+  GetNumberOfLevels() const
+  {
+    return static_cast<unsigned int>(m_LevelFractions.size());
+  }
+
+  /** Weight of the quadrics that keep the boundary edges in place,
+   * relative to the quadrics of the triangles. 1000 by default. */
+  itkSetMacro(BoundaryWeight, double);
+  itkGetConstMacro(BoundaryWeight, double);
+
+protected:
+  PolyDataQuadricDecimationFilter();
+  ~PolyDataQuadricDecimationFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  GenerateData() override;
+
+private:
+  LevelFractionsType m_LevelFractions;
+  double             m_BoundaryWeight{ 1000.0 };
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolyDataQuadricDecimationFilter.hxx"
+#endif
+
+#endif // itkPolyDataQuadricDecimationFilter_h
@@ -0,0 +1,860 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataQuadricDecimationFilter_hxx
+#define itkPolyDataQuadricDecimationFilter_hxx
+
+#include "itkPolyDataQuadricDecimationFilter.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+// Quadric of the weighted squared distances to a set of planes, a symmetric
+// 4x4 matrix stored as its upper triangle a00 a01 a02 a03 a11 a12 a13 a22
+// a23 a33
+struct PolyDataDecimationQuadric
+{
+  double Values[10]{};
+
+  void
+  AddPlane(const double normal[3], double offset, double weight)
+  {
+    const double plane[4] = { normal[0], normal[1], normal[2], offset };
+    unsigned int index = 0;
+    for (unsigned int row = 0; row < 4; ++row)
+    {
+      for (unsigned int column = row; column < 4; ++column)
+      {
+        Values[index++] += weight * plane[row] * plane[column];
+      }
+    }
+  }
+
+  PolyDataDecimationQuadric &
+  operator+=(const PolyDataDecimationQuadric & other)
+  {
+    for (unsigned int ii = 0; ii < 10; ++ii)
+    {
+      Values[ii] += other.Values[ii];
+    }
+    return *this;
+  }
+
+  double
+  Evaluate(const double point[3]) const
+  {
+    const double * a = Values;
+    const double   x = point[0];
+    const double   y = point[1];
+    const double   z = point[2];
+    return a[0] * x * x + 2.0 * a[1] * x * y + 2.0 * a[2] * x * z + 2.0 * a[3] * x + a[4] * y * y +
+           2.0 * a[5] * y * z + 2.0 * a[6] * y + a[7] * z * z + 2.0 * a[8] * z + a[9];
+  }
+
+  // Point that minimizes the quadric, false when it is not unique
+  bool
+  Minimize(double point[3]) const
+  {
+    const double * a = Values;
+    const double   trace = a[0] + a[4] + a[7];
+    const double   minor0 = a[4] * a[7] - a[5] * a[5];
+    const double   minor1 = a[1] * a[7] - a[5] * a[2];
+    const double   minor2 = a[1] * a[5] - a[4] * a[2];
+    const double   determinant = a[0] * minor0 - a[1] * minor1 + a[2] * minor2;
+    if (!(trace > 0.0) || std::abs(determinant) <= 1e-10 * trace * trace * trace)
+    {
+      return false;
+    }
+
+    // Cramer's rule for the gradient being zero
+    const double b[3] = { -a[3], -a[6], -a[8] };
+    point[0] = (b[0] * minor0 - a[1] * (b[1] * a[7] - a[5] * b[2]) + a[2] * (b[1] * a[5] - a[4] * b[2])) / determinant;
+    point[1] = (a[0] * (b[1] * a[7] - a[5] * b[2]) - b[0] * minor1 + a[2] * (a[1] * b[2] - b[1] * a[2])) / determinant;
+    point[2] = (a[0] * (a[4] * b[2] - b[1] * a[5]) - a[1] * (a[1] * b[2] - b[1] * a[2]) + b[0] * minor2) / determinant;
+    return true;
+  }
+};
+
+
+// Triangle surface decimated by quadric edge collapses. The quadrics and
+// the collapse of every edge of the input are computed in parallel, the
+// collapses are then applied in order of increasing error.
+class PolyDataDecimationSurface
+{
+public:
+  using IndexType = itk::SizeValueType;
+  using TriangleType = std::array<IndexType, 3>;
+
+  PolyDataDecimationSurface(std::vector<double>       positions,
+                            std::vector<TriangleType> triangles,
+                            double                    boundaryWeight,
+                            itk::MultiThreaderBase *  multiThreader,
+                            itk::SizeValueType        numberOfWorkUnits)
+    : m_Positions(std::move(positions))
+    , m_Triangles(std::move(triangles))
+    , m_TriangleAlive(m_Triangles.size(), 1)
+    , m_NumberOfTriangles(m_Triangles.size())
+  {
+    const IndexType numberOfPoints = m_Positions.size() / 3;
+    const IndexType numberOfTriangles = m_Triangles.size();
+    m_PointTriangles.resize(numberOfPoints);
+    m_PointSources.resize(numberOfPoints);
+    m_Versions.assign(numberOfPoints, 0);
+    for (IndexType pointId = 0; pointId < numberOfPoints; ++pointId)
+    {
+      m_PointSources[pointId] = pointId;
+    }
+    for (IndexType triangle = 0; triangle < numberOfTriangles; ++triangle)
+    {
+      for (const IndexType pointId : m_Triangles[triangle])
+      {
+        m_PointTriangles[pointId].push_back(triangle);
+      }
+    }
+
+    // The quadric of a point sums the planes of its triangles, weighted by
+    // their area
+    const auto forEachBlock = [multiThreader, numberOfWorkUnits](IndexType                             count,
+                                                                 const std::function<void(IndexType)> & function) {
+      const IndexType numberOfBlocks = std::max<IndexType>(1, std::min<IndexType>(numberOfWorkUnits, count));
+      const IndexType blockSize = (count + numberOfBlocks - 1) / numberOfBlocks;
+      multiThreader->ParallelizeArray(
+        0,
+        numberOfBlocks,
+        [&](itk::SizeValueType block) {
+          const IndexType last = std::min(count, (block + 1) * blockSize);
+          for (IndexType ii = block * blockSize; ii < last; ++ii)
+          {
+            function(ii);
+          }
+        },
+        nullptr);
+    };
+    std::vector<PolyDataDecimationQuadric> triangleQuadrics(numberOfTriangles);
+    forEachBlock(numberOfTriangles, [&](IndexType triangle) {
+      double       normal[3];
+      const double area = this->TriangleNormal(m_Triangles[triangle], normal);
+      if (area > 0.0)
+      {
+        const double * origin = this->Position(m_Triangles[triangle][0]);
+        triangleQuadrics[triangle].AddPlane(
+          normal, -(normal[0] * origin[0] + normal[1] * origin[1] + normal[2] * origin[2]), area);
+      }
+    });
+    m_Quadrics.resize(numberOfPoints);
+    forEachBlock(numberOfPoints, [&](IndexType pointId) {
+      for (const IndexType triangle : m_PointTriangles[pointId])
+      {
+        m_Quadrics[pointId] += triangleQuadrics[triangle];
+      }
+    });
+    triangleQuadrics = std::vector<PolyDataDecimationQuadric>();
+
+    // The edges, sorted, with the triangle that uses each
+    std::vector<std::array<IndexType, 3>> edges;
+    edges.reserve(3 * numberOfTriangles);
+    for (IndexType triangle = 0; triangle < numberOfTriangles; ++triangle)
+    {
+      const TriangleType & pointIds = m_Triangles[triangle];
+      for (unsigned int ii = 0; ii < 3; ++ii)
+      {
+        const IndexType first = pointIds[ii];
+        const IndexType second = pointIds[(ii + 1) % 3];
+        if (first != second)
+        {
+          edges.push_back({ std::min(first, second), std::max(first, second), triangle });
+        }
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    // The boundary edges, used by a single triangle, add the plane through
+    // the edge perpendicular to the triangle to the quadrics of their points
+    std::vector<std::array<IndexType, 2>> uniqueEdges;
+    for (IndexType ii = 0; ii < edges.size();)
+    {
+      IndexType next = ii + 1;
+      while (next < edges.size() && edges[next][0] == edges[ii][0] && edges[next][1] == edges[ii][1])
+      {
+        ++next;
+      }
+      uniqueEdges.push_back({ edges[ii][0], edges[ii][1] });
+      if (next == ii + 1)
+      {
+        this->AddBoundaryQuadric(edges[ii][0], edges[ii][1], edges[ii][2], boundaryWeight);
+      }
+      ii = next;
+    }
+    edges = std::vector<std::array<IndexType, 3>>();
+
+    m_Candidates.resize(uniqueEdges.size());
+    forEachBlock(uniqueEdges.size(), [&](IndexType edge) {
+      m_Candidates[edge] = this->MakeCandidate(uniqueEdges[edge][0], uniqueEdges[edge][1]);
+    });
+    std::make_heap(m_Candidates.begin(), m_Candidates.end(), std::greater<CandidateType>());
+  }
+
+  IndexType
+  GetNumberOfTriangles() const
+  {
+    return m_NumberOfTriangles;
+  }
+
+  // Collapse edges until at most numberOfTriangles triangles are left, or
+  // no more edge can be collapsed
+  void
+  Decimate(IndexType numberOfTriangles)
+  {
+    while (m_NumberOfTriangles > numberOfTriangles && !m_Candidates.empty())
+    {
+      std::pop_heap(m_Candidates.begin(), m_Candidates.end(), std::greater<CandidateType>());
+      const CandidateType candidate = m_Candidates.back();
+      m_Candidates.pop_back();
+      if (candidate.Versions[0] == m_Versions[candidate.PointIds[0]] &&
+          candidate.Versions[1] == m_Versions[candidate.PointIds[1]] && this->CanCollapse(candidate))
+      {
+        this->Collapse(candidate);
+      }
+    }
+  }
+
+  const std::vector<TriangleType> &
+  GetTriangles() const
+  {
+    return m_Triangles;
+  }
+
+  bool
+  IsTriangleAlive(IndexType triangle) const
+  {
+    return m_TriangleAlive[triangle] != 0;
+  }
+
+  const double *
+  Position(IndexType pointId) const
+  {
+    return m_Positions.data() + 3 * pointId;
+  }
+
+  // Input point whose point data the point carries
+  IndexType
+  GetPointSource(IndexType pointId) const
+  {
+    return m_PointSources[pointId];
+  }
+
+private:
+  struct CandidateType
+  {
+    double             Cost;
+    IndexType          PointIds[2];
+    itk::SizeValueType Versions[2];
+    double             Position[3];
+
+    bool
+    operator>(const CandidateType & other) const
+    {
+      if (Cost != other.Cost)
+      {
+        return Cost > other.Cost;
+      }
+      if (PointIds[0] != other.PointIds[0])
+      {
+        return PointIds[0] > other.PointIds[0];
+      }
+      return PointIds[1] > other.PointIds[1];
+    }
+  };
+
+  // Unit normal of a triangle, returns its area
+  double
+  TriangleNormal(const TriangleType & pointIds, double normal[3], IndexType movedId = 0, const double * moved = nullptr)
+    const
+  {
+    const double * p0 = moved && pointIds[0] == movedId ? moved : this->Position(pointIds[0]);
+    const double * p1 = moved && pointIds[1] == movedId ? moved : this->Position(pointIds[1]);
+    const double * p2 = moved && pointIds[2] == movedId ? moved : this->Position(pointIds[2]);
+    const double   u[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+    const double   v[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+    normal[0] = u[1] * v[2] - u[2] * v[1];
+    normal[1] = u[2] * v[0] - u[0] * v[2];
+    normal[2] = u[0] * v[1] - u[1] * v[0];
+    const double norm = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    for (unsigned int ii = 0; ii < 3; ++ii)
+    {
+      normal[ii] = norm > 0.0 ? normal[ii] / norm : 0.0;
+    }
+    return 0.5 * norm;
+  }
+
+  void
+  AddBoundaryQuadric(IndexType first, IndexType second, IndexType triangle, double boundaryWeight)
+  {
+    double triangleNormal[3];
+    if (!(this->TriangleNormal(m_Triangles[triangle], triangleNormal) > 0.0))
+    {
+      return;
+    }
+    const double * p0 = this->Position(first);
+    const double * p1 = this->Position(second);
+    const double   edge[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+    double         normal[3] = { edge[1] * triangleNormal[2] - edge[2] * triangleNormal[1],
+                                 edge[2] * triangleNormal[0] - edge[0] * triangleNormal[2],
+                                 edge[0] * triangleNormal[1] - edge[1] * triangleNormal[0] };
+    const double   squaredLength = edge[0] * edge[0] + edge[1] * edge[1] + edge[2] * edge[2];
+    const double   norm = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    if (!(norm > 0.0))
+    {
+      return;
+    }
+    for (unsigned int ii = 0; ii < 3; ++ii)
+    {
+      normal[ii] /= norm;
+    }
+    PolyDataDecimationQuadric quadric;
+    quadric.AddPlane(
+      normal, -(normal[0] * p0[0] + normal[1] * p0[1] + normal[2] * p0[2]), boundaryWeight * squaredLength);
+    m_Quadrics[first] += quadric;
+    m_Quadrics[second] += quadric;
+  }
+
+  // The collapse of an edge to the point of least error
+  CandidateType
+  MakeCandidate(IndexType first, IndexType second) const
+  {
+    CandidateType candidate;
+    candidate.PointIds[0] = std::min(first, second);
+    candidate.PointIds[1] = std::max(first, second);
+    candidate.Versions[0] = m_Versions[candidate.PointIds[0]];
+    candidate.Versions[1] = m_Versions[candidate.PointIds[1]];
+
+    PolyDataDecimationQuadric quadric = m_Quadrics[first];
+    quadric += m_Quadrics[second];
+    if (quadric.Minimize(candidate.Position))
+    {
+      candidate.Cost = quadric.Evaluate(candidate.Position);
+      return candidate;
+    }
+    const double * p0 = this->Position(first);
+    const double * p1 = this->Position(second);
+    const double   middle[3] = { 0.5 * (p0[0] + p1[0]), 0.5 * (p0[1] + p1[1]), 0.5 * (p0[2] + p1[2]) };
+    candidate.Cost = std::numeric_limits<double>::max();
+    for (const double * position : { p0, p1, static_cast<const double *>(middle) })
+    {
+      const double cost = quadric.Evaluate(position);
+      if (cost < candidate.Cost)
+      {
+        candidate.Cost = cost;
+        std::copy(position, position + 3, candidate.Position);
+      }
+    }
+    return candidate;
+  }
+
+  // Drop the collapsed triangles from the triangles of a point
+  void
+  PruneTriangles(IndexType pointId)
+  {
+    std::vector<IndexType> & triangles = m_PointTriangles[pointId];
+    triangles.erase(std::remove_if(triangles.begin(),
+                                   triangles.end(),
+                                   [this](IndexType triangle) { return !m_TriangleAlive[triangle]; }),
+                    triangles.end());
+  }
+
+  // The neighbors of a point, which is on the boundary when one of its
+  // edges is used by a single triangle
+  std::vector<IndexType>
+  Neighbors(IndexType pointId, bool * onBoundary = nullptr) const
+  {
+    std::vector<IndexType> neighbors;
+    for (const IndexType triangle : m_PointTriangles[pointId])
+    {
+      for (const IndexType neighbor : m_Triangles[triangle])
+      {
+        if (neighbor != pointId)
+        {
+          neighbors.push_back(neighbor);
+        }
+      }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    if (onBoundary)
+    {
+      *onBoundary = false;
+      for (size_t ii = 0; ii < neighbors.size(); ++ii)
+      {
+        if ((ii == 0 || neighbors[ii - 1] != neighbors[ii]) &&
+            (ii + 1 == neighbors.size() || neighbors[ii + 1] != neighbors[ii]))
+        {
+          *onBoundary = true;
+        }
+      }
+    }
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    return neighbors;
+  }
+
+  static bool
+  HasPoint(const TriangleType & pointIds, IndexType pointId)
+  {
+    return pointIds[0] == pointId || pointIds[1] == pointId || pointIds[2] == pointId;
+  }
+
+  // A collapse must keep the surface manifold: its points share exactly the
+  // neighbors of the triangles of the edge, and an interior edge does not
+  // join two boundaries. It must not flip the triangles that move either.
+  bool
+  CanCollapse(const CandidateType & candidate)
+  {
+    const IndexType kept = candidate.PointIds[0];
+    const IndexType removed = candidate.PointIds[1];
+    this->PruneTriangles(kept);
+    this->PruneTriangles(removed);
+
+    IndexType sharedTriangles = 0;
+    for (const IndexType triangle : m_PointTriangles[kept])
+    {
+      sharedTriangles += HasPoint(m_Triangles[triangle], removed) ? 1 : 0;
+    }
+    if (sharedTriangles == 0)
+    {
+      return false;
+    }
+    bool                         keptOnBoundary = false;
+    bool                         removedOnBoundary = false;
+    const std::vector<IndexType> keptNeighbors = this->Neighbors(kept, &keptOnBoundary);
+    const std::vector<IndexType> removedNeighbors = this->Neighbors(removed, &removedOnBoundary);
+    if (sharedTriangles > 1 && keptOnBoundary && removedOnBoundary)
+    {
+      return false;
+    }
+    std::vector<IndexType> sharedNeighbors;
+    std::set_intersection(keptNeighbors.begin(),
+                          keptNeighbors.end(),
+                          removedNeighbors.begin(),
+                          removedNeighbors.end(),
+                          std::back_inserter(sharedNeighbors));
+    if (sharedNeighbors.size() != sharedTriangles)
+    {
+      return false;
+    }
+
+    // An interior point needs three neighbors, as a tetrahedron would
+    // otherwise collapse to two triangles
+    if (sharedTriangles > 1 && keptNeighbors.size() + removedNeighbors.size() - sharedNeighbors.size() < 5)
+    {
+      return false;
+    }
+
+    for (const IndexType pointId : { kept, removed })
+    {
+      const IndexType other = pointId == kept ? removed : kept;
+      for (const IndexType triangle : m_PointTriangles[pointId])
+      {
+        const TriangleType & pointIds = m_Triangles[triangle];
+        if (HasPoint(pointIds, other))
+        {
+          continue;
+        }
+        double before[3];
+        double after[3];
+        if (this->TriangleNormal(pointIds, before) > 0.0)
+        {
+          this->TriangleNormal(pointIds, after, pointId, candidate.Position);
+          if (before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0)
+          {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  void
+  Collapse(const CandidateType & candidate)
+  {
+    const IndexType kept = candidate.PointIds[0];
+    const IndexType removed = candidate.PointIds[1];
+    for (const IndexType triangle : m_PointTriangles[kept])
+    {
+      if (HasPoint(m_Triangles[triangle], removed))
+      {
+        m_TriangleAlive[triangle] = 0;
+        --m_NumberOfTriangles;
+      }
+    }
+    this->PruneTriangles(kept);
+    for (const IndexType triangle : m_PointTriangles[removed])
+    {
+      if (m_TriangleAlive[triangle])
+      {
+        std::replace(m_Triangles[triangle].begin(), m_Triangles[triangle].end(), removed, kept);
+        m_PointTriangles[kept].push_back(triangle);
+      }
+    }
+    m_PointTriangles[removed] = std::vector<IndexType>();
+
+    // The point keeps the point data of the nearest end point
+    double keptDistance = 0.0;
+    double removedDistance = 0.0;
+    for (unsigned int ii = 0; ii < 3; ++ii)
+    {
+      const double keptDifference = this->Position(kept)[ii] - candidate.Position[ii];
+      const double removedDifference = this->Position(removed)[ii] - candidate.Position[ii];
+      keptDistance += keptDifference * keptDifference;
+      removedDistance += removedDifference * removedDifference;
+    }
+    if (removedDistance < keptDistance)
+    {
+      m_PointSources[kept] = m_PointSources[removed];
+    }
+    std::copy(candidate.Position, candidate.Position + 3, m_Positions.begin() + 3 * kept);
+    m_Quadrics[kept] += m_Quadrics[removed];
+    ++m_Versions[kept];
+    ++m_Versions[removed];
+
+    for (const IndexType neighbor : this->Neighbors(kept))
+    {
+      m_Candidates.push_back(this->MakeCandidate(kept, neighbor));
+      std::push_heap(m_Candidates.begin(), m_Candidates.end(), std::greater<CandidateType>());
+    }
+  }
+
+  std::vector<double>                    m_Positions;
+  std::vector<TriangleType>              m_Triangles;
+  std::vector<uint8_t>                   m_TriangleAlive;
+  IndexType                              m_NumberOfTriangles;
+  std::vector<std::vector<IndexType>>    m_PointTriangles;
+  std::vector<IndexType>                 m_PointSources;
+  std::vector<itk::SizeValueType>        m_Versions;
+  std::vector<PolyDataDecimationQuadric> m_Quadrics;
+  std::vector<CandidateType>             m_Candidates;
+};
+
+
+// Copy the tuples ids[0], ..., ids[count - 1] of numberOfComponents values
+// of a container into a new container, in parallel
+template <typename TContainer>
+typename TContainer::Pointer
+GatherPolyDataDecimationTuples(const TContainer *                      input,
+                               const std::vector<itk::SizeValueType> & ids,
+                               unsigned int                            numberOfComponents,
+                               itk::MultiThreaderBase *                multiThreader,
+                               itk::SizeValueType                      numberOfWorkUnits)
+{
+  auto output = TContainer::New();
+  output->CastToSTLContainer().resize(ids.size() * numberOfComponents);
+  const auto *             source = input->CastToSTLConstContainer().data();
+  auto *                   destination = output->CastToSTLContainer().data();
+  const itk::SizeValueType numberOfBlocks =
+    std::max<itk::SizeValueType>(1, std::min<itk::SizeValueType>(numberOfWorkUnits, ids.size()));
+  const itk::SizeValueType blockSize = (ids.size() + numberOfBlocks - 1) / numberOfBlocks;
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](itk::SizeValueType block) {
+      const itk::SizeValueType last = std::min<itk::SizeValueType>(ids.size(), (block + 1) * blockSize);
+      for (itk::SizeValueType ii = block * blockSize; ii < last; ++ii)
+      {
+        std::copy_n(source + ids[ii] * numberOfComponents, numberOfComponents, destination + ii * numberOfComponents);
+      }
+    },
+    nullptr);
+  return output;
+}
+
+} // namespace
+
+namespace itk
+{
+
+template <typename TPolyData>
+PolyDataQuadricDecimationFilter<TPolyData>::PolyDataQuadricDecimationFilter()
+{
+  this->SetLevelFractions({ 0.5, 0.25, 0.125 });
+}
+
+
+template <typename TPolyData>
+void
+PolyDataQuadricDecimationFilter<TPolyData>::SetLevelFractions(const LevelFractionsType & levelFractions)
+{
+  if (levelFractions == m_LevelFractions)
+  {
+    return;
+  }
+  m_LevelFractions = levelFractions;
+
+  // One output per level, and at least the primary output
+  const auto numberOfOutputs = std::max<ProcessObject::DataObjectPointerArraySizeType>(1, m_LevelFractions.size());
+  this->SetNumberOfIndexedOutputs(numberOfOutputs);
+  this->SetNumberOfRequiredOutputs(numberOfOutputs);
+  for (ProcessObject::DataObjectPointerArraySizeType idx = 0; idx < numberOfOutputs; ++idx)
+  {
+    if (!this->ProcessObject::GetOutput(idx))
+    {
+      this->SetNthOutput(idx, this->MakeOutput(idx));
+    }
+  }
+  this->Modified();
+}
+
+
+template <typename TPolyData>
+void
+PolyDataQuadricDecimationFilter<TPolyData>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "LevelFractions:";
+  for (const double levelFraction : m_LevelFractions)
+  {
+    os << ' ' << levelFraction;
+  }
+  os << std::endl;
+  os << indent << "BoundaryWeight: " << m_BoundaryWeight << std::endl;
+}
+
+
+template <typename TPolyData>
+void
+PolyDataQuadricDecimationFilter<TPolyData>::GenerateData()
+{
+  using CellIndexType = typename PolyDataType::CellIndexType;
+  using IndexType = PolyDataDecimationSurface::IndexType;
+  using TriangleType = PolyDataDecimationSurface::TriangleType;
+
+  if (m_LevelFractions.empty())
+  {
+    itkExceptionMacro("At least one level of detail is required");
+  }
+  for (size_t level = 0; level < m_LevelFractions.size(); ++level)
+  {
+    if (!(m_LevelFractions[level] > 0.0 && m_LevelFractions[level] <= 1.0) ||
+        (level > 0 && m_LevelFractions[level] > m_LevelFractions[level - 1]))
+    {
+      itkExceptionMacro("The level fractions must be in (0, 1] and in decreasing order");
+    }
+  }
+
+  const PolyDataType *                           input = this->GetInput();
+  const typename PolyDataType::PointsContainer * inputPoints = input->GetPoints();
+  const SizeValueType                            numberOfPoints = inputPoints ? inputPoints->Size() : 0;
+
+  std::vector<double> positions(3 * numberOfPoints);
+  for (SizeValueType pointId = 0; pointId < numberOfPoints; ++pointId)
+  {
+    for (unsigned int ii = 0; ii < 3; ++ii)
+    {
+      positions[3 * pointId + ii] = inputPoints->ElementAt(pointId)[ii];
+    }
+  }
+
+  // The polygons are split into triangle fans and the strips into
+  // triangles, each remembering its input cell
+  const auto *                       inputPolygons = input->GetPolygons();
+  const auto *                       inputStrips = input->GetTriangleStrips();
+  const std::vector<SizeValueType> & polygonOffsets = input->GetPolygonOffsets()->CastToSTLConstContainer();
+  const std::vector<SizeValueType> & stripOffsets = input->GetTriangleStripOffsets()->CastToSTLConstContainer();
+  const SizeValueType                firstPolygon = input->GetNumberOfVertices() + input->GetNumberOfLines();
+  const SizeValueType                firstStrip = firstPolygon + polygonOffsets.size() - 1;
+  const SizeValueType                numberOfCells = firstStrip + stripOffsets.size() - 1;
+
+  // Triangles with a repeated point, such as those that stitch triangle
+  // strips together, have no area and would corrupt the edge counts of the
+  // surface, so they are dropped
+  std::vector<TriangleType>  triangles;
+  std::vector<SizeValueType> triangleCells;
+  const auto addTriangle = [&triangles, &triangleCells](const TriangleType & pointIds, SizeValueType cell) {
+    if (pointIds[0] != pointIds[1] && pointIds[1] != pointIds[2] && pointIds[2] != pointIds[0])
+    {
+      triangles.push_back(pointIds);
+      triangleCells.push_back(cell);
+    }
+  };
+  for (SizeValueType polygon = 0; polygon + 1 < polygonOffsets.size(); ++polygon)
+  {
+    const CellIndexType * cell = inputPolygons->CastToSTLConstContainer().data() + polygonOffsets[polygon];
+    const SizeValueType   count = cell[0];
+    const CellIndexType * pointIds = cell + 1;
+    for (SizeValueType ii = 1; ii + 1 < count; ++ii)
+    {
+      addTriangle({ pointIds[0], pointIds[ii], pointIds[ii + 1] }, firstPolygon + polygon);
+    }
+  }
+  for (SizeValueType strip = 0; strip + 1 < stripOffsets.size(); ++strip)
+  {
+    const CellIndexType * cell = inputStrips->CastToSTLConstContainer().data() + stripOffsets[strip];
+    const SizeValueType   count = cell[0];
+    const CellIndexType * pointIds = cell + 1;
+    // Every other triangle of a strip has its first two points swapped
+    for (SizeValueType ii = 0; ii + 2 < count; ++ii)
+    {
+      addTriangle({ pointIds[ii + (ii % 2)], pointIds[ii + 1 - (ii % 2)], pointIds[ii + 2] }, firstStrip + strip);
+    }
+  }
+  for (const TriangleType & pointIds : triangles)
+  {
+    if (pointIds[0] >= numberOfPoints || pointIds[1] >= numberOfPoints || pointIds[2] >= numberOfPoints)
+    {
+      itkExceptionMacro("The cells of the input use points that are not in the input PolyData");
+    }
+  }
+
+  const typename PolyDataType::PointDataContainer *  inputPointData = input->GetPointData();
+  const typename PolyDataType::PointDataBufferType * inputPointDataBuffer = input->GetPointDataBuffer();
+  const typename PolyDataType::CellDataContainer *   inputCellData = input->GetCellData();
+  const typename PolyDataType::CellDataBufferType *  inputCellDataBuffer = input->GetCellDataBuffer();
+  const unsigned int pointDataComponents = input->GetNumberOfPointDataComponents();
+  const unsigned int cellDataComponents = input->GetNumberOfCellDataComponents();
+  if ((inputPointData && inputPointData->Size() != numberOfPoints) ||
+      (inputPointDataBuffer && inputPointDataBuffer->Size() != numberOfPoints * pointDataComponents))
+  {
+    itkExceptionMacro("The point data of the input does not have one value per point");
+  }
+  if ((inputCellData && inputCellData->Size() != numberOfCells) ||
+      (inputCellDataBuffer && inputCellDataBuffer->Size() != numberOfCells * cellDataComponents))
+  {
+    itkExceptionMacro("The cell data of the input does not have one value per cell");
+  }
+
+  const SizeValueType       numberOfTriangles = triangles.size();
+  const SizeValueType       numberOfWorkUnits = this->GetNumberOfWorkUnits();
+  PolyDataDecimationSurface surface(
+    std::move(positions), std::move(triangles), m_BoundaryWeight, this->GetMultiThreader(), numberOfWorkUnits);
+
+  for (unsigned int level = 0; level < this->GetNumberOfLevels(); ++level)
+  {
+    surface.Decimate(static_cast<IndexType>(std::llround(m_LevelFractions[level] * numberOfTriangles)));
+
+    // The points of the remaining triangles are numbered in order of use
+    const std::vector<TriangleType> & surfaceTriangles = surface.GetTriangles();
+    std::vector<SizeValueType>        outputTriangles;
+    std::vector<SizeValueType>        outputPoints;
+    std::vector<SizeValueType>        outputPointIds(numberOfPoints, NumericTraits<SizeValueType>::max());
+    outputTriangles.reserve(surface.GetNumberOfTriangles());
+    for (SizeValueType triangle = 0; triangle < surfaceTriangles.size(); ++triangle)
+    {
+      if (!surface.IsTriangleAlive(triangle))
+      {
+        continue;
+      }
+      outputTriangles.push_back(triangle);
+      for (const IndexType pointId : surfaceTriangles[triangle])
+      {
+        if (outputPointIds[pointId] == NumericTraits<SizeValueType>::max())
+        {
+          outputPointIds[pointId] = outputPoints.size();
+          outputPoints.push_back(pointId);
+        }
+      }
+    }
+
+    auto points = PolyDataType::PointsContainer::New();
+    points->CastToSTLContainer().resize(outputPoints.size());
+    auto polygons = PolyDataType::CellsContainer::New();
+    polygons->CastToSTLContainer().resize(4 * outputTriangles.size());
+    typename PolyDataType::PointType * pointsData = points->CastToSTLContainer().data();
+    CellIndexType *                    polygonsData = polygons->CastToSTLContainer().data();
+    std::vector<SizeValueType>         pointSources(outputPoints.size());
+    std::vector<SizeValueType>         cellSources(outputTriangles.size());
+
+    const SizeValueType numberOfBlocks = std::max<SizeValueType>(
+      1, std::min<SizeValueType>(numberOfWorkUnits, std::max(outputPoints.size(), outputTriangles.size())));
+    const SizeValueType pointsPerBlock = (outputPoints.size() + numberOfBlocks - 1) / numberOfBlocks;
+    const SizeValueType trianglesPerBlock = (outputTriangles.size() + numberOfBlocks - 1) / numberOfBlocks;
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfBlocks,
+      [&](SizeValueType block) {
+        const SizeValueType lastPoint = std::min<SizeValueType>(outputPoints.size(), (block + 1) * pointsPerBlock);
+        for (SizeValueType ii = block * pointsPerBlock; ii < lastPoint; ++ii)
+        {
+          const double * position = surface.Position(outputPoints[ii]);
+          for (unsigned int jj = 0; jj < 3; ++jj)
+          {
+            pointsData[ii][jj] = static_cast<typename PolyDataType::CoordinateType>(position[jj]);
+          }
+          pointSources[ii] = surface.GetPointSource(outputPoints[ii]);
+        }
+        const SizeValueType lastTriangle =
+          std::min<SizeValueType>(outputTriangles.size(), (block + 1) * trianglesPerBlock);
+        for (SizeValueType ii = block * trianglesPerBlock; ii < lastTriangle; ++ii)
+        {
+          const TriangleType & pointIds = surfaceTriangles[outputTriangles[ii]];
+          polygonsData[4 * ii] = 3;
+          for (unsigned int jj = 0; jj < 3; ++jj)
+          {
+            polygonsData[4 * ii + 1 + jj] = static_cast<CellIndexType>(outputPointIds[pointIds[jj]]);
+          }
+          cellSources[ii] = triangleCells[outputTriangles[ii]];
+        }
+      },
+      nullptr);
+
+    PolyDataType * output = this->GetOutput(level);
+    output->SetPoints(points);
+    output->SetVertices(nullptr);
+    output->SetLines(nullptr);
+    output->SetPolygons(polygons);
+    output->SetTriangleStrips(nullptr);
+    if (inputPointData)
+    {
+      output->SetPointData(GatherPolyDataDecimationTuples(
+        inputPointData, pointSources, 1, this->GetMultiThreader(), numberOfWorkUnits));
+    }
+    if (inputPointDataBuffer)
+    {
+      output->SetPointDataBuffer(GatherPolyDataDecimationTuples(inputPointDataBuffer,
+                                                                pointSources,
+                                                                pointDataComponents,
+                                                                this->GetMultiThreader(),
+                                                                numberOfWorkUnits),
+                                 pointDataComponents);
+    }
+    if (inputCellData)
+    {
+      output->SetCellData(
+        GatherPolyDataDecimationTuples(inputCellData, cellSources, 1, this->GetMultiThreader(), numberOfWorkUnits));
+    }
+    if (inputCellDataBuffer)
+    {
+      output->SetCellDataBuffer(GatherPolyDataDecimationTuples(inputCellDataBuffer,
+                                                               cellSources,
+                                                               cellDataComponents,
+                                                               this->GetMultiThreader(),
+                                                               numberOfWorkUnits),
+                                cellDataComponents);
+    }
+    this->UpdateProgress(static_cast<float>(level + 1) / this->GetNumberOfLevels());
+  }
+}
+
+} // end namespace itk
+
+#endif // itkPolyDataQuadricDecimationFilter_hxx
@@ -0,0 +1,88 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataToPolyDataFilter_h
+#define itkPolyDataToPolyDataFilter_h
+
+#include "itkProcessObject.h"
+#include "itkPolyData.h"
+
+namespace itk
+{
+/** \class PolyDataToPolyDataFilter
+ *
+ * \brief Base class for filters that take a PolyData as input and produce a
+ * PolyData of the same type as output
+ *
+ * Subclasses implement GenerateData(). The output information is copied
+ * from the input, see PolyData::CopyInformation().
+ *
+ * \ingroup MeshToPolyData
+ */
+template <typename TPolyData>
+class ITK_TEMPLATE_EXPORT PolyDataToPolyDataFilter : public ProcessObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolyDataToPolyDataFilter);
+
+  /** Standard class typedefs. */
+  using Self = PolyDataToPolyDataFilter<TPolyData>;
+  using Superclass = ProcessObject;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information. */
+  itkOverrideGetNameOfClassMacro(PolyDataToPolyDataFilter);
+
+  using PolyDataType = TPolyData;
+
+  /** Set the polydata input of this process object.  */
+  using Superclass::SetInput;
+  void
+  SetInput(const PolyDataType * input);
+
+  /** Get the polydata input of this process object.  */
+  const PolyDataType *
+  GetInput() const;
+
+  const PolyDataType *
+  GetInput(unsigned int idx) const;
+
+  PolyDataType *
+  GetOutput();
+  const PolyDataType *
+  GetOutput() const;
+
+  PolyDataType *
+  GetOutput(unsigned int idx);
+
+protected:
+  PolyDataToPolyDataFilter();
+  ~PolyDataToPolyDataFilter() override = default;
+
+  ProcessObject::DataObjectPointer
+  MakeOutput(ProcessObject::DataObjectPointerArraySizeType idx) override;
+  ProcessObject::DataObjectPointer
+  MakeOutput(const ProcessObject::DataObjectIdentifierType &) override;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolyDataToPolyDataFilter.hxx"
+#endif
+
+#endif // itkPolyDataToPolyDataFilter_h
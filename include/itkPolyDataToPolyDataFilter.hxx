@@ -0,0 +1,112 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataToPolyDataFilter_hxx
+#define itkPolyDataToPolyDataFilter_hxx
+
+#include "itkPolyDataToPolyDataFilter.h"
+
+namespace itk
+{
+
+template <typename TPolyData>
+PolyDataToPolyDataFilter<TPolyData>::PolyDataToPolyDataFilter()
+{
+  // Modify superclass default values, can be overridden by subclasses
+  this->SetNumberOfRequiredInputs(1);
+
+  typename PolyDataType::Pointer output = static_cast<PolyDataType *>(this->MakeOutput(0).GetPointer());
+  this->ProcessObject::SetNumberOfRequiredOutputs(1);
+  this->ProcessObject::SetNthOutput(0, output.GetPointer());
+}
+
+
+template <typename TPolyData>
+void
+PolyDataToPolyDataFilter<TPolyData>::SetInput(const PolyDataType * input)
+{
+  // Process object is not const-correct so the const_cast is required here
+  this->ProcessObject::SetNthInput(0, const_cast<PolyDataType *>(input));
+}
+
+
+template <typename TPolyData>
+auto
+PolyDataToPolyDataFilter<TPolyData>::GetInput() const -> const PolyDataType *
+{
+  return itkDynamicCastInDebugMode<const PolyDataType *>(this->GetPrimaryInput());
+}
+
+
+template <typename TPolyData>
+auto
+PolyDataToPolyDataFilter<TPolyData>::GetInput(unsigned int idx) const -> const PolyDataType *
+{
+  return dynamic_cast<const PolyDataType *>(this->ProcessObject::GetInput(idx));
+}
+
+
+template <typename TPolyData>
+ProcessObject::DataObjectPointer
+PolyDataToPolyDataFilter<TPolyData>::MakeOutput(ProcessObject::DataObjectPointerArraySizeType)
+{
+  return PolyDataType::New().GetPointer();
+}
+
+
+template <typename TPolyData>
+ProcessObject::DataObjectPointer
+PolyDataToPolyDataFilter<TPolyData>::MakeOutput(const ProcessObject::DataObjectIdentifierType &)
+{
+  return PolyDataType::New().GetPointer();
+}
+
+
+template <typename TPolyData>
+auto
+PolyDataToPolyDataFilter<TPolyData>::GetOutput() -> PolyDataType *
+{
+  // we assume that the first output is of the templated type
+  return itkDynamicCastInDebugMode<PolyDataType *>(this->GetPrimaryOutput());
+}
+
+
+template <typename TPolyData>
+auto
+PolyDataToPolyDataFilter<TPolyData>::GetOutput() const -> const PolyDataType *
+{
+  // we assume that the first output is of the templated type
+  return itkDynamicCastInDebugMode<const PolyDataType *>(this->GetPrimaryOutput());
+}
+
+
+template <typename TPolyData>
+auto
+PolyDataToPolyDataFilter<TPolyData>::GetOutput(unsigned int idx) -> PolyDataType *
+{
+  auto * out = dynamic_cast<PolyDataType *>(this->ProcessObject::GetOutput(idx));
+
+  if (out == nullptr && this->ProcessObject::GetOutput(idx) != nullptr)
+  {
+    itkWarningMacro(<< "Unable to convert output number " << idx << " to type " << typeid(PolyDataType).name());
+  }
+  return out;
+}
+
+} // end namespace itk
+
+#endif // itkPolyDataToPolyDataFilter_hxx
@@ -0,0 +1,122 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataVTKFileWriter_h
+#define itkPolyDataVTKFileWriter_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+
+#include <string>
+
+namespace itk
+{
+
+/** \class PolyDataVTKFileWriter
+ *
+ * \brief Write a PolyData to a binary VTK file without converting it to a Mesh
+ *
+ * Files whose name ends in ".vtp" are written in the VTK XML PolyData
+ * format, with the arrays in a raw appended data section. Other files are
+ * written in the binary legacy VTK format. The points, cell arrays, point
+ * data and cell data are streamed from the containers of the PolyData
+ * through a buffer of BytesPerBuffer bytes. Arrays that are stored in the
+ * byte order and type of the file are written in place, without going
+ * through the buffer.
+ *
+ * The legacy format stores 32-bit signed point ids and cell array sizes; an
+ * exception is thrown for larger PolyData. The XML format stores the
+ * connectivity and offsets of the cells as 64-bit integers.
+ *
+ * The point data and cell data, stored either as containers of pixels or as
+ * flat buffers, are written as the arrays "PointData" and "CellData", as
+ * scalars in the legacy format when they have one to four components. Their
+ * number of tuples must match the number of points and of cells. The
+ * named point data and cell data arrays, see PolyData::SetPointDataArray(),
+ * follow under their own names, with their own component type, which must
+ * be at most 8 bytes wide. The named array of three components called
+ * NormalsArrayName, see PolyDataNormalsFilter, is written as the normals of
+ * the points or of the cells.
+ *
+ * \ingroup MeshToPolyData
+ */
+template <typename TPolyData>
+class ITK_TEMPLATE_EXPORT PolyDataVTKFileWriter : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolyDataVTKFileWriter);
+
+  /** Standard class typedefs. */
+  using Self = PolyDataVTKFileWriter;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(PolyDataVTKFileWriter);
+
+  using PolyDataType = TPolyData;
+
+  /** Size of the buffer of converted values. */
+  static constexpr SizeValueType BytesPerBuffer = 1 << 22;
+
+  /** PolyData to write. */
+  itkSetConstObjectMacro(Input, PolyDataType);
+  itkGetConstObjectMacro(Input, PolyDataType);
+
+  /** Name of the file to write. */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+
+  /** Name of the point data and cell data arrays written as normals.
+   * "Normals" by default. */
+  itkSetStringMacro(NormalsArrayName);
+  itkGetStringMacro(NormalsArrayName);
+
+  /** Write the input PolyData to the file. */
+  void
+  Write();
+
+protected:
+  PolyDataVTKFileWriter() = default;
+  ~PolyDataVTKFileWriter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  void
+  WriteLegacy(std::ostream & stream) const;
+
+  void
+  WriteXML(std::ostream & stream) const;
+
+  typename PolyDataType::ConstPointer m_Input;
+  std::string                         m_FileName;
+  std::string                         m_NormalsArrayName{ "Normals" };
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolyDataVTKFileWriter.hxx"
+#endif
+
+#endif // itkPolyDataVTKFileWriter_h
@@ -0,0 +1,723 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolyDataVTKFileWriter_hxx
+#define itkPolyDataVTKFileWriter_hxx
+
+#include "itkPolyDataVTKFileWriter.h"
+#include "itkByteSwapper.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkNumericTraits.h"
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+// Name of the type of TComponent in the legacy or XML VTK formats
+template <typename TComponent>
+const char *
+GetVTKFileTypeName(bool xml)
+{
+  if (std::is_floating_point<TComponent>::value)
+  {
+    if (sizeof(TComponent) == 4)
+    {
+      return xml ? "Float32" : "float";
+    }
+    return xml ? "Float64" : "double";
+  }
+  if (std::is_signed<TComponent>::value)
+  {
+    switch (sizeof(TComponent))
+    {
+      case 1:
+        return xml ? "Int8" : "char";
+      case 2:
+        return xml ? "Int16" : "short";
+      case 4:
+        return xml ? "Int32" : "int";
+      default:
+        return xml ? "Int64" : "vtktypeint64";
+    }
+  }
+  switch (sizeof(TComponent))
+  {
+    case 1:
+      return xml ? "UInt8" : "unsigned_char";
+    case 2:
+      return xml ? "UInt16" : "unsigned_short";
+    case 4:
+      return xml ? "UInt32" : "unsigned_int";
+    default:
+      return xml ? "UInt64" : "vtktypeuint64";
+  }
+}
+
+
+// Stream that converts values to the type and byte order of a VTK file into
+// a buffer, written to the file when full
+class VTKFileBufferedStream
+{
+public:
+  VTKFileBufferedStream(std::ostream & stream, bool bigEndian, itk::SizeValueType bufferSize)
+    : m_Stream(stream)
+    , m_BigEndian(bigEndian)
+    , m_Buffer(bufferSize)
+  {}
+
+  void
+  PutText(const std::string & text)
+  {
+    for (const char character : text)
+    {
+      this->Put(character);
+    }
+  }
+
+  template <typename TValue>
+  void
+  Put(TValue value)
+  {
+    if (m_Size + sizeof(TValue) > m_Buffer.size())
+    {
+      this->Flush();
+    }
+    if (m_BigEndian)
+    {
+      itk::ByteSwapper<TValue>::SwapFromSystemToBigEndian(&value);
+    }
+    std::memcpy(m_Buffer.data() + m_Size, &value, sizeof(TValue));
+    m_Size += sizeof(TValue);
+  }
+
+  // Write values converted to TOutput. Values already of the type and byte
+  // order of the file are written in place.
+  template <typename TOutput, typename TInput>
+  void
+  PutValues(const TInput * values, itk::SizeValueType numberOfValues)
+  {
+    if (std::is_same<TOutput, TInput>::value &&
+        (!m_BigEndian || sizeof(TInput) == 1 || itk::ByteSwapper<TInput>::SystemIsBigEndian()))
+    {
+      this->Flush();
+      m_Stream.write(reinterpret_cast<const char *>(values), numberOfValues * sizeof(TInput));
+      return;
+    }
+    for (itk::SizeValueType ii = 0; ii < numberOfValues; ++ii)
+    {
+      this->Put(static_cast<TOutput>(values[ii]));
+    }
+  }
+
+  void
+  Flush()
+  {
+    m_Stream.write(m_Buffer.data(), m_Size);
+    m_Size = 0;
+  }
+
+private:
+  std::ostream &     m_Stream;
+  bool               m_BigEndian;
+  std::vector<char>  m_Buffer;
+  itk::SizeValueType m_Size{ 0 };
+};
+
+
+// Number of components and of tuples of the point data or cell data of a
+// PolyData: of its flat buffer when set, else of its container of pixels
+template <typename TBuffer, typename TContainer>
+unsigned int
+GetVTKFileNumberOfComponents(const TBuffer *      buffer,
+                             unsigned int         numberOfBufferComponents,
+                             const TContainer *   container,
+                             itk::SizeValueType & numberOfTuples)
+{
+  if (buffer && numberOfBufferComponents > 0)
+  {
+    numberOfTuples = buffer->Size() / numberOfBufferComponents;
+    return numberOfBufferComponents;
+  }
+  if (container && container->Size() > 0)
+  {
+    numberOfTuples = container->Size();
+    return itk::NumericTraits<typename TContainer::Element>::GetLength(container->ElementAt(0));
+  }
+  numberOfTuples = 0;
+  return 0;
+}
+
+
+template <typename TBuffer, typename TContainer>
+void
+PutVTKFileAttribute(VTKFileBufferedStream & stream,
+                    const TBuffer *         buffer,
+                    unsigned int            numberOfBufferComponents,
+                    const TContainer *      container,
+                    unsigned int            numberOfComponents,
+                    itk::SizeValueType      numberOfTuples)
+{
+  using ComponentType = typename TBuffer::Element;
+  using PixelType = typename TContainer::Element;
+  using ConvertPixelTraits = itk::DefaultConvertPixelTraits<PixelType>;
+
+  if (buffer && numberOfBufferComponents > 0)
+  {
+    stream.PutValues<ComponentType>(buffer->CastToSTLConstContainer().data(), numberOfTuples * numberOfComponents);
+    return;
+  }
+  for (itk::SizeValueType ii = 0; ii < numberOfTuples; ++ii)
+  {
+    const PixelType & pixel = container->ElementAt(ii);
+    if (itk::NumericTraits<PixelType>::GetLength(pixel) != numberOfComponents)
+    {
+      itkGenericExceptionMacro("The pixels of the " << container->GetNameOfClass()
+                                                    << " do not all have the same number of components");
+    }
+    for (unsigned int component = 0; component < numberOfComponents; ++component)
+    {
+      stream.Put(static_cast<ComponentType>(ConvertPixelTraits::GetNthComponent(component, pixel)));
+    }
+  }
+}
+
+
+// Named attribute array of a PolyData, see PolyData::SetPointDataArray()
+struct VTKFileAttributeArray
+{
+  std::string          Name;
+  itk::IOComponentEnum ComponentType;
+  unsigned int         ComponentSize;
+  const char *         LegacyTypeName;
+  const char *         XMLTypeName;
+  unsigned int         NumberOfComponents;
+  const void *         Values;
+  itk::SizeValueType   NumberOfValues;
+};
+
+
+template <typename TPolyData>
+std::vector<VTKFileAttributeArray>
+GetVTKFileAttributeArrays(const TPolyData * input, bool pointData)
+{
+  std::vector<VTKFileAttributeArray> arrays;
+  for (const std::string & name : pointData ? input->GetPointDataArrayNames() : input->GetCellDataArrayNames())
+  {
+    VTKFileAttributeArray array;
+    array.Name = name;
+    array.ComponentType =
+      pointData ? input->GetPointDataArrayComponentType(name) : input->GetCellDataArrayComponentType(name);
+    array.NumberOfComponents = pointData ? input->GetPointDataArrayNumberOfComponents(name)
+                                         : input->GetCellDataArrayNumberOfComponents(name);
+    array.Values = pointData ? input->GetPointDataArrayValues(name, array.NumberOfValues)
+                             : input->GetCellDataArrayValues(name, array.NumberOfValues);
+    TPolyData::CallWithAttributeComponentType(array.ComponentType, [&array](auto zero) {
+      array.ComponentSize = sizeof(zero);
+      array.LegacyTypeName = GetVTKFileTypeName<decltype(zero)>(false);
+      array.XMLTypeName = GetVTKFileTypeName<decltype(zero)>(true);
+    });
+    arrays.push_back(array);
+  }
+  return arrays;
+}
+
+
+template <typename TPolyData>
+void
+PutVTKFileAttributeArray(VTKFileBufferedStream & stream, const VTKFileAttributeArray & array)
+{
+  TPolyData::CallWithAttributeComponentType(array.ComponentType, [&](auto zero) {
+    using ComponentType = decltype(zero);
+    stream.PutValues<ComponentType>(static_cast<const ComponentType *>(array.Values), array.NumberOfValues);
+  });
+}
+
+
+// Name of an array in the legacy VTK format, where the characters that would
+// end it are encoded as %XX like VTK does
+inline std::string
+EncodeVTKFileLegacyName(const std::string & name)
+{
+  constexpr char Digits[] = "0123456789ABCDEF";
+  std::string    encoded;
+  for (const char character : name)
+  {
+    const auto byte = static_cast<unsigned char>(character);
+    if (byte <= ' ' || byte >= 127 || character == '%' || character == '"')
+    {
+      encoded += { '%', Digits[byte >> 4], Digits[byte & 15] };
+    }
+    else
+    {
+      encoded += character;
+    }
+  }
+  return encoded;
+}
+
+
+// Name of an array in an attribute of the VTK XML format
+inline std::string
+EscapeVTKFileXMLName(const std::string & name)
+{
+  std::string escaped;
+  for (const char character : name)
+  {
+    switch (character)
+    {
+      case '&':
+        escaped += "&amp;";
+        break;
+      case '<':
+        escaped += "&lt;";
+        break;
+      case '>':
+        escaped += "&gt;";
+        break;
+      case '"':
+        escaped += "&quot;";
+        break;
+      default:
+        escaped += character;
+    }
+  }
+  return escaped;
+}
+} // end anonymous namespace
+
+namespace itk
+{
+
+template <typename TPolyData>
+void
+PolyDataVTKFileWriter<TPolyData>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Input: " << m_Input.GetPointer() << std::endl;
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "NormalsArrayName: " << m_NormalsArrayName << std::endl;
+}
+
+
+template <typename TPolyData>
+void
+PolyDataVTKFileWriter<TPolyData>::Write()
+{
+  const PolyDataType * input = m_Input.GetPointer();
+  if (input == nullptr)
+  {
+    itkExceptionMacro("Input is not set");
+  }
+  if (m_FileName.empty())
+  {
+    itkExceptionMacro("FileName is not set");
+  }
+
+  // Check the attributes and cell arrays before creating the file
+  const SizeValueType numberOfCells = input->GetNumberOfVertices() + input->GetNumberOfLines() +
+                                      input->GetNumberOfPolygons() + input->GetNumberOfTriangleStrips();
+  SizeValueType       numberOfTuples;
+  if (GetVTKFileNumberOfComponents(input->GetPointDataBuffer(),
+                                   input->GetNumberOfPointDataComponents(),
+                                   input->GetPointData(),
+                                   numberOfTuples) > 0 &&
+      numberOfTuples != input->GetNumberOfPoints())
+  {
+    itkExceptionMacro("The point data have " << numberOfTuples << " tuples for " << input->GetNumberOfPoints()
+                                             << " points");
+  }
+  if (GetVTKFileNumberOfComponents(
+        input->GetCellDataBuffer(), input->GetNumberOfCellDataComponents(), input->GetCellData(), numberOfTuples) > 0 &&
+      numberOfTuples != numberOfCells)
+  {
+    itkExceptionMacro("The cell data have " << numberOfTuples << " tuples for " << numberOfCells << " cells");
+  }
+  for (const bool pointData : { true, false })
+  {
+    const SizeValueType numberOfElements = pointData ? input->GetNumberOfPoints() : numberOfCells;
+    for (const VTKFileAttributeArray & array : GetVTKFileAttributeArrays(input, pointData))
+    {
+      if (array.Name.empty() || array.ComponentSize > sizeof(uint64_t))
+      {
+        itkExceptionMacro("The attribute array \"" << array.Name << "\" cannot be written to a VTK file");
+      }
+      if (array.NumberOfValues != numberOfElements * array.NumberOfComponents)
+      {
+        itkExceptionMacro("The attribute array " << array.Name << " has " << array.NumberOfValues << " values for "
+                                                 << numberOfElements << (pointData ? " points" : " cells") << " of "
+                                                 << array.NumberOfComponents << " components");
+      }
+    }
+  }
+
+  const std::string::size_type extension = m_FileName.rfind('.');
+  bool                         xml = false;
+  if (extension != std::string::npos)
+  {
+    std::string extensionName = m_FileName.substr(extension);
+    for (char & character : extensionName)
+    {
+      character = static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
+    }
+    xml = extensionName == ".vtp";
+  }
+
+  std::ofstream stream(m_FileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!stream)
+  {
+    itkExceptionMacro("Cannot open " << m_FileName << " for writing");
+  }
+  if (xml)
+  {
+    this->WriteXML(stream);
+  }
+  else
+  {
+    this->WriteLegacy(stream);
+  }
+  stream.close();
+  if (stream.fail())
+  {
+    itkExceptionMacro("Failed to write " << m_FileName);
+  }
+}
+
+
+template <typename TPolyData>
+void
+PolyDataVTKFileWriter<TPolyData>::WriteLegacy(std::ostream & stream) const
+{
+  using CoordinateType = typename PolyDataType::CoordinateType;
+  using PixelComponentType = typename PolyDataType::PixelComponentType;
+  using CellPixelComponentType = typename PolyDataType::CellPixelComponentType;
+  constexpr SizeValueType MaximumSize = std::numeric_limits<int32_t>::max();
+
+  const PolyDataType * input = m_Input.GetPointer();
+  const SizeValueType  numberOfPoints = input->GetNumberOfPoints();
+  if (numberOfPoints > MaximumSize)
+  {
+    itkExceptionMacro("The legacy VTK format cannot index " << numberOfPoints << " points");
+  }
+  const typename PolyDataType::CellsContainer * cellArrays[] = {
+    input->GetVertices(), input->GetLines(), input->GetPolygons(), input->GetTriangleStrips()
+  };
+  const SizeValueType numberOfCells[] = { input->GetNumberOfVertices(),
+                                          input->GetNumberOfLines(),
+                                          input->GetNumberOfPolygons(),
+                                          input->GetNumberOfTriangleStrips() };
+  for (const auto * cells : cellArrays)
+  {
+    if (cells && cells->Size() > MaximumSize)
+    {
+      itkExceptionMacro("The legacy VTK format cannot store a cell array of " << cells->Size() << " entries");
+    }
+  }
+
+  VTKFileBufferedStream output(stream, true, BytesPerBuffer);
+  output.PutText("# vtk DataFile Version 3.0\nvtk output\nBINARY\nDATASET POLYDATA\n");
+  output.PutText("POINTS " + std::to_string(numberOfPoints) + " " + GetVTKFileTypeName<CoordinateType>(false) + "\n");
+  if (numberOfPoints > 0)
+  {
+    output.PutValues<CoordinateType>(input->GetPoints()->CastToSTLConstContainer().data()->GetDataPointer(),
+                                     numberOfPoints * PolyDataType::PointDimension);
+  }
+  output.PutText("\n");
+
+  const char * const keywords[] = { "VERTICES", "LINES", "POLYGONS", "TRIANGLE_STRIPS" };
+  SizeValueType      totalNumberOfCells = 0;
+  for (unsigned int cellArray = 0; cellArray < 4; ++cellArray)
+  {
+    totalNumberOfCells += numberOfCells[cellArray];
+    if (numberOfCells[cellArray] == 0)
+    {
+      continue;
+    }
+    const auto & cells = cellArrays[cellArray]->CastToSTLConstContainer();
+    output.PutText(std::string(keywords[cellArray]) + " " + std::to_string(numberOfCells[cellArray]) + " " +
+                   std::to_string(cells.size()) + "\n");
+    output.PutValues<int32_t>(cells.data(), cells.size());
+    output.PutText("\n");
+  }
+
+  // Attributes of one to four components are written as scalars, others as
+  // a field
+  const auto putAttributeHeader =
+    [&output](const char * name, const char * typeName, unsigned int numberOfComponents, SizeValueType numberOfTuples) {
+      if (numberOfComponents <= 4)
+      {
+        output.PutText(std::string("SCALARS ") + name + " " + typeName + " " + std::to_string(numberOfComponents) +
+                       "\nLOOKUP_TABLE default\n");
+      }
+      else
+      {
+        output.PutText(std::string("FIELD FieldData 1\n") + name + " " + std::to_string(numberOfComponents) + " " +
+                       std::to_string(numberOfTuples) + " " + typeName + "\n");
+      }
+    };
+
+  const auto putAttributeArrays = [this, &output, &putAttributeHeader](
+                                    const std::vector<VTKFileAttributeArray> & arrays, SizeValueType numberOfTuples) {
+    for (const VTKFileAttributeArray & array : arrays)
+    {
+      const std::string name = EncodeVTKFileLegacyName(array.Name);
+      if (array.NumberOfComponents == 3 && array.Name == m_NormalsArrayName)
+      {
+        output.PutText("NORMALS " + name + " " + array.LegacyTypeName + "\n");
+      }
+      else
+      {
+        putAttributeHeader(name.c_str(), array.LegacyTypeName, array.NumberOfComponents, numberOfTuples);
+      }
+      PutVTKFileAttributeArray<PolyDataType>(output, array);
+      output.PutText("\n");
+    }
+  };
+
+  SizeValueType                            numberOfTuples;
+  const unsigned int                       numberOfCellDataComponents = GetVTKFileNumberOfComponents(
+    input->GetCellDataBuffer(), input->GetNumberOfCellDataComponents(), input->GetCellData(), numberOfTuples);
+  const std::vector<VTKFileAttributeArray> cellDataArrays = GetVTKFileAttributeArrays(input, false);
+  if (numberOfCellDataComponents > 0 || !cellDataArrays.empty())
+  {
+    output.PutText("CELL_DATA " + std::to_string(totalNumberOfCells) + "\n");
+  }
+  if (numberOfCellDataComponents > 0)
+  {
+    putAttributeHeader(
+      "CellData", GetVTKFileTypeName<CellPixelComponentType>(false), numberOfCellDataComponents, numberOfTuples);
+    PutVTKFileAttribute(output,
+                        input->GetCellDataBuffer(),
+                        input->GetNumberOfCellDataComponents(),
+                        input->GetCellData(),
+                        numberOfCellDataComponents,
+                        numberOfTuples);
+    output.PutText("\n");
+  }
+  putAttributeArrays(cellDataArrays, totalNumberOfCells);
+  const unsigned int numberOfPointDataComponents = GetVTKFileNumberOfComponents(
+    input->GetPointDataBuffer(), input->GetNumberOfPointDataComponents(), input->GetPointData(), numberOfTuples);
+  const std::vector<VTKFileAttributeArray> pointDataArrays = GetVTKFileAttributeArrays(input, true);
+  if (numberOfPointDataComponents > 0 || !pointDataArrays.empty())
+  {
+    output.PutText("POINT_DATA " + std::to_string(numberOfPoints) + "\n");
+  }
+  if (numberOfPointDataComponents > 0)
+  {
+    putAttributeHeader(
+      "PointData", GetVTKFileTypeName<PixelComponentType>(false), numberOfPointDataComponents, numberOfTuples);
+    PutVTKFileAttribute(output,
+                        input->GetPointDataBuffer(),
+                        input->GetNumberOfPointDataComponents(),
+                        input->GetPointData(),
+                        numberOfPointDataComponents,
+                        numberOfTuples);
+    output.PutText("\n");
+  }
+  putAttributeArrays(pointDataArrays, numberOfPoints);
+  output.Flush();
+}
+
+
+template <typename TPolyData>
+void
+PolyDataVTKFileWriter<TPolyData>::WriteXML(std::ostream & stream) const
+{
+  using CoordinateType = typename PolyDataType::CoordinateType;
+  using PixelComponentType = typename PolyDataType::PixelComponentType;
+  using CellPixelComponentType = typename PolyDataType::CellPixelComponentType;
+  constexpr unsigned int PointDimension = PolyDataType::PointDimension;
+
+  const PolyDataType * input = m_Input.GetPointer();
+  const SizeValueType  numberOfPoints = input->GetNumberOfPoints();
+
+  const typename PolyDataType::CellsContainer * cellArrays[] = {
+    input->GetVertices(), input->GetLines(), input->GetPolygons(), input->GetTriangleStrips()
+  };
+
+  const SizeValueType numberOfCells[] = { input->GetNumberOfVertices(),
+                                          input->GetNumberOfLines(),
+                                          input->GetNumberOfPolygons(),
+                                          input->GetNumberOfTriangleStrips() };
+  SizeValueType       numberOfPointDataTuples;
+  const unsigned int  numberOfPointDataComponents = GetVTKFileNumberOfComponents(input->GetPointDataBuffer(),
+                                                                                input->GetNumberOfPointDataComponents(),
+                                                                                input->GetPointData(),
+                                                                                numberOfPointDataTuples);
+  SizeValueType       numberOfCellDataTuples;
+  const unsigned int  numberOfCellDataComponents = GetVTKFileNumberOfComponents(input->GetCellDataBuffer(),
+                                                                               input->GetNumberOfCellDataComponents(),
+                                                                               input->GetCellData(),
+                                                                               numberOfCellDataTuples);
+  const std::vector<VTKFileAttributeArray> pointDataArrays = GetVTKFileAttributeArrays(input, true);
+  const std::vector<VTKFileAttributeArray> cellDataArrays = GetVTKFileAttributeArrays(input, false);
+
+  // The VTK elements of the cell arrays, in the order VTK writes them
+  const char * const elements[] = { "Verts", "Lines", "Polys", "Strips" };
+  const unsigned int elementOrder[] = { 0, 1, 3, 2 };
+
+  // Each appended array is preceded by its size in bytes, as a UInt64
+  SizeValueType      offset = 0;
+  std::ostringstream header;
+  const auto         putDataArray = [&header, &offset](const std::string & attributes, SizeValueType numberOfBytes) {
+    header << "        <DataArray " << attributes << " format=\"appended\" offset=\"" << offset << "\"/>\n";
+    offset += sizeof(uint64_t) + numberOfBytes;
+  };
+  header << "<?xml version=\"1.0\"?>\n"
+         << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\""
+         << (ByteSwapper<int>::SystemIsBigEndian() ? "BigEndian" : "LittleEndian") << "\" header_type=\"UInt64\">\n"
+         << "  <PolyData>\n"
+         << "    <Piece NumberOfPoints=\"" << numberOfPoints << "\" NumberOfVerts=\"" << numberOfCells[0]
+         << "\" NumberOfLines=\"" << numberOfCells[1] << "\" NumberOfStrips=\"" << numberOfCells[3]
+         << "\" NumberOfPolys=\"" << numberOfCells[2] << "\">\n";
+  // The normals are announced by the element of their attribute
+  const auto normalsAttribute = [this](const std::vector<VTKFileAttributeArray> & arrays) {
+    for (const VTKFileAttributeArray & array : arrays)
+    {
+      if (array.NumberOfComponents == 3 && array.Name == m_NormalsArrayName)
+      {
+        return " Normals=\"" + EscapeVTKFileXMLName(array.Name) + "\"";
+      }
+    }
+    return std::string();
+  };
+  const auto putAttributeArrays = [&putDataArray](const std::vector<VTKFileAttributeArray> & arrays) {
+    for (const VTKFileAttributeArray & array : arrays)
+    {
+      putDataArray(std::string("type=\"") + array.XMLTypeName + "\" Name=\"" + EscapeVTKFileXMLName(array.Name) +
+                     "\" NumberOfComponents=\"" + std::to_string(array.NumberOfComponents) + "\"",
+                   array.NumberOfValues * array.ComponentSize);
+    }
+  };
+  if (numberOfPointDataComponents > 0 || !pointDataArrays.empty())
+  {
+    header << "      <PointData" << normalsAttribute(pointDataArrays) << ">\n";
+    if (numberOfPointDataComponents > 0)
+    {
+      putDataArray(std::string("type=\"") + GetVTKFileTypeName<PixelComponentType>(true) +
+                     "\" Name=\"PointData\" NumberOfComponents=\"" + std::to_string(numberOfPointDataComponents) +
+                     "\"",
+                   numberOfPointDataTuples * numberOfPointDataComponents * sizeof(PixelComponentType));
+    }
+    putAttributeArrays(pointDataArrays);
+    header << "      </PointData>\n";
+  }
+  if (numberOfCellDataComponents > 0 || !cellDataArrays.empty())
+  {
+    header << "      <CellData" << normalsAttribute(cellDataArrays) << ">\n";
+    if (numberOfCellDataComponents > 0)
+    {
+      putDataArray(std::string("type=\"") + GetVTKFileTypeName<CellPixelComponentType>(true) +
+                     "\" Name=\"CellData\" NumberOfComponents=\"" + std::to_string(numberOfCellDataComponents) +
+                     "\"",
+                   numberOfCellDataTuples * numberOfCellDataComponents * sizeof(CellPixelComponentType));
+    }
+    putAttributeArrays(cellDataArrays);
+    header << "      </CellData>\n";
+  }
+  header << "      <Points>\n";
+  putDataArray(std::string("type=\"") + GetVTKFileTypeName<CoordinateType>(true) + "\" Name=\"Points\" " +
+                 "NumberOfComponents=\"" + std::to_string(PointDimension) + "\"",
+               numberOfPoints * PointDimension * sizeof(CoordinateType));
+  header << "      </Points>\n";
+  for (const unsigned int cellArray : elementOrder)
+  {
+    if (numberOfCells[cellArray] == 0)
+    {
+      continue;
+    }
+    header << "      <" << elements[cellArray] << ">\n";
+    putDataArray("type=\"Int64\" Name=\"connectivity\"",
+                 (cellArrays[cellArray]->Size() - numberOfCells[cellArray]) * sizeof(int64_t));
+    putDataArray("type=\"Int64\" Name=\"offsets\"", numberOfCells[cellArray] * sizeof(int64_t));
+    header << "      </" << elements[cellArray] << ">\n";
+  }
+  header << "    </Piece>\n"
+         << "  </PolyData>\n"
+         << "  <AppendedData encoding=\"raw\">\n"
+         << "   _";
+
+  VTKFileBufferedStream output(stream, false, BytesPerBuffer);
+  output.PutText(header.str());
+  if (numberOfPointDataComponents > 0)
+  {
+    output.Put<uint64_t>(numberOfPointDataTuples * numberOfPointDataComponents * sizeof(PixelComponentType));
+    PutVTKFileAttribute(output,
+                        input->GetPointDataBuffer(),
+                        input->GetNumberOfPointDataComponents(),
+                        input->GetPointData(),
+                        numberOfPointDataComponents,
+                        numberOfPointDataTuples);
+  }
+  for (const VTKFileAttributeArray & array : pointDataArrays)
+  {
+    output.Put<uint64_t>(array.NumberOfValues * array.ComponentSize);
+    PutVTKFileAttributeArray<PolyDataType>(output, array);
+  }
+  if (numberOfCellDataComponents > 0)
+  {
+    output.Put<uint64_t>(numberOfCellDataTuples * numberOfCellDataComponents * sizeof(CellPixelComponentType));
+    PutVTKFileAttribute(output,
+                        input->GetCellDataBuffer(),
+                        input->GetNumberOfCellDataComponents(),
+                        input->GetCellData(),
+                        numberOfCellDataComponents,
+                        numberOfCellDataTuples);
+  }
+  for (const VTKFileAttributeArray & array : cellDataArrays)
+  {
+    output.Put<uint64_t>(array.NumberOfValues * array.ComponentSize);
+    PutVTKFileAttributeArray<PolyDataType>(output, array);
+  }
+  output.Put<uint64_t>(numberOfPoints * PointDimension * sizeof(CoordinateType));
+  if (numberOfPoints > 0)
+  {
+    output.PutValues<CoordinateType>(input->GetPoints()->CastToSTLConstContainer().data()->GetDataPointer(),
+                                     numberOfPoints * PointDimension);
+  }
+  for (const unsigned int cellArray : elementOrder)
+  {
+    if (numberOfCells[cellArray] == 0)
+    {
+      continue;
+    }
+    const auto & cells = cellArrays[cellArray]->CastToSTLConstContainer();
+    output.Put<uint64_t>((cells.size() - numberOfCells[cellArray]) * sizeof(int64_t));
+    for (SizeValueType ii = 0; ii < cells.size(); ii += cells[ii] + 1)
+    {
+      output.PutValues<int64_t>(cells.data() + ii + 1, cells[ii]);
+    }
+    output.Put<uint64_t>(numberOfCells[cellArray] * sizeof(int64_t));
+    int64_t cellEnd = 0;
+    for (SizeValueType ii = 0; ii < cells.size(); ii += cells[ii] + 1)
+    {
+      cellEnd += cells[ii];
+      output.Put(cellEnd);
+    }
+  }
+  output.PutText("\n  </AppendedData>\n</VTKFile>\n");
+  output.Flush();
+}
+
+} // end namespace itk
+
+#endif // itkPolyDataVTKFileWriter_hxx
@@ -22,10 +22,19 @@
 #include "itkCommand.h"
 #include "itkMeshFileReader.h"
 #include "itkMeshFileWriter.h"
+#include "itkLineCell.h"
 #include "itkMesh.h"
+#include "itkPolyLineCell.h"
+#include "itkQuadrilateralCell.h"
+#include "itkTetrahedronCell.h"
+#include "itkTriangleCell.h"
+#include "itkVertexCell.h"
 #include "itkTestingMacros.h"
 #include "itkMath.h"
 
+#include <algorithm>
+#include <map>
+
 namespace
 {
 class ShowProgress : public itk::Command
@@ -96,6 +105,9 @@ itkMeshToPolyDataFilterTest(int argc, char * argv[])
 
   ITK_TEST_EXPECT_EQUAL(polyData->GetNumberOfPoints(), 2903);
 
+  // 3D float points are shared with the input
+  ITK_TEST_EXPECT_EQUAL(polyData->GetPoints(), meshReader->GetOutput()->GetPoints());
+
   PolyDataType::PointsContainer::ConstPointer points = polyData->GetPoints();
   ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual<float>(points->GetElement(0)[0], 3.71636, 10, 1e-4));
   ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual<float>(points->GetElement(0)[1], 2.34339, 10, 1e-4));
@@ -113,6 +125,544 @@ itkMeshToPolyDataFilterTest(int argc, char * argv[])
   ITK_TEST_EXPECT_EQUAL(polyData->GetPolygons()->GetElement(5), 4);
   ITK_TEST_EXPECT_EQUAL(polyData->GetPolygons()->GetElement(6), 252);
 
+  // The output does not depend on the number of work units
+  auto serialFilter = FilterType::New();
+  serialFilter->SetInput(meshReader->GetOutput());
+  serialFilter->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(serialFilter->Update());
+  ITK_TEST_EXPECT_TRUE(serialFilter->GetOutput()->GetPolygons()->CastToSTLConstContainer() ==
+                       polyData->GetPolygons()->CastToSTLConstContainer());
+
+  // Reordering for the vertex cache keeps the same polygons
+  auto cacheFilter = FilterType::New();
+  cacheFilter->SetInput(meshReader->GetOutput());
+  ITK_TEST_SET_GET_BOOLEAN(cacheFilter, OptimizeVertexCache, true);
+  cacheFilter->OptimizeVertexCacheOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(cacheFilter->Update());
+  const auto sortedPolygons = [](const PolyDataType * input) {
+    const std::vector<uint32_t> &      cellArray = input->GetPolygons()->CastToSTLConstContainer();
+    std::vector<std::vector<uint32_t>> cells;
+    for (size_t position = 0; position < cellArray.size(); position += cellArray[position] + 1)
+    {
+      cells.emplace_back(cellArray.begin() + position, cellArray.begin() + position + cellArray[position] + 1);
+    }
+    std::sort(cells.begin(), cells.end());
+    return cells;
+  };
+  ITK_TEST_EXPECT_EQUAL(cacheFilter->GetOutput()->GetPolygons()->size(), polyData->GetPolygons()->size());
+  ITK_TEST_EXPECT_TRUE(sortedPolygons(cacheFilter->GetOutput()) == sortedPolygons(polyData));
+
+  // The input cell of every output polygon is known after reordering
+  const auto polygonsByInputCell = [](const FilterType * cellFilter) {
+    const std::vector<uint32_t> & cellArray = cellFilter->GetOutput()->GetPolygons()->CastToSTLConstContainer();
+    const auto &                  cellIds = cellFilter->GetInputCellIdentifiers()->CastToSTLConstContainer();
+    std::map<itk::SizeValueType, std::vector<uint32_t>> cells;
+    size_t                                              position = 0;
+    for (const auto cellId : cellIds)
+    {
+      cells[cellId].assign(cellArray.begin() + position, cellArray.begin() + position + cellArray[position] + 1);
+      position += cellArray[position] + 1;
+    }
+    return cells;
+  };
+  ITK_TEST_EXPECT_EQUAL(cacheFilter->GetInputCellIdentifiers()->Size(), filter->GetInputCellIdentifiers()->Size());
+  ITK_TEST_EXPECT_TRUE(polygonsByInputCell(cacheFilter) == polygonsByInputCell(filter));
+  ITK_TEST_EXPECT_TRUE(cacheFilter->GetInputPointIdentifiers() == nullptr);
+
+  // Distinct cell data follow their polygons through the reordering
+  auto labeledMesh = MeshType::New();
+  labeledMesh->SetPoints(meshReader->GetOutput()->GetPoints());
+  const MeshType::CellsContainer * inputCells = meshReader->GetOutput()->GetCells();
+  for (auto cellItr = inputCells->Begin(); cellItr != inputCells->End(); ++cellItr)
+  {
+    MeshType::CellAutoPointer cell;
+    cellItr.Value()->MakeCopy(cell);
+    labeledMesh->SetCell(cellItr.Index(), cell);
+    labeledMesh->SetCellData(cellItr.Index(), 0.5f + cellItr.Index());
+  }
+  auto labeledFilter = FilterType::New();
+  labeledFilter->SetInput(labeledMesh);
+  labeledFilter->OptimizeVertexCacheOn();
+  for (const bool useAttributeBuffers : { false, true })
+  {
+    labeledFilter->SetUseAttributeBuffers(useAttributeBuffers);
+    ITK_TRY_EXPECT_NO_EXCEPTION(labeledFilter->Update());
+    const PolyDataType * labeledPolyData = labeledFilter->GetOutput();
+    const auto &         labeledCellIds = labeledFilter->GetInputCellIdentifiers()->CastToSTLConstContainer();
+    ITK_TEST_EXPECT_EQUAL(labeledCellIds.size(), labeledPolyData->GetNumberOfPolygons());
+    ITK_TEST_EXPECT_TRUE(!std::is_sorted(labeledCellIds.begin(), labeledCellIds.end()));
+    ITK_TEST_EXPECT_TRUE(polygonsByInputCell(labeledFilter) == polygonsByInputCell(filter));
+    for (itk::SizeValueType ii = 0; ii < labeledCellIds.size(); ++ii)
+    {
+      PolyDataType::CellPixelType labeledCellData = 0.0f;
+      ITK_TEST_EXPECT_TRUE(labeledPolyData->GetCellData(ii, &labeledCellData));
+      if (labeledCellData != 0.5f + labeledCellIds[ii])
+      {
+        std::cerr << "Polygon " << ii << " of input cell " << labeledCellIds[ii] << " has cell data "
+                  << labeledCellData << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Triangle-only meshes take the homogeneous path
+  auto triangleMesh = MeshType::New();
+  for (unsigned int pointId = 0; pointId < 4; ++pointId)
+  {
+    MeshType::PointType point;
+    point[0] = pointId % 2;
+    point[1] = pointId / 2;
+    point[2] = 0.0;
+    triangleMesh->SetPoint(pointId, point);
+  }
+  using TriangleCellType = itk::TriangleCell<MeshType::CellType>;
+  const MeshType::PointIdentifier trianglePointIds[2][3] = { { 0, 1, 2 }, { 1, 3, 2 } };
+  for (unsigned int cellId = 0; cellId < 2; ++cellId)
+  {
+    MeshType::CellAutoPointer cell;
+    cell.TakeOwnership(new TriangleCellType);
+    for (unsigned int ii = 0; ii < 3; ++ii)
+    {
+      cell->SetPointId(ii, trianglePointIds[cellId][ii]);
+    }
+    triangleMesh->SetCell(cellId, cell);
+    triangleMesh->SetCellData(cellId, 10.0f + cellId);
+  }
+  auto triangleFilter = FilterType::New();
+  triangleFilter->SetInput(triangleMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(triangleFilter->Update());
+  const PolyDataType * trianglePolyData = triangleFilter->GetOutput();
+  const std::vector<uint32_t> expectedTriangles = { 3, 0, 1, 2, 3, 1, 3, 2 };
+  ITK_TEST_EXPECT_TRUE(trianglePolyData->GetPolygons()->CastToSTLConstContainer() == expectedTriangles);
+  ITK_TEST_EXPECT_EQUAL(trianglePolyData->GetCellData()->Size(), 2);
+  ITK_TEST_EXPECT_EQUAL(trianglePolyData->GetCellData()->GetElement(1), 11.0f);
+
+  // Moving points reuses the cached connectivity
+  PolyDataType::CellsContainer::ConstPointer cachedPolygons = trianglePolyData->GetPolygons();
+  MeshType::PointType                        movedPoint = triangleMesh->GetPoint(3);
+  movedPoint[2] = 1.0;
+  triangleMesh->SetPoint(3, movedPoint);
+  triangleMesh->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(triangleFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(triangleFilter->GetOutput()->GetPolygons(), cachedPolygons.GetPointer());
+  ITK_TEST_EXPECT_EQUAL(triangleFilter->GetOutput()->GetPoint(3)[2], 1.0f);
+
+  // The points of a 2D mesh are converted rather than shared: moving them
+  // refreshes the output points and reuses the cell data and the input cell
+  // identifiers along with the connectivity
+  using PlanarMeshType = itk::Mesh<PixelType, 2>;
+  using PlanarFilterType = itk::MeshToPolyDataFilter<PlanarMeshType>;
+  auto planarMesh = PlanarMeshType::New();
+  for (unsigned int pointId = 0; pointId < 4; ++pointId)
+  {
+    PlanarMeshType::PointType point;
+    point[0] = pointId % 2;
+    point[1] = pointId / 2;
+    planarMesh->SetPoint(pointId, point);
+  }
+  using PlanarTriangleCellType = itk::TriangleCell<PlanarMeshType::CellType>;
+  for (unsigned int cellId = 0; cellId < 2; ++cellId)
+  {
+    PlanarMeshType::CellAutoPointer cell;
+    cell.TakeOwnership(new PlanarTriangleCellType);
+    for (unsigned int ii = 0; ii < 3; ++ii)
+    {
+      cell->SetPointId(ii, trianglePointIds[cellId][ii]);
+    }
+    planarMesh->SetCell(cellId, cell);
+    planarMesh->SetCellData(cellId, 10.0f + cellId);
+  }
+  auto planarFilter = PlanarFilterType::New();
+  planarFilter->SetInput(planarMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(planarFilter->Update());
+  const PolyDataType *                                     planarPolyData = planarFilter->GetOutput();
+  PolyDataType::CellsContainer::ConstPointer               planarPolygons = planarPolyData->GetPolygons();
+  PolyDataType::CellDataContainer::ConstPointer            planarCellData = planarPolyData->GetCellData();
+  PlanarFilterType::CellIdentifiersContainer::ConstPointer planarCellIds = planarFilter->GetInputCellIdentifiers();
+  ITK_TEST_EXPECT_EQUAL(planarPolyData->GetPoint(3)[1], 1.0f);
+  PlanarMeshType::PointType movedPlanarPoint = planarMesh->GetPoint(3);
+  movedPlanarPoint[0] = 2.0;
+  movedPlanarPoint[1] = 3.0;
+  planarMesh->SetPoint(3, movedPlanarPoint);
+  planarMesh->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(planarFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(planarPolyData->GetPoint(3)[0], 2.0f);
+  ITK_TEST_EXPECT_EQUAL(planarPolyData->GetPoint(3)[1], 3.0f);
+  ITK_TEST_EXPECT_EQUAL(planarPolyData->GetPoint(3)[2], 0.0f);
+  ITK_TEST_EXPECT_EQUAL(planarPolyData->GetPolygons(), planarPolygons.GetPointer());
+  ITK_TEST_EXPECT_TRUE(planarPolyData->GetPolygons()->CastToSTLConstContainer() == expectedTriangles);
+  ITK_TEST_EXPECT_EQUAL(planarPolyData->GetCellData(), planarCellData.GetPointer());
+  ITK_TEST_EXPECT_EQUAL(planarPolyData->GetCellData()->GetElement(1), 11.0f);
+  ITK_TEST_EXPECT_EQUAL(planarFilter->GetInputCellIdentifiers(), planarCellIds.GetPointer());
+
+  // Modifying the cells regenerates the connectivity
+  triangleMesh->GetCells()->Modified();
+  triangleMesh->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(triangleFilter->Update());
+  ITK_TEST_EXPECT_TRUE(triangleFilter->GetOutput()->GetPolygons() != cachedPolygons.GetPointer());
+  ITK_TEST_EXPECT_TRUE(triangleFilter->GetOutput()->GetPolygons()->CastToSTLConstContainer() == expectedTriangles);
+
+  // The containers of the previous output are reused when nothing else
+  // references them
+  auto reuseFilter = FilterType::New();
+  ITK_TEST_SET_GET_BOOLEAN(reuseFilter, ReuseContainers, true);
+  reuseFilter->SetInput(triangleMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reuseFilter->Update());
+  const PolyDataType *                    reusePolyData = reuseFilter->GetOutput();
+  const PolyDataType::CellsContainer *    previousPolygons = reusePolyData->GetPolygons();
+  const PolyDataType::CellDataContainer * previousCellData = reusePolyData->GetCellData();
+  triangleMesh->GetCells()->Modified();
+  triangleMesh->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(reuseFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(reusePolyData->GetPolygons(), previousPolygons);
+  ITK_TEST_EXPECT_TRUE(reusePolyData->GetPolygons()->CastToSTLConstContainer() == expectedTriangles);
+  ITK_TEST_EXPECT_EQUAL(reusePolyData->GetCellData(), previousCellData);
+  ITK_TEST_EXPECT_EQUAL(reusePolyData->GetCellData()->GetElement(1), 11.0f);
+  reuseFilter->ReuseContainersOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(reuseFilter->Update());
+  ITK_TEST_EXPECT_TRUE(reusePolyData->GetPolygons()->CastToSTLConstContainer() == expectedTriangles);
+
+  // Triangles with different cell data are not joined into a strip
+  auto stripFilter = FilterType::New();
+  stripFilter->SetInput(triangleMesh);
+  ITK_TEST_SET_GET_BOOLEAN(stripFilter, GenerateTriangleStrips, true);
+  stripFilter->GenerateTriangleStripsOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(stripFilter->Update());
+  const PolyDataType *        stripPolyData = stripFilter->GetOutput();
+  const std::vector<uint32_t> expectedSeparateStrips = { 3, 0, 1, 2, 3, 1, 3, 2 };
+  ITK_TEST_EXPECT_TRUE(stripPolyData->GetTriangleStrips()->CastToSTLConstContainer() == expectedSeparateStrips);
+  ITK_TEST_EXPECT_EQUAL(stripPolyData->GetPolygons()->Size(), 0);
+  ITK_TEST_EXPECT_EQUAL(stripPolyData->GetCellData()->Size(), 2);
+  ITK_TEST_EXPECT_TRUE(stripFilter->GetInputCellIdentifiers()->CastToSTLConstContainer() ==
+                       std::vector<FilterType::CellIdentifierElementType>({ 0, 1 }));
+
+  // Triangles with equal cell data are joined
+  triangleMesh->GetCellData()->SetElement(1, 10.0f);
+  triangleMesh->GetCellData()->Modified();
+  triangleMesh->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(stripFilter->Update());
+  const std::vector<uint32_t> expectedStrip = { 4, 0, 1, 2, 3 };
+  ITK_TEST_EXPECT_TRUE(stripPolyData->GetTriangleStrips()->CastToSTLConstContainer() == expectedStrip);
+  ITK_TEST_EXPECT_EQUAL(stripPolyData->GetCellData()->Size(), 1);
+  ITK_TEST_EXPECT_EQUAL(stripPolyData->GetCellData()->GetElement(0), 10.0f);
+  ITK_TEST_EXPECT_EQUAL(stripFilter->GetInputCellIdentifiers()->Size(), 1);
+
+  // Attributes can be stored as flat buffers
+  auto bufferFilter = FilterType::New();
+  bufferFilter->SetInput(triangleMesh);
+  ITK_TEST_SET_GET_BOOLEAN(bufferFilter, UseAttributeBuffers, true);
+  bufferFilter->UseAttributeBuffersOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(bufferFilter->Update());
+  const PolyDataType * bufferPolyData = bufferFilter->GetOutput();
+  ITK_TEST_EXPECT_TRUE(bufferPolyData->GetCellData() == nullptr);
+  ITK_TEST_EXPECT_EQUAL(bufferPolyData->GetCellDataBuffer()->Size(), 2);
+  ITK_TEST_EXPECT_EQUAL(bufferPolyData->GetNumberOfCellDataComponents(), 1);
+  PolyDataType::CellPixelType bufferCellData;
+  ITK_TEST_EXPECT_TRUE(bufferPolyData->GetCellData(1, &bufferCellData));
+  ITK_TEST_EXPECT_EQUAL(bufferCellData, 10.0f);
+
+  // The cell data of interleaved vertices, lines and polygons are gathered
+  // in parallel into the order of the output cells, as they are serially
+  auto mixedMesh = MeshType::New();
+  constexpr unsigned int NumberOfMixedCells = 3000;
+  for (unsigned int pointId = 0; pointId < NumberOfMixedCells + 2; ++pointId)
+  {
+    MeshType::PointType point;
+    point[0] = pointId % 2;
+    point[1] = pointId;
+    point[2] = pointId % 3;
+    mixedMesh->SetPoint(pointId, point);
+  }
+  using VertexCellType = itk::VertexCell<MeshType::CellType>;
+  using LineCellType = itk::LineCell<MeshType::CellType>;
+  for (unsigned int cellId = 0; cellId < NumberOfMixedCells; ++cellId)
+  {
+    MeshType::CellAutoPointer cell;
+    switch (cellId % 3)
+    {
+      case 0:
+        cell.TakeOwnership(new VertexCellType);
+        break;
+      case 1:
+        cell.TakeOwnership(new LineCellType);
+        break;
+      default:
+        cell.TakeOwnership(new TriangleCellType);
+        break;
+    }
+    for (unsigned int ii = 0; ii < cell->GetNumberOfPoints(); ++ii)
+    {
+      cell->SetPointId(ii, cellId + ii);
+    }
+    mixedMesh->SetCell(cellId, cell);
+    mixedMesh->SetCellData(cellId, 0.5f + cellId);
+  }
+  auto serialMixedFilter = FilterType::New();
+  serialMixedFilter->SetInput(mixedMesh);
+  serialMixedFilter->SetNumberOfWorkUnits(1);
+  auto parallelMixedFilter = FilterType::New();
+  parallelMixedFilter->SetInput(mixedMesh);
+  parallelMixedFilter->SetNumberOfWorkUnits(7);
+  for (const bool useAttributeBuffers : { false, true })
+  {
+    serialMixedFilter->SetUseAttributeBuffers(useAttributeBuffers);
+    parallelMixedFilter->SetUseAttributeBuffers(useAttributeBuffers);
+    ITK_TRY_EXPECT_NO_EXCEPTION(serialMixedFilter->Update());
+    ITK_TRY_EXPECT_NO_EXCEPTION(parallelMixedFilter->Update());
+    const PolyDataType * serialMixedPolyData = serialMixedFilter->GetOutput();
+    const PolyDataType * parallelMixedPolyData = parallelMixedFilter->GetOutput();
+    ITK_TEST_EXPECT_EQUAL(parallelMixedPolyData->GetNumberOfVertices(), NumberOfMixedCells / 3);
+    ITK_TEST_EXPECT_EQUAL(parallelMixedPolyData->GetNumberOfLines(), NumberOfMixedCells / 3);
+    ITK_TEST_EXPECT_EQUAL(parallelMixedPolyData->GetNumberOfPolygons(), NumberOfMixedCells / 3);
+    const auto & mixedCellIds = parallelMixedFilter->GetInputCellIdentifiers()->CastToSTLConstContainer();
+    ITK_TEST_EXPECT_TRUE(mixedCellIds == serialMixedFilter->GetInputCellIdentifiers()->CastToSTLConstContainer());
+    ITK_TEST_EXPECT_EQUAL(mixedCellIds.size(), NumberOfMixedCells);
+    if (useAttributeBuffers)
+    {
+      ITK_TEST_EXPECT_TRUE(parallelMixedPolyData->GetCellDataBuffer()->CastToSTLConstContainer() ==
+                           serialMixedPolyData->GetCellDataBuffer()->CastToSTLConstContainer());
+    }
+    else
+    {
+      ITK_TEST_EXPECT_TRUE(parallelMixedPolyData->GetCellData()->CastToSTLConstContainer() ==
+                           serialMixedPolyData->GetCellData()->CastToSTLConstContainer());
+    }
+    for (itk::SizeValueType ii = 0; ii < mixedCellIds.size(); ++ii)
+    {
+      PolyDataType::CellPixelType mixedCellData = 0.0f;
+      ITK_TEST_EXPECT_TRUE(parallelMixedPolyData->GetCellData(ii, &mixedCellData));
+      // Vertices, then lines, then polygons, each in input order
+      const itk::SizeValueType expectedCellId = (ii % (NumberOfMixedCells / 3)) * 3 + ii / (NumberOfMixedCells / 3);
+      if (mixedCellIds[ii] != expectedCellId || mixedCellData != 0.5f + expectedCellId)
+      {
+        std::cerr << "Output cell " << ii << " of input cell " << mixedCellIds[ii] << " has cell data "
+                  << mixedCellData << ", expected input cell " << expectedCellId << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The counting pass sizes every cell array and the input cell identifiers
+  // exactly for a mix of vertices, polylines, lines and polygons
+  auto countedMesh = MeshType::New();
+  for (unsigned int pointId = 0; pointId < 8; ++pointId)
+  {
+    MeshType::PointType point;
+    point[0] = pointId % 2;
+    point[1] = pointId / 2;
+    point[2] = pointId / 4;
+    countedMesh->SetPoint(pointId, point);
+  }
+  using PolyLineCellType = itk::PolyLineCell<MeshType::CellType>;
+  using QuadrilateralCellType = itk::QuadrilateralCell<MeshType::CellType>;
+  const std::vector<std::vector<MeshType::PointIdentifier>> countedPointIds = {
+    { 0, 1, 3, 2 }, { 4 }, { 4, 5, 6 }, { 0, 1, 2 }, { 5, 6 }, { 7 }, { 6, 7 }
+  };
+  for (unsigned int cellId = 0; cellId < countedPointIds.size(); ++cellId)
+  {
+    MeshType::CellAutoPointer cell;
+    switch (cellId)
+    {
+      case 0:
+        cell.TakeOwnership(new QuadrilateralCellType);
+        break;
+      case 1:
+      case 5:
+        cell.TakeOwnership(new VertexCellType);
+        break;
+      case 2:
+        cell.TakeOwnership(new PolyLineCellType);
+        break;
+      case 3:
+        cell.TakeOwnership(new TriangleCellType);
+        break;
+      default:
+        cell.TakeOwnership(new LineCellType);
+        break;
+    }
+    cell->SetPointIds(countedPointIds[cellId].data(), countedPointIds[cellId].data() + countedPointIds[cellId].size());
+    countedMesh->SetCell(cellId, cell);
+    countedMesh->SetCellData(cellId, 10.0f + cellId);
+  }
+  auto countedFilter = FilterType::New();
+  countedFilter->SetInput(countedMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(countedFilter->Update());
+  const PolyDataType *        countedPolyData = countedFilter->GetOutput();
+  const std::vector<uint32_t> expectedCountedVertices = { 1, 4, 1, 7 };
+  const std::vector<uint32_t> expectedCountedLines = { 3, 4, 5, 6, 2, 5, 6, 2, 6, 7 };
+  const std::vector<uint32_t> expectedCountedPolygons = { 4, 0, 1, 3, 2, 3, 0, 1, 2 };
+  // Vertices, polylines, lines then polygons
+  const std::vector<FilterType::CellIdentifierElementType> expectedCountedCellIds = { 1, 5, 2, 4, 6, 0, 3 };
+
+  const std::vector<uint32_t> & countedVertices = countedPolyData->GetVertices()->CastToSTLConstContainer();
+  const std::vector<uint32_t> & countedLines = countedPolyData->GetLines()->CastToSTLConstContainer();
+  const std::vector<uint32_t> & countedPolygons = countedPolyData->GetPolygons()->CastToSTLConstContainer();
+  const auto &                  countedCellIds = countedFilter->GetInputCellIdentifiers()->CastToSTLConstContainer();
+  ITK_TEST_EXPECT_TRUE(countedVertices == expectedCountedVertices);
+  ITK_TEST_EXPECT_TRUE(countedLines == expectedCountedLines);
+  ITK_TEST_EXPECT_TRUE(countedPolygons == expectedCountedPolygons);
+  ITK_TEST_EXPECT_TRUE(countedCellIds == expectedCountedCellIds);
+  ITK_TEST_EXPECT_EQUAL(countedVertices.capacity(), countedVertices.size());
+  ITK_TEST_EXPECT_EQUAL(countedLines.capacity(), countedLines.size());
+  ITK_TEST_EXPECT_EQUAL(countedPolygons.capacity(), countedPolygons.size());
+  ITK_TEST_EXPECT_EQUAL(countedCellIds.capacity(), countedCellIds.size());
+  for (itk::SizeValueType ii = 0; ii < expectedCountedCellIds.size(); ++ii)
+  {
+    ITK_TEST_EXPECT_EQUAL(countedPolyData->GetCellData()->GetElement(ii), 10.0f + expectedCountedCellIds[ii]);
+  }
+
+  // Streaming mode delivers self-contained pieces
+  auto chunkFilter = FilterType::New();
+  chunkFilter->SetInput(triangleMesh);
+  chunkFilter->SetNumberOfCellsPerChunk(1);
+  ITK_TEST_SET_GET_VALUE(1, chunkFilter->GetNumberOfCellsPerChunk());
+  std::vector<PolyDataType::Pointer> pieces;
+  std::vector<itk::SizeValueType>    chunkIndices;
+  chunkFilter->SetChunkCallback([&pieces, &chunkIndices](PolyDataType * piece, itk::SizeValueType chunkIndex) {
+    pieces.push_back(piece);
+    chunkIndices.push_back(chunkIndex);
+  });
+  ITK_TRY_EXPECT_NO_EXCEPTION(chunkFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(pieces.size(), 2);
+  ITK_TEST_EXPECT_TRUE(chunkIndices == std::vector<itk::SizeValueType>({ 0, 1 }));
+  ITK_TEST_EXPECT_EQUAL(chunkFilter->GetOutput()->GetNumberOfPoints(), 0);
+  ITK_TEST_EXPECT_TRUE(chunkFilter->GetInputCellIdentifiers() == nullptr);
+  const std::vector<uint32_t> expectedPieceTriangle = { 3, 0, 1, 2 };
+  for (const auto & piece : pieces)
+  {
+    ITK_TEST_EXPECT_EQUAL(piece->GetNumberOfPoints(), 3);
+    ITK_TEST_EXPECT_TRUE(piece->GetPolygons()->CastToSTLConstContainer() == expectedPieceTriangle);
+    ITK_TEST_EXPECT_EQUAL(piece->GetCellData()->Size(), 1);
+  }
+  ITK_TEST_EXPECT_EQUAL(pieces[1]->GetPoint(1)[0], triangleMesh->GetPoint(3)[0]);
+  ITK_TEST_EXPECT_EQUAL(pieces[1]->GetPoint(1)[2], triangleMesh->GetPoint(3)[2]);
+
+  // Unused points are removed and the cells renumbered
+  auto sparseMesh = MeshType::New();
+  for (unsigned int pointId = 0; pointId < 4; ++pointId)
+  {
+    MeshType::PointType point;
+    point.Fill(static_cast<float>(pointId));
+    sparseMesh->SetPoint(pointId, point);
+    sparseMesh->SetPointData(pointId, 100.0f + pointId);
+  }
+  {
+    MeshType::CellAutoPointer cell;
+    cell.TakeOwnership(new TriangleCellType);
+    cell->SetPointId(0, 3);
+    cell->SetPointId(1, 1);
+    cell->SetPointId(2, 2);
+    sparseMesh->SetCell(0, cell);
+  }
+  auto compactFilter = FilterType::New();
+  compactFilter->SetInput(sparseMesh);
+  ITK_TEST_SET_GET_BOOLEAN(compactFilter, RemoveUnusedPoints, true);
+  compactFilter->RemoveUnusedPointsOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(compactFilter->Update());
+  const PolyDataType * compactPolyData = compactFilter->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(compactPolyData->GetNumberOfPoints(), 3);
+  const std::vector<uint32_t> expectedCompactTriangle = { 3, 2, 0, 1 };
+  ITK_TEST_EXPECT_TRUE(compactPolyData->GetPolygons()->CastToSTLConstContainer() == expectedCompactTriangle);
+  ITK_TEST_EXPECT_EQUAL(compactPolyData->GetPoint(0)[0], 1.0f);
+  ITK_TEST_EXPECT_EQUAL(compactPolyData->GetPointData()->Size(), 3);
+  ITK_TEST_EXPECT_EQUAL(compactPolyData->GetPointData()->GetElement(2), 103.0f);
+  ITK_TEST_EXPECT_TRUE(compactFilter->GetInputPointIdentifiers()->CastToSTLConstContainer() ==
+                       std::vector<uint32_t>({ 1, 2, 3 }));
+
+  // Two tetrahedra sharing a face produce the six faces of their boundary
+  auto tetrahedronMesh = MeshType::New();
+  for (unsigned int pointId = 0; pointId < 5; ++pointId)
+  {
+    MeshType::PointType point;
+    point[0] = pointId == 1 || pointId == 4;
+    point[1] = pointId == 2 || pointId == 4;
+    point[2] = pointId == 3 || pointId == 4;
+    tetrahedronMesh->SetPoint(pointId, point);
+  }
+  using TetrahedronCellType = itk::TetrahedronCell<MeshType::CellType>;
+  const MeshType::PointIdentifier tetrahedronPointIds[2][4] = { { 0, 1, 2, 3 }, { 1, 2, 3, 4 } };
+  for (unsigned int cellId = 0; cellId < 2; ++cellId)
+  {
+    MeshType::CellAutoPointer cell;
+    cell.TakeOwnership(new TetrahedronCellType);
+    for (unsigned int ii = 0; ii < 4; ++ii)
+    {
+      cell->SetPointId(ii, tetrahedronPointIds[cellId][ii]);
+    }
+    tetrahedronMesh->SetCell(cellId, cell);
+    tetrahedronMesh->SetCellData(cellId, 20.0f + cellId);
+  }
+  auto tetrahedronFilter = FilterType::New();
+  tetrahedronFilter->SetInput(tetrahedronMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(tetrahedronFilter->Update());
+  const PolyDataType *        boundaryPolyData = tetrahedronFilter->GetOutput();
+  const std::vector<uint32_t> expectedBoundary = { 3, 0, 1, 3, 3, 2, 0, 3, 3, 0, 2, 1,
+                                                   3, 1, 2, 4, 3, 2, 3, 4, 3, 3, 1, 4 };
+  ITK_TEST_EXPECT_TRUE(boundaryPolyData->GetPolygons()->CastToSTLConstContainer() == expectedBoundary);
+  ITK_TEST_EXPECT_EQUAL(boundaryPolyData->GetCellData()->Size(), 6);
+  ITK_TEST_EXPECT_EQUAL(boundaryPolyData->GetCellData()->GetElement(2), 20.0f);
+  ITK_TEST_EXPECT_EQUAL(boundaryPolyData->GetCellData()->GetElement(3), 21.0f);
+
+  // In streaming mode, the face shared by tetrahedra of different chunks is
+  // not output either
+  auto                               tetrahedronChunkFilter = FilterType::New();
+  std::vector<PolyDataType::Pointer> tetrahedronPieces;
+  tetrahedronChunkFilter->SetInput(tetrahedronMesh);
+  tetrahedronChunkFilter->SetNumberOfCellsPerChunk(1);
+  ITK_TRY_EXPECT_EXCEPTION(tetrahedronChunkFilter->Update());
+  tetrahedronChunkFilter->SetChunkCallback(
+    [&tetrahedronPieces](PolyDataType * piece, itk::SizeValueType) { tetrahedronPieces.push_back(piece); });
+  ITK_TRY_EXPECT_NO_EXCEPTION(tetrahedronChunkFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(tetrahedronPieces.size(), 2);
+  for (const auto & piece : tetrahedronPieces)
+  {
+    ITK_TEST_EXPECT_EQUAL(piece->GetNumberOfPolygons(), 3);
+    ITK_TEST_EXPECT_EQUAL(piece->GetNumberOfPoints(), 4);
+  }
+  ITK_TEST_EXPECT_EQUAL(tetrahedronPieces[1]->GetCellData()->GetElement(0), 21.0f);
+
+  // Meshes with fewer than 65535 points fit in 16-bit cell arrays
+  using NarrowPolyDataType = itk::PolyData<PixelType, PixelType, uint16_t>;
+  using NarrowFilterType = itk::MeshToPolyDataFilter<MeshType, NarrowPolyDataType>;
+  const itk::SizeValueType maximumCellIndexValue = FilterType::GetMaximumCellIndexValue(meshReader->GetOutput());
+  ITK_TEST_EXPECT_EQUAL(maximumCellIndexValue, 2903);
+  ITK_TEST_EXPECT_TRUE(NarrowPolyDataType::CanIndex(maximumCellIndexValue));
+  ITK_TEST_EXPECT_TRUE(!NarrowPolyDataType::CanIndex(70000));
+  ITK_TEST_EXPECT_TRUE(PolyDataType::CanIndex(70000));
+  const auto cellIndexSize = [](itk::SizeValueType maximumValue) {
+    return itk::CallWithNarrowestPolyDataType<PixelType, PixelType>(maximumValue, [](auto * polyData) {
+      return sizeof(typename std::remove_pointer_t<decltype(polyData)>::CellIndexType);
+    });
+  };
+  ITK_TEST_EXPECT_EQUAL(cellIndexSize(maximumCellIndexValue), 2);
+  ITK_TEST_EXPECT_EQUAL(cellIndexSize(70000), 4);
+
+  auto narrowFilter = NarrowFilterType::New();
+  narrowFilter->SetInput(meshReader->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(narrowFilter->Update());
+  const std::vector<uint16_t> & narrowPolygons = narrowFilter->GetOutput()->GetPolygons()->CastToSTLConstContainer();
+  const std::vector<uint32_t> & widePolygons = polyData->GetPolygons()->CastToSTLConstContainer();
+  ITK_TEST_EXPECT_TRUE(
+    std::equal(narrowPolygons.begin(), narrowPolygons.end(), widePolygons.begin(), widePolygons.end()));
+
+  // Point ids that do not fit are rejected
+  auto largeMesh = MeshType::New();
+  largeMesh->GetPoints()->resize(70000);
+  {
+    MeshType::CellAutoPointer cell;
+    cell.TakeOwnership(new TriangleCellType);
+    cell->SetPointId(0, 0);
+    cell->SetPointId(1, 1);
+    cell->SetPointId(2, 69999);
+    largeMesh->SetCell(0, cell);
+  }
+  narrowFilter->SetInput(largeMesh);
+  ITK_TRY_EXPECT_EXCEPTION(narrowFilter->Update());
+
+  // Empty cell slots are skipped
+  largeMesh->GetCells()->InsertElement(1, nullptr);
+  ITK_TEST_EXPECT_EQUAL(FilterType::GetMaximumCellIndexValue(largeMesh), 70000);
+
   using PolyDataToMeshFilterType = itk::PolyDataToMeshFilter<PolyDataType>;
   auto polyDataToMeshFilter = PolyDataToMeshFilterType::New();
   polyDataToMeshFilter->SetInput(polyData);
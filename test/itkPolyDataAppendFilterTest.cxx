@@ -0,0 +1,193 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolyDataAppendFilter.h"
+
+#include "itkTestingMacros.h"
+
+#include <vector>
+
+int
+itkPolyDataAppendFilterTest(int, char *[])
+{
+  using PolyDataType = itk::PolyData<float>;
+  using CellsContainer = PolyDataType::CellsContainer;
+  using FilterType = itk::PolyDataAppendFilter<PolyDataType>;
+
+  // A vertex, a line and a triangle on four points along x = 0
+  auto first = PolyDataType::New();
+  auto firstPoints = PolyDataType::PointsContainer::New();
+  for (unsigned int pointId = 0; pointId < 4; ++pointId)
+  {
+    PolyDataType::PointType point;
+    point.Fill(0.0f);
+    point[1] = pointId;
+    firstPoints->push_back(point);
+  }
+  auto firstVertices = CellsContainer::New();
+  firstVertices->CastToSTLContainer() = { 1, 3 };
+  auto firstLines = CellsContainer::New();
+  firstLines->CastToSTLContainer() = { 2, 0, 1 };
+  auto firstPolygons = CellsContainer::New();
+  firstPolygons->CastToSTLContainer() = { 3, 0, 1, 2 };
+  auto firstPointData = PolyDataType::PointDataContainer::New();
+  firstPointData->CastToSTLContainer() = { 10, 11, 12, 13 };
+  auto firstPointDataBuffer = PolyDataType::PointDataBufferType::New();
+  firstPointDataBuffer->CastToSTLContainer() = { 10, -10, 11, -11, 12, -12, 13, -13 };
+  auto firstCellData = PolyDataType::CellDataContainer::New();
+  firstCellData->CastToSTLContainer() = { 100, 101, 102 };
+  first->SetPoints(firstPoints);
+  first->SetVertices(firstVertices);
+  first->SetLines(firstLines);
+  first->SetPolygons(firstPolygons);
+  first->SetPointData(firstPointData);
+  first->SetPointDataBuffer(firstPointDataBuffer, 2);
+  first->SetCellData(firstCellData);
+
+  // Two polygons and a triangle strip on five points along x = 1
+  auto second = PolyDataType::New();
+  auto secondPoints = PolyDataType::PointsContainer::New();
+  for (unsigned int pointId = 0; pointId < 5; ++pointId)
+  {
+    PolyDataType::PointType point;
+    point.Fill(0.0f);
+    point[0] = 1.0f;
+    point[1] = pointId;
+    secondPoints->push_back(point);
+  }
+  auto secondPolygons = CellsContainer::New();
+  secondPolygons->CastToSTLContainer() = { 3, 0, 1, 2, 4, 1, 2, 3, 4 };
+  auto secondStrips = CellsContainer::New();
+  secondStrips->CastToSTLContainer() = { 4, 0, 1, 2, 3 };
+  auto secondPointData = PolyDataType::PointDataContainer::New();
+  secondPointData->CastToSTLContainer() = { 20, 21, 22, 23, 24 };
+  auto secondPointDataBuffer = PolyDataType::PointDataBufferType::New();
+  secondPointDataBuffer->CastToSTLContainer() = { 20, -20, 21, -21, 22, -22, 23, -23, 24, -24 };
+  auto secondCellData = PolyDataType::CellDataContainer::New();
+  secondCellData->CastToSTLContainer() = { 200, 201, 202 };
+  second->SetPoints(secondPoints);
+  second->SetPolygons(secondPolygons);
+  second->SetTriangleStrips(secondStrips);
+  second->SetPointData(secondPointData);
+  second->SetPointDataBuffer(secondPointDataBuffer, 2);
+  second->SetCellData(secondCellData);
+
+  auto filter = FilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, PolyDataAppendFilter, PolyDataToPolyDataFilter);
+
+  // The unset input 1 is skipped
+  filter->SetInput(0, first);
+  filter->SetInput(2, second);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  const PolyDataType * output = filter->GetOutput();
+
+  ITK_TEST_EXPECT_EQUAL(output->GetNumberOfPoints(), 9u);
+  ITK_TEST_EXPECT_EQUAL(output->GetPoint(3)[1], 3.0f);
+  ITK_TEST_EXPECT_EQUAL(output->GetPoint(4)[0], 1.0f);
+  ITK_TEST_EXPECT_EQUAL(output->GetPoint(8)[1], 4.0f);
+
+  // The point ids of the second input are offset by the points of the first
+  ITK_TEST_EXPECT_TRUE(output->GetVertices()->CastToSTLConstContainer() == std::vector<uint32_t>({ 1, 3 }));
+  ITK_TEST_EXPECT_TRUE(output->GetLines()->CastToSTLConstContainer() == std::vector<uint32_t>({ 2, 0, 1 }));
+  ITK_TEST_EXPECT_TRUE(output->GetPolygons()->CastToSTLConstContainer() ==
+                       std::vector<uint32_t>({ 3, 0, 1, 2, 3, 4, 5, 6, 4, 5, 6, 7, 8 }));
+  ITK_TEST_EXPECT_TRUE(output->GetTriangleStrips()->CastToSTLConstContainer() ==
+                       std::vector<uint32_t>({ 4, 4, 5, 6, 7 }));
+
+  // The cell data follows the vertices, lines, polygons and strips of all
+  // the inputs
+  ITK_TEST_EXPECT_TRUE(output->GetPointData()->CastToSTLConstContainer() ==
+                       std::vector<float>({ 10, 11, 12, 13, 20, 21, 22, 23, 24 }));
+  ITK_TEST_EXPECT_EQUAL(output->GetNumberOfPointDataComponents(), 2u);
+  ITK_TEST_EXPECT_EQUAL(output->GetPointDataBuffer()->Size(), 18u);
+  ITK_TEST_EXPECT_EQUAL(output->GetPointDataBuffer()->ElementAt(9), -20.0f);
+  ITK_TEST_EXPECT_TRUE(output->GetCellData()->CastToSTLConstContainer() ==
+                       std::vector<float>({ 100, 101, 102, 200, 201, 202 }));
+  ITK_TEST_EXPECT_TRUE(output->GetCellDataBuffer() == nullptr);
+
+  // The point data is dropped when an input with points does not have it
+  auto third = PolyDataType::New();
+  auto thirdPoints = PolyDataType::PointsContainer::New();
+  thirdPoints->CastToSTLContainer().resize(2);
+  auto thirdLines = CellsContainer::New();
+  thirdLines->CastToSTLContainer() = { 2, 1, 0 };
+  third->SetPoints(thirdPoints);
+  third->SetLines(thirdLines);
+  filter->AddInput(third);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(output->GetNumberOfPoints(), 11u);
+  ITK_TEST_EXPECT_TRUE(output->GetLines()->CastToSTLConstContainer() == std::vector<uint32_t>({ 2, 0, 1, 2, 10, 9 }));
+  ITK_TEST_EXPECT_TRUE(output->GetPointData() == nullptr);
+  ITK_TEST_EXPECT_TRUE(output->GetPointDataBuffer() == nullptr);
+  ITK_TEST_EXPECT_TRUE(output->GetCellData() == nullptr);
+
+  // Inputs larger than a block are copied by several tasks
+  constexpr uint32_t NumberOfVertices = 200000;
+  auto               large = PolyDataType::New();
+  auto               largePoints = PolyDataType::PointsContainer::New();
+  auto               largeVertices = CellsContainer::New();
+  auto               largeVertexData = PolyDataType::CellDataContainer::New();
+  for (uint32_t pointId = 0; pointId < NumberOfVertices; ++pointId)
+  {
+    PolyDataType::PointType point;
+    point.Fill(0.0f);
+    point[0] = 3.0f;
+    point[1] = pointId;
+    largePoints->push_back(point);
+    largeVertices->CastToSTLContainer().insert(largeVertices->CastToSTLContainer().end(), { 1, pointId });
+    largeVertexData->push_back(static_cast<float>(pointId));
+  }
+  large->SetPoints(largePoints);
+  large->SetVertices(largeVertices);
+  large->SetCellData(largeVertexData);
+  auto largeFilter = FilterType::New();
+  largeFilter->AddInput(first);
+  largeFilter->AddInput(large);
+  largeFilter->SetNumberOfWorkUnits(3);
+  ITK_TRY_EXPECT_NO_EXCEPTION(largeFilter->Update());
+  const PolyDataType * largeOutput = largeFilter->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(largeOutput->GetNumberOfPoints(), NumberOfVertices + 4);
+  ITK_TEST_EXPECT_EQUAL(largeOutput->GetNumberOfVertices(), NumberOfVertices + 1);
+  const std::vector<uint32_t> & appendedVertices = largeOutput->GetVertices()->CastToSTLConstContainer();
+  bool                          verticesMatch = appendedVertices.size() == 2 * (NumberOfVertices + 1);
+  for (uint32_t pointId = 0; verticesMatch && pointId < NumberOfVertices; ++pointId)
+  {
+    verticesMatch =
+      appendedVertices[2 * (pointId + 1)] == 1 && appendedVertices[2 * (pointId + 1) + 1] == pointId + 4;
+  }
+  ITK_TEST_EXPECT_TRUE(verticesMatch);
+  const std::vector<float> & largeCellData = largeOutput->GetCellData()->CastToSTLConstContainer();
+  ITK_TEST_EXPECT_EQUAL(largeCellData.size(), NumberOfVertices + 3);
+  ITK_TEST_EXPECT_EQUAL(largeCellData[0], 100.0f);
+  ITK_TEST_EXPECT_EQUAL(largeCellData[NumberOfVertices], NumberOfVertices - 1.0f);
+  ITK_TEST_EXPECT_EQUAL(largeCellData[NumberOfVertices + 1], 101.0f);
+  ITK_TEST_EXPECT_EQUAL(largeOutput->GetPoint(NumberOfVertices + 3)[1], NumberOfVertices - 1.0f);
+
+  // Cells that use points their input does not have are rejected
+  auto invalid = PolyDataType::New();
+  auto invalidPoints = PolyDataType::PointsContainer::New();
+  invalidPoints->CastToSTLContainer().resize(3);
+  auto invalidPolygons = CellsContainer::New();
+  invalidPolygons->CastToSTLContainer() = { 3, 0, 1, 3 };
+  invalid->SetPoints(invalidPoints);
+  invalid->SetPolygons(invalidPolygons);
+  filter->AddInput(invalid);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,237 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolyData.h"
+#include "itkPolyDataBinaryFileReader.h"
+#include "itkPolyDataBinaryFileWriter.h"
+
+#include "itkTestingMacros.h"
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+int
+itkPolyDataBinaryFileWriterTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputFileName" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = argv[1];
+
+  using PolyDataType = itk::PolyData<float>;
+  using CellsContainer = PolyDataType::CellsContainer;
+
+  constexpr unsigned int GridSize = 50;
+  PolyDataType::Pointer  polyData = PolyDataType::New();
+  auto                   points = PolyDataType::PointsContainer::New();
+  auto                   pointData = PolyDataType::PointDataContainer::New();
+  for (unsigned int row = 0; row < GridSize; ++row)
+  {
+    for (unsigned int column = 0; column < GridSize; ++column)
+    {
+      PolyDataType::PointType point;
+      point[0] = column * 0.5f;
+      point[1] = row * 0.25f;
+      point[2] = static_cast<float>(row * column) / GridSize;
+      points->push_back(point);
+      pointData->push_back(row - 0.5f * column);
+    }
+  }
+  polyData->SetPoints(points);
+  polyData->SetPointData(pointData);
+
+  auto polygons = CellsContainer::New();
+  auto cellData = PolyDataType::CellDataBufferType::New();
+  for (unsigned int row = 0; row + 1 < GridSize; ++row)
+  {
+    for (unsigned int column = 0; column + 1 < GridSize; ++column)
+    {
+      const uint32_t corner = row * GridSize + column;
+      for (uint32_t id : { 4u, corner, corner + 1, corner + GridSize + 1, corner + GridSize })
+      {
+        polygons->push_back(id);
+      }
+      cellData->push_back(static_cast<float>(row));
+      cellData->push_back(static_cast<float>(column));
+    }
+  }
+  polyData->SetPolygons(polygons);
+  polyData->SetCellDataBuffer(cellData, 2);
+  auto lines = CellsContainer::New();
+  for (uint32_t id : { 3u, 0u, GridSize - 1, GridSize * GridSize - 1 })
+  {
+    lines->push_back(id);
+  }
+  polyData->SetLines(lines);
+
+  using WriterType = itk::PolyDataBinaryFileWriter<PolyDataType>;
+  WriterType::Pointer writer = WriterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(writer, PolyDataBinaryFileWriter, Object);
+
+  ITK_TRY_EXPECT_EXCEPTION(writer->Write());
+  writer->SetInput(polyData);
+  ITK_TEST_SET_GET_VALUE(polyData.GetPointer(), writer->GetInput());
+  ITK_TRY_EXPECT_EXCEPTION(writer->Write());
+  writer->SetFileName(fileName);
+  ITK_TEST_SET_GET_VALUE(fileName, std::string(writer->GetFileName()));
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Write());
+
+  using ReaderType = itk::PolyDataBinaryFileReader<PolyDataType>;
+  ReaderType::Pointer reader = ReaderType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(reader, PolyDataBinaryFileReader, Object);
+
+  ITK_TRY_EXPECT_EXCEPTION(reader->Read());
+  reader->SetFileName(fileName);
+  ITK_TEST_SET_GET_VALUE(fileName, std::string(reader->GetFileName()));
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Read());
+  PolyDataType * output = reader->GetOutput();
+
+  ITK_TEST_EXPECT_EQUAL(output->GetNumberOfPoints(), points->Size());
+  for (PolyDataType::PointIdentifier id = 0; id < points->Size(); ++id)
+  {
+    ITK_TEST_EXPECT_EQUAL(output->GetPoint(id), points->ElementAt(id));
+  }
+  ITK_TEST_EXPECT_EQUAL(output->GetVertices()->Size(), 0u);
+  ITK_TEST_EXPECT_TRUE(output->GetLines()->CastToSTLConstContainer() == lines->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(output->GetPolygons()->CastToSTLConstContainer() == polygons->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_EQUAL(output->GetTriangleStrips()->Size(), 0u);
+
+  // The container of point data is written as a flat buffer
+  ITK_TEST_EXPECT_EQUAL(output->GetNumberOfPointDataComponents(), 1u);
+  ITK_TEST_EXPECT_TRUE(output->GetPointDataBuffer()->CastToSTLConstContainer() ==
+                       pointData->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_EQUAL(output->GetNumberOfCellDataComponents(), 2u);
+  ITK_TEST_EXPECT_TRUE(output->GetCellDataBuffer()->CastToSTLConstContainer() == cellData->CastToSTLConstContainer());
+
+  // The named arrays round trip with their own component types
+  auto displacements = PolyDataType::AttributeArrayType<double>::New();
+  auto pointIds = PolyDataType::AttributeArrayType<uint64_t>::New();
+  for (itk::SizeValueType id = 0; id < points->Size(); ++id)
+  {
+    displacements->push_back(0.5 * id);
+    displacements->push_back(-0.25 * id);
+    pointIds->push_back(id << 40);
+  }
+  auto regions = PolyDataType::AttributeArrayType<int16_t>::New();
+  for (itk::SizeValueType cellId = 0; cellId < polyData->GetNumberOfLines() + polyData->GetNumberOfPolygons();
+       ++cellId)
+  {
+    regions->push_back(static_cast<int16_t>(-static_cast<int>(cellId % 1000)));
+  }
+  polyData->SetPointDataArray("Displacements", displacements.GetPointer(), 2);
+  polyData->SetPointDataArray("Point Ids", pointIds.GetPointer());
+  polyData->SetCellDataArray("Region", regions.GetPointer());
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Write());
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Read());
+  output = reader->GetOutput();
+  ITK_TEST_EXPECT_TRUE(output->GetPointDataArrayNames() == polyData->GetPointDataArrayNames());
+  ITK_TEST_EXPECT_TRUE(output->GetCellDataArrayNames() == PolyDataType::AttributeArrayNamesType({ "Region" }));
+  ITK_TEST_EXPECT_EQUAL(output->GetPointDataArrayNumberOfComponents("Displacements"), 2u);
+  ITK_TEST_EXPECT_TRUE(output->GetPointDataArray<double>("Displacements")->CastToSTLConstContainer() ==
+                       displacements->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(output->GetPointDataArray<uint64_t>("Point Ids")->CastToSTLConstContainer() ==
+                       pointIds->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(output->GetCellDataArray<int16_t>("Region")->CastToSTLConstContainer() ==
+                       regions->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(output->GetPointDataBuffer()->CastToSTLConstContainer() ==
+                       pointData->CastToSTLConstContainer());
+  polyData->SetPointDataArray<double>("Displacements", nullptr);
+  polyData->SetPointDataArray<uint64_t>("Point Ids", nullptr);
+  polyData->SetCellDataArray<int16_t>("Region", nullptr);
+
+  // An empty PolyData round trips
+  auto emptyPolyData = PolyDataType::New();
+  writer->SetInput(emptyPolyData);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Write());
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Read());
+  ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetNumberOfPoints(), 0u);
+  ITK_TEST_EXPECT_TRUE(reader->GetOutput()->GetPointDataBuffer() == nullptr);
+  writer->SetInput(polyData);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Write());
+
+  // The cell arrays are not converted to another index type
+  using NarrowPolyDataType = itk::PolyData<float, float, uint16_t>;
+  auto narrowReader = itk::PolyDataBinaryFileReader<NarrowPolyDataType>::New();
+  narrowReader->SetFileName(fileName);
+  ITK_TRY_EXPECT_EXCEPTION(narrowReader->Read());
+
+  // Truncated files and files of another format are rejected, and leave the
+  // output unchanged
+  std::vector<char> contents;
+  {
+    std::ifstream stream(fileName, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+  }
+  const std::string otherFileName = fileName + ".other";
+  {
+    std::ofstream stream(otherFileName, std::ios::binary);
+    stream.write(contents.data(), contents.size() - 1);
+  }
+  PolyDataType::Pointer previousOutput = reader->GetOutput();
+  reader->SetFileName(otherFileName);
+  ITK_TRY_EXPECT_EXCEPTION(reader->Read());
+  ITK_TEST_EXPECT_EQUAL(reader->GetOutput(), previousOutput.GetPointer());
+  {
+    std::ofstream stream(otherFileName, std::ios::binary);
+    stream.write(contents.data() + 1, contents.size() - 1);
+  }
+  ITK_TRY_EXPECT_EXCEPTION(reader->Read());
+
+  // Other versions, records with the wrong number of components, cells that
+  // overrun their array and point ids past the last point are rejected
+  const auto writeCorrupted = [&contents, &otherFileName](itk::SizeValueType position, uint32_t value) {
+    std::vector<char> corrupted = contents;
+    for (unsigned int byte = 0; byte < 4; ++byte)
+    {
+      corrupted[position + byte] = static_cast<char>(value >> (8 * byte));
+    }
+    std::ofstream stream(otherFileName, std::ios::binary);
+    stream.write(corrupted.data(), corrupted.size());
+  };
+  const itk::SizeValueType pointsRecord = WriterType::HeaderSize + WriterType::PointsArray * WriterType::RecordSize;
+  const itk::SizeValueType polygonsRecord = WriterType::HeaderSize + WriterType::PolygonsArray * WriterType::RecordSize;
+  itk::SizeValueType       polygonsOffset = 0;
+  for (unsigned int byte = 0; byte < 8; ++byte)
+  {
+    polygonsOffset |= static_cast<itk::SizeValueType>(static_cast<uint8_t>(contents[polygonsRecord + byte]))
+                      << (8 * byte);
+  }
+  writeCorrupted(4, WriterType::Version + 1);
+  ITK_TRY_EXPECT_EXCEPTION(reader->Read());
+  writeCorrupted(pointsRecord + 16, 1);
+  ITK_TRY_EXPECT_EXCEPTION(reader->Read());
+  writeCorrupted(polygonsRecord + 16, 5);
+  ITK_TRY_EXPECT_EXCEPTION(reader->Read());
+  writeCorrupted(polygonsOffset, static_cast<uint32_t>(polygons->Size()));
+  ITK_TRY_EXPECT_EXCEPTION(reader->Read());
+  writeCorrupted(polygonsOffset + sizeof(uint32_t), static_cast<uint32_t>(points->Size()));
+  ITK_TRY_EXPECT_EXCEPTION(reader->Read());
+  ITK_TEST_EXPECT_EQUAL(reader->GetOutput(), previousOutput.GetPointer());
+  writeCorrupted(polygonsOffset + sizeof(uint32_t), static_cast<uint32_t>(points->Size() - 1));
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Read());
+
+  reader->SetFileName(fileName + ".missing");
+  ITK_TRY_EXPECT_EXCEPTION(reader->Read());
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,232 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolyData.h"
+#include "itkPolyDataDecoder.h"
+#include "itkPolyDataEncoder.h"
+
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+int
+itkPolyDataEncoderTest(int, char *[])
+{
+  using PixelType = float;
+  using PolyDataType = itk::PolyData<PixelType>;
+  using CellsContainer = PolyDataType::CellsContainer;
+
+  // A grid of triangles with enough points and cells to span several blocks
+  constexpr unsigned int GridSize = 300;
+  PolyDataType::Pointer  polyData = PolyDataType::New();
+
+  auto points = PolyDataType::PointsContainer::New();
+  auto pointData = PolyDataType::PointDataContainer::New();
+  for (unsigned int row = 0; row < GridSize; ++row)
+  {
+    for (unsigned int column = 0; column < GridSize; ++column)
+    {
+      PolyDataType::PointType point;
+      point[0] = column * 0.5f;
+      point[1] = row * 0.25f;
+      point[2] = std::sin(column * 0.1f) * 10.0f;
+      points->push_back(point);
+      pointData->push_back(std::cos(row * 0.05f) * 100.0f);
+    }
+  }
+  polyData->SetPoints(points);
+  polyData->SetPointData(pointData);
+
+  auto polygons = CellsContainer::New();
+  auto cellData = PolyDataType::CellDataContainer::New();
+  for (unsigned int row = 0; row + 1 < GridSize; ++row)
+  {
+    for (unsigned int column = 0; column + 1 < GridSize; ++column)
+    {
+      const uint32_t corner = row * GridSize + column;
+      for (uint32_t id :
+           { 3u, corner, corner + 1, corner + GridSize + 1, 3u, corner, corner + GridSize + 1, corner + GridSize })
+      {
+        polygons->push_back(id);
+      }
+      cellData->push_back(static_cast<PixelType>(cellData->size()) + 0.125f);
+      cellData->push_back(static_cast<PixelType>(cellData->size()) + 0.125f);
+    }
+  }
+  polyData->SetPolygons(polygons);
+  polyData->SetCellData(cellData);
+
+  auto vertices = CellsContainer::New();
+  for (uint32_t id : { 1u, 0u, 1u, GridSize * GridSize - 1 })
+  {
+    vertices->push_back(id);
+  }
+  polyData->SetVertices(vertices);
+  auto lines = CellsContainer::New();
+  for (uint32_t id : { 3u, 0u, GridSize - 1, GridSize * GridSize - 1 })
+  {
+    lines->push_back(id);
+  }
+  polyData->SetLines(lines);
+
+  using EncoderType = itk::PolyDataEncoder<PolyDataType>;
+  EncoderType::Pointer encoder = EncoderType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(encoder, PolyDataEncoder, Object);
+
+  ITK_TRY_EXPECT_EXCEPTION(encoder->Encode());
+
+  encoder->SetInput(polyData);
+  ITK_TEST_SET_GET_VALUE(polyData.GetPointer(), encoder->GetInput());
+  constexpr double ErrorBound = 0.01;
+  encoder->SetPointDataErrorBound(-1.0);
+  ITK_TRY_EXPECT_EXCEPTION(encoder->Encode());
+  encoder->SetPointDataErrorBound(ErrorBound);
+  ITK_TEST_SET_GET_VALUE(ErrorBound, encoder->GetPointDataErrorBound());
+  ITK_TRY_EXPECT_NO_EXCEPTION(encoder->Encode());
+  const EncoderType::EncodedDataType encodedData = encoder->GetEncodedData();
+
+  const size_t rawSize = points->size() * sizeof(PolyDataType::PointType) +
+                         (vertices->size() + lines->size() + polygons->size()) * sizeof(uint32_t) +
+                         (pointData->size() + cellData->size()) * sizeof(PixelType);
+  std::cout << "Encoded " << rawSize << " bytes into " << encodedData.size() << " bytes" << std::endl;
+  ITK_TEST_EXPECT_TRUE(encodedData.size() < rawSize / 2);
+
+  // The encoded data do not depend on the number of work units
+  encoder->GetMultiThreader()->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(encoder->Encode());
+  ITK_TEST_EXPECT_TRUE(encoder->GetEncodedData() == encodedData);
+
+  using DecoderType = itk::PolyDataDecoder<PolyDataType>;
+  DecoderType::Pointer decoder = DecoderType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(decoder, PolyDataDecoder, Object);
+
+  ITK_TRY_EXPECT_EXCEPTION(decoder->Decode());
+
+  decoder->SetEncodedData(encodedData);
+  ITK_TRY_EXPECT_NO_EXCEPTION(decoder->Decode());
+  PolyDataType * decoded = decoder->GetOutput();
+
+  ITK_TEST_EXPECT_EQUAL(decoded->GetNumberOfPoints(), polyData->GetNumberOfPoints());
+  const double extents[3] = { (GridSize - 1) * 0.5, (GridSize - 1) * 0.25, 20.0 };
+  for (PolyDataType::PointIdentifier id = 0; id < polyData->GetNumberOfPoints(); ++id)
+  {
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      const double error = std::abs(decoded->GetPoint(id)[dim] - polyData->GetPoint(id)[dim]);
+      if (error > extents[dim] / 131070.0 + 1e-4)
+      {
+        std::cerr << "Point " << id << " coordinate " << dim << " has an error of " << error << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  ITK_TEST_EXPECT_TRUE(decoded->GetVertices()->CastToSTLConstContainer() == vertices->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(decoded->GetLines()->CastToSTLConstContainer() == lines->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(decoded->GetPolygons()->CastToSTLConstContainer() == polygons->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_EQUAL(decoded->GetTriangleStrips()->Size(), 0);
+
+  ITK_TEST_EXPECT_EQUAL(decoded->GetNumberOfPointDataComponents(), 1);
+  for (PolyDataType::PointIdentifier id = 0; id < polyData->GetNumberOfPoints(); ++id)
+  {
+    PixelType pixel;
+    ITK_TEST_EXPECT_TRUE(decoded->GetPointData(id, &pixel));
+    if (std::abs(pixel - pointData->ElementAt(id)) > ErrorBound + 1e-4)
+    {
+      std::cerr << "Point data " << id << " has an error of " << std::abs(pixel - pointData->ElementAt(id))
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  ITK_TEST_EXPECT_EQUAL(decoded->GetNumberOfCellDataComponents(), 1);
+  ITK_TEST_EXPECT_TRUE(decoded->GetCellDataBuffer()->CastToSTLConstContainer() ==
+                       cellData->CastToSTLConstContainer());
+
+  // Without an error bound, the point data are stored losslessly
+  encoder->SetPointDataErrorBound(0.0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(encoder->Encode());
+  const EncoderType::EncodedDataType losslessData = encoder->GetEncodedData();
+  decoder->SetEncodedData(losslessData);
+  ITK_TRY_EXPECT_NO_EXCEPTION(decoder->Decode());
+  ITK_TEST_EXPECT_TRUE(decoder->GetOutput()->GetPointDataBuffer()->CastToSTLConstContainer() ==
+                       pointData->CastToSTLConstContainer());
+
+  // A point moved through the STL container, which leaves the cached bounds
+  // of the PolyData stale, is quantized in the bounds of the moved points
+  const float maximumZ = polyData->GetBounds()[5];
+  points->CastToSTLContainer()[0][2] = 100.0f;
+  ITK_TEST_EXPECT_EQUAL(polyData->GetBounds()[5], maximumZ);
+  encoder->SetPointDataErrorBound(0.0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(encoder->Encode());
+  decoder->SetEncodedData(encoder->GetEncodedData());
+  ITK_TRY_EXPECT_NO_EXCEPTION(decoder->Decode());
+  const double movedError = std::abs(decoder->GetOutput()->GetPoint(0)[2] - 100.0);
+  ITK_TEST_EXPECT_TRUE(movedError <= 110.0 / 131070.0 + 1e-4);
+  points->CastToSTLContainer()[0][2] = 0.0f;
+
+  // The named arrays are stored losslessly with their own component types
+  auto normals = PolyDataType::AttributeArrayType<float>::New();
+  for (PolyDataType::PointIdentifier id = 0; id < polyData->GetNumberOfPoints(); ++id)
+  {
+    normals->push_back(std::sin(id * 0.01f));
+    normals->push_back(std::cos(id * 0.01f));
+    normals->push_back(0.0f);
+  }
+  auto labels = PolyDataType::AttributeArrayType<uint8_t>::New();
+  for (itk::SizeValueType cellId = 0; cellId < 2 + polygons->size() / 4; ++cellId)
+  {
+    labels->push_back(static_cast<uint8_t>(cellId % 7));
+  }
+  auto emptyLabels = PolyDataType::AttributeArrayType<int32_t>::New();
+  polyData->SetPointDataArray("Normals", normals.GetPointer(), 3);
+  polyData->SetCellDataArray("Labels", labels.GetPointer());
+  polyData->SetCellDataArray("Empty", emptyLabels.GetPointer());
+  ITK_TRY_EXPECT_NO_EXCEPTION(encoder->Encode());
+  decoder->SetEncodedData(encoder->GetEncodedData());
+  ITK_TRY_EXPECT_NO_EXCEPTION(decoder->Decode());
+  decoded = decoder->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(decoded->GetPointDataArrayNumberOfComponents("Normals"), 3u);
+  ITK_TEST_EXPECT_TRUE(decoded->GetPointDataArray<float>("Normals")->CastToSTLConstContainer() ==
+                       normals->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(decoded->GetCellDataArray<uint8_t>("Labels")->CastToSTLConstContainer() ==
+                       labels->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_EQUAL(decoded->GetCellDataArray<int32_t>("Empty")->Size(), 0u);
+  polyData->SetPointDataArray<float>("Normals", nullptr);
+  polyData->SetCellDataArray<uint8_t>("Labels", nullptr);
+  polyData->SetCellDataArray<int32_t>("Empty", nullptr);
+
+  // Truncated and corrupted data are rejected
+  decoder->SetEncodedData(losslessData.data(), losslessData.size() / 2);
+  ITK_TRY_EXPECT_EXCEPTION(decoder->Decode());
+  EncoderType::EncodedDataType corruptedData = losslessData;
+  corruptedData[0] = 0;
+  decoder->SetEncodedData(corruptedData);
+  ITK_TRY_EXPECT_EXCEPTION(decoder->Decode());
+
+  // An empty PolyData round trips
+  encoder->SetInput(PolyDataType::New());
+  ITK_TRY_EXPECT_NO_EXCEPTION(encoder->Encode());
+  decoder->SetEncodedData(encoder->GetEncodedData());
+  ITK_TRY_EXPECT_NO_EXCEPTION(decoder->Decode());
+  ITK_TEST_EXPECT_EQUAL(decoder->GetOutput()->GetNumberOfPoints(), 0);
+  ITK_TEST_EXPECT_EQUAL(decoder->GetOutput()->GetPolygons()->Size(), 0);
+
+  return EXIT_SUCCESS;
+}
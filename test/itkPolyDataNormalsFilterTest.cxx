@@ -0,0 +1,192 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolyDataNormalsFilter.h"
+
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+int
+itkPolyDataNormalsFilterTest(int, char *[])
+{
+  using PolyDataType = itk::PolyData<float>;
+  using CellsContainer = PolyDataType::CellsContainer;
+  using FilterType = itk::PolyDataNormalsFilter<PolyDataType>;
+  using NormalsArrayType = FilterType::NormalsArrayType;
+
+  // A quadrilateral and a triangle strip in the z = 0 plane, a vertex on a
+  // point no polygon uses, and a line
+  auto        flatPolyData = PolyDataType::New();
+  auto        flatPoints = PolyDataType::PointsContainer::New();
+  const float flatCoordinates[][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 2, 0, 0 }, { 0, 1, 0 },
+                                       { 1, 1, 0 }, { 2, 1, 0 }, { 5, 5, 5 } };
+  for (const auto & coordinates : flatCoordinates)
+  {
+    flatPoints->push_back(PolyDataType::PointType(coordinates));
+  }
+  auto flatVertices = CellsContainer::New();
+  flatVertices->CastToSTLContainer() = { 1, 6 };
+  auto flatLines = CellsContainer::New();
+  flatLines->CastToSTLContainer() = { 2, 0, 5 };
+  auto flatPolygons = CellsContainer::New();
+  flatPolygons->CastToSTLContainer() = { 4, 0, 1, 4, 3 };
+  auto flatStrips = CellsContainer::New();
+  flatStrips->CastToSTLContainer() = { 4, 1, 2, 4, 5 };
+  flatPolyData->SetPoints(flatPoints);
+  flatPolyData->SetVertices(flatVertices);
+  flatPolyData->SetLines(flatLines);
+  flatPolyData->SetPolygons(flatPolygons);
+  flatPolyData->SetTriangleStrips(flatStrips);
+
+  auto filter = FilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, PolyDataNormalsFilter, PolyDataToPolyDataFilter);
+
+  ITK_TEST_SET_GET_BOOLEAN(filter, ComputePointNormals, true);
+  ITK_TEST_SET_GET_BOOLEAN(filter, ComputeCellNormals, true);
+  const std::string normalsArrayName = "Normals";
+  ITK_TEST_SET_GET_VALUE(normalsArrayName, std::string(filter->GetNormalsArrayName()));
+
+  filter->SetInput(flatPolyData);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  const PolyDataType * output = filter->GetOutput();
+
+  // The output shares the containers of the input, which is not modified
+  ITK_TEST_EXPECT_EQUAL(output->GetPoints(), flatPolyData->GetPoints());
+  ITK_TEST_EXPECT_EQUAL(output->GetPolygons(), flatPolyData->GetPolygons());
+  ITK_TEST_EXPECT_TRUE(flatPolyData->GetPointDataArrayNames().empty());
+
+  ITK_TEST_EXPECT_EQUAL(output->GetPointDataArrayNumberOfComponents("Normals"), 3u);
+  const NormalsArrayType * pointNormals = output->GetPointDataArray<float>("Normals");
+  ITK_TEST_EXPECT_TRUE(pointNormals != nullptr);
+  const std::vector<float> expectedPointNormals = { 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 0 };
+  ITK_TEST_EXPECT_TRUE(pointNormals->CastToSTLConstContainer() == expectedPointNormals);
+
+  ITK_TEST_EXPECT_EQUAL(output->GetCellDataArrayNumberOfComponents("Normals"), 3u);
+  const NormalsArrayType * cellNormals = output->GetCellDataArray<float>("Normals");
+  ITK_TEST_EXPECT_TRUE(cellNormals != nullptr);
+  const std::vector<float> expectedCellNormals = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1 };
+  ITK_TEST_EXPECT_TRUE(cellNormals->CastToSTLConstContainer() == expectedCellNormals);
+
+  // The normals of the points shared by two faces are the normalized sum of
+  // the face normals
+  auto        cornerPolyData = PolyDataType::New();
+  auto        cornerPoints = PolyDataType::PointsContainer::New();
+  const float cornerCoordinates[][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+  for (const auto & coordinates : cornerCoordinates)
+  {
+    cornerPoints->push_back(PolyDataType::PointType(coordinates));
+  }
+  auto cornerPolygons = CellsContainer::New();
+  cornerPolygons->CastToSTLContainer() = { 3, 0, 1, 2, 3, 0, 2, 3 };
+  cornerPolyData->SetPoints(cornerPoints);
+  cornerPolyData->SetPolygons(cornerPolygons);
+  filter->SetInput(cornerPolyData);
+  filter->ComputeCellNormalsOff();
+  filter->SetNormalsArrayName("CornerNormals");
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_TRUE(output->GetCellDataArrayNames().empty());
+  pointNormals = output->GetPointDataArray<float>("CornerNormals");
+  ITK_TEST_EXPECT_TRUE(pointNormals != nullptr);
+  const float                           halfSqrt2 = static_cast<float>(std::sqrt(0.5));
+  const std::vector<std::vector<float>> expectedCornerNormals = {
+    { halfSqrt2, 0, halfSqrt2 }, { 0, 0, 1 }, { halfSqrt2, 0, halfSqrt2 }, { 1, 0, 0 }
+  };
+  for (unsigned int pointId = 0; pointId < 4; ++pointId)
+  {
+    for (unsigned int ii = 0; ii < 3; ++ii)
+    {
+      ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(pointNormals->ElementAt(3 * pointId + ii),
+                                                       expectedCornerNormals[pointId][ii],
+                                                       10,
+                                                       1e-6f));
+    }
+  }
+
+  // The normals do not depend on the number of work units
+  constexpr unsigned int GridSize = 64;
+  auto                   gridPolyData = PolyDataType::New();
+  auto                   gridPoints = PolyDataType::PointsContainer::New();
+  auto                   gridPolygons = CellsContainer::New();
+  auto                   gridStrips = CellsContainer::New();
+  for (unsigned int row = 0; row < GridSize; ++row)
+  {
+    for (unsigned int column = 0; column < GridSize; ++column)
+    {
+      PolyDataType::PointType point;
+      point[0] = column;
+      point[1] = row;
+      point[2] = static_cast<float>(std::sin(0.3 * column) * std::cos(0.2 * row));
+      gridPoints->push_back(point);
+      if (row + 1 < GridSize && column + 1 < GridSize)
+      {
+        const uint32_t corner = row * GridSize + column;
+        if (row % 2)
+        {
+          gridStrips->CastToSTLContainer().insert(gridStrips->CastToSTLContainer().end(),
+                                                  { 4, corner, corner + 1, corner + GridSize, corner + GridSize + 1 });
+        }
+        else
+        {
+          gridPolygons->CastToSTLContainer().insert(
+            gridPolygons->CastToSTLContainer().end(),
+            { 4, corner, corner + 1, corner + GridSize + 1, corner + GridSize });
+        }
+      }
+    }
+  }
+  gridPolyData->SetPoints(gridPoints);
+  gridPolyData->SetPolygons(gridPolygons);
+  gridPolyData->SetTriangleStrips(gridStrips);
+  filter->SetInput(gridPolyData);
+  filter->ComputeCellNormalsOn();
+  filter->SetNormalsArrayName(normalsArrayName);
+  filter->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  PolyDataType::Pointer serialOutput = filter->GetOutput();
+  serialOutput->DisconnectPipeline();
+  auto parallelFilter = FilterType::New();
+  parallelFilter->SetInput(gridPolyData);
+  parallelFilter->ComputeCellNormalsOn();
+  parallelFilter->SetNumberOfWorkUnits(7);
+  ITK_TRY_EXPECT_NO_EXCEPTION(parallelFilter->Update());
+  const PolyDataType * parallelOutput = parallelFilter->GetOutput();
+  ITK_TEST_EXPECT_TRUE(parallelOutput->GetPointDataArray<float>("Normals")->CastToSTLConstContainer() ==
+                       serialOutput->GetPointDataArray<float>("Normals")->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_TRUE(parallelOutput->GetCellDataArray<float>("Normals")->CastToSTLConstContainer() ==
+                       serialOutput->GetCellDataArray<float>("Normals")->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_EQUAL(parallelOutput->GetPointDataArray<float>("Normals")->Size(), 3 * GridSize * GridSize);
+  const float * lastPointNormal = &parallelOutput->GetPointDataArray<float>("Normals")->back() - 2;
+  ITK_TEST_EXPECT_TRUE(lastPointNormal[2] > 0.0f);
+
+  // Cells that use points the PolyData does not have are rejected
+  auto invalidPolyData = PolyDataType::New();
+  auto invalidPoints = PolyDataType::PointsContainer::New();
+  invalidPoints->CastToSTLContainer().resize(3);
+  auto invalidPolygons = CellsContainer::New();
+  invalidPolygons->CastToSTLContainer() = { 3, 0, 1, 3 };
+  invalidPolyData->SetPoints(invalidPoints);
+  invalidPolyData->SetPolygons(invalidPolygons);
+  parallelFilter->SetInput(invalidPolyData);
+  ITK_TRY_EXPECT_EXCEPTION(parallelFilter->Update());
+
+  return EXIT_SUCCESS;
+}
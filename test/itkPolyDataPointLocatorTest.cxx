@@ -0,0 +1,180 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolyData.h"
+#include "itkPolyDataPointLocator.h"
+
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <random>
+
+int
+itkPolyDataPointLocatorTest(int, char *[])
+{
+  using PolyDataType = itk::PolyData<float>;
+  using PointType = PolyDataType::PointType;
+  using LocatorType = itk::PolyDataPointLocator<PolyDataType>;
+  using NeighborsType = LocatorType::NeighborsType;
+
+  LocatorType::Pointer locator = LocatorType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(locator, PolyDataPointLocator, Object);
+
+  PointType origin;
+  origin.Fill(0.0f);
+  ITK_TRY_EXPECT_EXCEPTION(locator->FindClosestPoint(origin));
+
+  // Points in a flat box, so that one axis has few bins, with a duplicate
+  std::mt19937                          generator(42);
+  std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+  auto                                  polyData = PolyDataType::New();
+  auto                                  points = PolyDataType::PointsContainer::New();
+  for (unsigned int ii = 0; ii < 5000; ++ii)
+  {
+    PointType point;
+    point[0] = distribution(generator);
+    point[1] = distribution(generator);
+    point[2] = 0.01f * distribution(generator);
+    points->push_back(point);
+  }
+  points->push_back(points->ElementAt(10));
+  polyData->SetPoints(points);
+  locator->SetPolyData(polyData);
+  ITK_TEST_SET_GET_VALUE(polyData.GetPointer(), locator->GetPolyData());
+  ITK_TRY_EXPECT_NO_EXCEPTION(locator->Initialize());
+
+  const auto bruteForceNearest = [&points](const PointType & query, unsigned int numberOfNeighbors) {
+    NeighborsType ids(points->Size());
+    for (itk::SizeValueType ii = 0; ii < ids.size(); ++ii)
+    {
+      ids[ii] = ii;
+    }
+    std::sort(ids.begin(), ids.end(), [&](itk::SizeValueType a, itk::SizeValueType b) {
+      const double distanceA = query.SquaredEuclideanDistanceTo(points->ElementAt(a));
+      const double distanceB = query.SquaredEuclideanDistanceTo(points->ElementAt(b));
+      return distanceA < distanceB || (distanceA == distanceB && a < b);
+    });
+    ids.resize(std::min<itk::SizeValueType>(numberOfNeighbors, ids.size()));
+    return ids;
+  };
+  const auto bruteForceRadius = [&points](const PointType & query, double radius) {
+    NeighborsType ids;
+    for (itk::SizeValueType ii = 0; ii < points->Size(); ++ii)
+    {
+      if (query.SquaredEuclideanDistanceTo(points->ElementAt(ii)) <= radius * radius)
+      {
+        ids.push_back(ii);
+      }
+    }
+    return ids;
+  };
+
+  // Queries inside and outside of the bounds of the points
+  auto queries = PolyDataType::PointsContainer::New();
+  for (unsigned int ii = 0; ii < 200; ++ii)
+  {
+    PointType query;
+    query[0] = 1.5f * distribution(generator);
+    query[1] = 1.5f * distribution(generator);
+    query[2] = distribution(generator);
+    queries->push_back(query);
+  }
+  queries->push_back(points->ElementAt(10));
+
+  constexpr unsigned int NumberOfNeighbors = 7;
+  constexpr double       Radius = 1.5;
+  NeighborsType          batchedNearest;
+  locator->FindClosestNPoints(queries, NumberOfNeighbors, batchedNearest);
+  ITK_TEST_EXPECT_EQUAL(batchedNearest.size(), queries->Size() * NumberOfNeighbors);
+  std::vector<NeighborsType> batchedWithinRadius;
+  locator->FindPointsWithinRadius(queries, Radius, batchedWithinRadius);
+  ITK_TEST_EXPECT_EQUAL(batchedWithinRadius.size(), queries->Size());
+  for (itk::SizeValueType ii = 0; ii < queries->Size(); ++ii)
+  {
+    const PointType &   query = queries->ElementAt(ii);
+    const NeighborsType expectedNearest = bruteForceNearest(query, NumberOfNeighbors);
+    NeighborsType       nearest;
+    locator->FindClosestNPoints(query, NumberOfNeighbors, nearest);
+    ITK_TEST_EXPECT_TRUE(nearest == expectedNearest);
+    ITK_TEST_EXPECT_TRUE(std::equal(nearest.begin(), nearest.end(), batchedNearest.begin() + ii * NumberOfNeighbors));
+    ITK_TEST_EXPECT_EQUAL(locator->FindClosestPoint(query), expectedNearest[0]);
+
+    NeighborsType withinRadius;
+    locator->FindPointsWithinRadius(query, Radius, withinRadius);
+    ITK_TEST_EXPECT_TRUE(withinRadius == bruteForceRadius(query, Radius));
+    ITK_TEST_EXPECT_TRUE(withinRadius == batchedWithinRadius[ii]);
+  }
+
+  // The duplicate point is found after the original
+  NeighborsType duplicates;
+  locator->FindClosestNPoints(points->ElementAt(10), 2, duplicates);
+  ITK_TEST_EXPECT_TRUE(duplicates == NeighborsType({ 10, 5000 }));
+
+  // Asking for more neighbors than points returns all of them
+  NeighborsType allPoints;
+  locator->FindClosestNPoints(origin, 10000, allPoints);
+  ITK_TEST_EXPECT_EQUAL(allPoints.size(), points->Size());
+
+  // The grid has no more bins than PointsPerBin allows
+  ITK_TEST_EXPECT_TRUE(locator->GetNumberOfBins() <= points->Size() / LocatorType::PointsPerBin);
+
+  // A nearly flat cloud, much thinner than a bin, is binned like a flat
+  // one instead of getting as many bins along each axis as points
+  auto nearlyFlatPolyData = PolyDataType::New();
+  auto nearlyFlatPoints = PolyDataType::PointsContainer::New();
+  for (unsigned int ii = 0; ii < 20000; ++ii)
+  {
+    PointType point;
+    point[0] = 5.0f * distribution(generator);
+    point[1] = 5.0f * distribution(generator);
+    point[2] = 1e-7f * distribution(generator);
+    nearlyFlatPoints->push_back(point);
+  }
+  nearlyFlatPolyData->SetPoints(nearlyFlatPoints);
+  auto nearlyFlatLocator = LocatorType::New();
+  nearlyFlatLocator->SetPolyData(nearlyFlatPolyData);
+  const itk::SizeValueType numberOfBins = nearlyFlatLocator->GetNumberOfBins();
+  ITK_TEST_EXPECT_TRUE(numberOfBins <= nearlyFlatPoints->Size() / LocatorType::PointsPerBin);
+  ITK_TEST_EXPECT_TRUE(numberOfBins >= nearlyFlatPoints->Size() / (4 * LocatorType::PointsPerBin));
+  for (itk::SizeValueType ii = 0; ii < 20; ++ii)
+  {
+    const PointType &  query = queries->ElementAt(ii);
+    itk::SizeValueType expectedClosest = 0;
+    for (itk::SizeValueType pointId = 1; pointId < nearlyFlatPoints->Size(); ++pointId)
+    {
+      if (query.SquaredEuclideanDistanceTo(nearlyFlatPoints->ElementAt(pointId)) <
+          query.SquaredEuclideanDistanceTo(nearlyFlatPoints->ElementAt(expectedClosest)))
+      {
+        expectedClosest = pointId;
+      }
+    }
+    ITK_TEST_EXPECT_EQUAL(nearlyFlatLocator->FindClosestPoint(query), expectedClosest);
+  }
+
+  // The grid is rebuilt when the points change
+  PointType movedPoint;
+  movedPoint.Fill(100.0f);
+  polyData->SetPoint(42, movedPoint);
+  ITK_TEST_EXPECT_EQUAL(locator->FindClosestPoint(movedPoint), 42);
+  auto singlePoint = PolyDataType::PointsContainer::New();
+  singlePoint->push_back(origin);
+  polyData->SetPoints(singlePoint);
+  ITK_TEST_EXPECT_EQUAL(locator->FindClosestPoint(movedPoint), 0);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,213 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolyDataQuadricDecimationFilter.h"
+
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <vector>
+
+int
+itkPolyDataQuadricDecimationFilterTest(int, char *[])
+{
+  using PolyDataType = itk::PolyData<float>;
+  using FilterType = itk::PolyDataQuadricDecimationFilter<PolyDataType>;
+
+  // A grid of quadrilaterals, flat or with a height, whose point data and
+  // cell data are the point and cell ids
+  constexpr unsigned int GridSize = 20;
+  const auto             makeGrid = [](bool flat) {
+    auto polyData = PolyDataType::New();
+    auto points = PolyDataType::PointsContainer::New();
+    auto pointData = PolyDataType::PointDataContainer::New();
+    auto polygons = PolyDataType::CellsContainer::New();
+    auto cellData = PolyDataType::CellDataContainer::New();
+    for (unsigned int row = 0; row < GridSize; ++row)
+    {
+      for (unsigned int column = 0; column < GridSize; ++column)
+      {
+        PolyDataType::PointType point;
+        point[0] = column;
+        point[1] = row;
+        point[2] = flat ? 0.0f : static_cast<float>(2.0 * std::sin(0.5 * column) * std::cos(0.4 * row));
+        pointData->push_back(static_cast<float>(points->Size()));
+        points->push_back(point);
+        if (row + 1 < GridSize && column + 1 < GridSize)
+        {
+          const uint32_t corner = row * GridSize + column;
+          cellData->push_back(static_cast<float>(cellData->Size()));
+          polygons->CastToSTLContainer().insert(polygons->CastToSTLContainer().end(),
+                                                { 4, corner, corner + 1, corner + GridSize + 1, corner + GridSize });
+        }
+      }
+    }
+    polyData->SetPoints(points);
+    polyData->SetPointData(pointData);
+    polyData->SetPolygons(polygons);
+    polyData->SetCellData(cellData);
+    return polyData;
+  };
+  constexpr itk::SizeValueType NumberOfTriangles = 2 * (GridSize - 1) * (GridSize - 1);
+  const auto                   targetNumberOfTriangles = [](const FilterType * decimation, unsigned int level) {
+    return static_cast<itk::SizeValueType>(std::llround(decimation->GetLevelFractions()[level] * NumberOfTriangles));
+  };
+
+  auto filter = FilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, PolyDataQuadricDecimationFilter, PolyDataToPolyDataFilter);
+
+  const double boundaryWeight = 100.0;
+  filter->SetBoundaryWeight(boundaryWeight);
+  ITK_TEST_SET_GET_VALUE(boundaryWeight, filter->GetBoundaryWeight());
+  filter->SetBoundaryWeight(1000.0);
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfLevels(), 3u);
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfIndexedOutputs(), 3u);
+
+  // A flat grid keeps its plane and its boundary at every level, and each
+  // level has fewer triangles than the previous one
+  auto flatGrid = makeGrid(true);
+  filter->SetInput(flatGrid);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  itk::SizeValueType previousNumberOfTriangles = NumberOfTriangles;
+  for (unsigned int level = 0; level < filter->GetNumberOfLevels(); ++level)
+  {
+    const PolyDataType * output = filter->GetOutput(level);
+    const auto           numberOfTriangles = output->GetNumberOfPolygons();
+    ITK_TEST_EXPECT_TRUE(numberOfTriangles <= targetNumberOfTriangles(filter, level));
+    ITK_TEST_EXPECT_TRUE(numberOfTriangles <= previousNumberOfTriangles);
+    ITK_TEST_EXPECT_TRUE(numberOfTriangles > 0);
+    previousNumberOfTriangles = numberOfTriangles;
+    ITK_TEST_EXPECT_EQUAL(output->GetPolygons()->Size(), 4 * numberOfTriangles);
+    ITK_TEST_EXPECT_EQUAL(output->GetNumberOfTriangleStrips(), 0u);
+    ITK_TEST_EXPECT_TRUE(output->GetBounds() == flatGrid->GetBounds());
+
+    // The point data and cell data come from the input points and cells
+    ITK_TEST_EXPECT_EQUAL(output->GetPointData()->Size(), output->GetNumberOfPoints());
+    for (const float pointId : output->GetPointData()->CastToSTLConstContainer())
+    {
+      ITK_TEST_EXPECT_TRUE(pointId >= 0.0f && pointId < GridSize * GridSize && pointId == std::floor(pointId));
+    }
+    ITK_TEST_EXPECT_EQUAL(output->GetCellData()->Size(), numberOfTriangles);
+    for (const float cellId : output->GetCellData()->CastToSTLConstContainer())
+    {
+      ITK_TEST_EXPECT_TRUE(cellId >= 0.0f && cellId < NumberOfTriangles / 2 && cellId == std::floor(cellId));
+    }
+  }
+
+  // A single level that keeps every triangle splits the quadrilaterals
+  filter->SetLevelFractions({ 1.0 });
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfIndexedOutputs(), 1u);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(filter->GetOutput()->GetNumberOfPolygons(), NumberOfTriangles);
+  ITK_TEST_EXPECT_EQUAL(filter->GetOutput()->GetNumberOfPoints(), GridSize * GridSize);
+
+  // The levels do not depend on the number of work units
+  auto grid = makeGrid(false);
+  filter->SetInput(grid);
+  filter->SetLevelFractions({ 0.6, 0.3, 0.1, 0.05 });
+  filter->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  auto parallelFilter = FilterType::New();
+  parallelFilter->SetInput(grid);
+  parallelFilter->SetLevelFractions(filter->GetLevelFractions());
+  parallelFilter->SetNumberOfWorkUnits(5);
+  ITK_TRY_EXPECT_NO_EXCEPTION(parallelFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(parallelFilter->GetNumberOfIndexedOutputs(), 4u);
+  for (unsigned int level = 0; level < 4; ++level)
+  {
+    const PolyDataType * serialOutput = filter->GetOutput(level);
+    const PolyDataType * parallelOutput = parallelFilter->GetOutput(level);
+    ITK_TEST_EXPECT_TRUE(parallelOutput->GetNumberOfPolygons() <= targetNumberOfTriangles(parallelFilter, level));
+    ITK_TEST_EXPECT_TRUE(parallelOutput->GetPoints()->CastToSTLConstContainer() ==
+                         serialOutput->GetPoints()->CastToSTLConstContainer());
+    ITK_TEST_EXPECT_TRUE(parallelOutput->GetPolygons()->CastToSTLConstContainer() ==
+                         serialOutput->GetPolygons()->CastToSTLConstContainer());
+    ITK_TEST_EXPECT_TRUE(parallelOutput->GetPointData()->CastToSTLConstContainer() ==
+                         serialOutput->GetPointData()->CastToSTLConstContainer());
+  }
+
+  // The rows of the grid stitched into a single strip: the triangles with a
+  // repeated point are dropped
+  auto                  stripPolyData = PolyDataType::New();
+  std::vector<uint32_t> strip{ 0 };
+  for (uint32_t row = 0; row + 1 < GridSize; ++row)
+  {
+    if (row > 0)
+    {
+      strip.insert(strip.end(), { strip.back(), row * GridSize });
+    }
+    for (uint32_t column = 0; column < GridSize; ++column)
+    {
+      strip.insert(strip.end(), { row * GridSize + column, (row + 1) * GridSize + column });
+    }
+  }
+  strip[0] = static_cast<uint32_t>(strip.size() - 1);
+  auto strips = PolyDataType::CellsContainer::New();
+  strips->CastToSTLContainer() = strip;
+  auto stripCellData = PolyDataType::CellDataContainer::New();
+  stripCellData->push_back(7.0f);
+  stripPolyData->SetPoints(grid->GetPoints());
+  stripPolyData->SetPointData(grid->GetPointData());
+  stripPolyData->SetTriangleStrips(strips);
+  stripPolyData->SetCellData(stripCellData);
+  auto stripFilter = FilterType::New();
+  stripFilter->SetInput(stripPolyData);
+  stripFilter->SetLevelFractions({ 1.0, 0.25 });
+  ITK_TRY_EXPECT_NO_EXCEPTION(stripFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(stripFilter->GetOutput(0)->GetNumberOfPolygons(), NumberOfTriangles);
+  ITK_TEST_EXPECT_EQUAL(stripFilter->GetOutput(0)->GetNumberOfPoints(), GridSize * GridSize);
+  const PolyDataType * decimatedStrip = stripFilter->GetOutput(1);
+  ITK_TEST_EXPECT_TRUE(decimatedStrip->GetNumberOfPolygons() > 0);
+  ITK_TEST_EXPECT_TRUE(decimatedStrip->GetNumberOfPolygons() <= targetNumberOfTriangles(stripFilter, 1));
+  const std::vector<uint32_t> & decimatedTriangles = decimatedStrip->GetPolygons()->CastToSTLConstContainer();
+  for (itk::SizeValueType ii = 0; ii < decimatedTriangles.size(); ii += 4)
+  {
+    ITK_TEST_EXPECT_EQUAL(decimatedTriangles[ii], 3u);
+    ITK_TEST_EXPECT_TRUE(decimatedTriangles[ii + 1] != decimatedTriangles[ii + 2] &&
+                         decimatedTriangles[ii + 2] != decimatedTriangles[ii + 3] &&
+                         decimatedTriangles[ii + 3] != decimatedTriangles[ii + 1]);
+    for (itk::SizeValueType point = ii + 1; point < ii + 4; ++point)
+    {
+      ITK_TEST_EXPECT_TRUE(decimatedTriangles[point] < decimatedStrip->GetNumberOfPoints());
+    }
+  }
+  for (const float cellData : decimatedStrip->GetCellData()->CastToSTLConstContainer())
+  {
+    ITK_TEST_EXPECT_EQUAL(cellData, 7.0f);
+  }
+
+  // The levels must be decreasing fractions
+  parallelFilter->SetLevelFractions({ 0.25, 0.5 });
+  ITK_TRY_EXPECT_EXCEPTION(parallelFilter->Update());
+  parallelFilter->SetLevelFractions({ 0.0 });
+  ITK_TRY_EXPECT_EXCEPTION(parallelFilter->Update());
+
+  // Cells that use points the PolyData does not have are rejected
+  auto invalidPolyData = PolyDataType::New();
+  auto invalidPoints = PolyDataType::PointsContainer::New();
+  invalidPoints->CastToSTLContainer().resize(3);
+  auto invalidPolygons = PolyDataType::CellsContainer::New();
+  invalidPolygons->CastToSTLContainer() = { 3, 0, 1, 3 };
+  invalidPolyData->SetPoints(invalidPoints);
+  invalidPolyData->SetPolygons(invalidPolygons);
+  parallelFilter->SetLevelFractions({ 0.5 });
+  parallelFilter->SetInput(invalidPolyData);
+  ITK_TRY_EXPECT_EXCEPTION(parallelFilter->Update());
+
+  return EXIT_SUCCESS;
+}
@@ -16,9 +16,12 @@
  *
  *=========================================================================*/
 #include "itkPolyData.h"
+#include "itkVariableLengthVector.h"
 
 #include "itkTestingMacros.h"
 
+#include <limits>
+
 int
 itkPolyDataTest(int, char *[])
 {
@@ -131,5 +134,200 @@ itkPolyDataTest(int, char *[])
 
   ITK_EXERCISE_BASIC_OBJECT_METHODS(polyData, PolyData, DataObject);
 
+  // Bounds of the points, updated when the points change
+  const PolyDataType::BoundsArrayType bounds = polyData->GetBounds();
+  const double                        expectedBounds[6] = { 1.0, 3.0, 3.0, 5.0, 5.0, 7.0 };
+  for (unsigned int ii = 0; ii < 6; ++ii)
+  {
+    ITK_TEST_EXPECT_EQUAL(bounds[ii], expectedBounds[ii]);
+  }
+  point[0] = -2.0;
+  polyData->SetPoint(0, point);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetBounds()[0], -2.0);
+  ITK_TEST_EXPECT_EQUAL(PolyDataType::New()->GetBounds()[5], 0.0);
+
+  auto manyPoints = PolyDataType::PointsContainer::New();
+  for (unsigned int ii = 0; ii < 200000; ++ii)
+  {
+    point[0] = ii * 0.5;
+    point[1] = -1.0 * ii;
+    point[2] = ii == 150000 ? std::numeric_limits<float>::quiet_NaN() : 1.0;
+    manyPoints->push_back(point);
+  }
+  auto manyPointsPolyData = PolyDataType::New();
+  manyPointsPolyData->SetPoints(manyPoints);
+  const PolyDataType::BoundsArrayType manyPointsBounds = manyPointsPolyData->GetBounds();
+  ITK_TEST_EXPECT_EQUAL(manyPointsBounds[0], 0.0);
+  ITK_TEST_EXPECT_EQUAL(manyPointsBounds[1], 99999.5);
+  ITK_TEST_EXPECT_EQUAL(manyPointsBounds[2], -199999.0);
+  ITK_TEST_EXPECT_EQUAL(manyPointsBounds[3], 0.0);
+  ITK_TEST_EXPECT_EQUAL(manyPointsBounds[4], 1.0);
+  ITK_TEST_EXPECT_EQUAL(manyPointsBounds[5], 1.0);
+
+  // Random access to the cells
+  ITK_TEST_EXPECT_EQUAL(polyData->GetNumberOfVertices(), 2);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetNumberOfLines(), 2);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetNumberOfPolygons(), 2);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetNumberOfTriangleStrips(), 2);
+  const std::vector<itk::SizeValueType> expectedPolygonOffsets = { 0, 5, 10 };
+  ITK_TEST_EXPECT_TRUE(polyData->GetPolygonOffsets()->CastToSTLConstContainer() == expectedPolygonOffsets);
+  PolyDataType::CellPointIdsType polygon = polyData->GetPolygon(1);
+  ITK_TEST_EXPECT_EQUAL(polygon.size(), 4);
+  ITK_TEST_EXPECT_EQUAL(polygon[0], 8);
+  ITK_TEST_EXPECT_EQUAL(polygon[3], 11);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetVertex(1)[0], 7);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetLine(0).size(), 2);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetTriangleStrip(1)[2], 10);
+  ITK_TRY_EXPECT_EXCEPTION(polyData->GetPolygon(2));
+
+  // Cells are numbered as the cell data across the cell arrays
+  ITK_TEST_EXPECT_EQUAL(polyData->GetCellPointIds(1)[0], 7);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetCellPointIds(5)[0], 8);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetCellPointIds(7).size(), 3);
+  ITK_TRY_EXPECT_EXCEPTION(polyData->GetCellPointIds(8));
+
+  // The index follows edits of the cell arrays
+  polygons->push_back(3);
+  polygons->push_back(1);
+  polygons->push_back(2);
+  polygons->push_back(3);
+  polygons->Modified();
+  ITK_TEST_EXPECT_EQUAL(polyData->GetNumberOfPolygons(), 3);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetPolygon(2)[2], 3);
+  auto singleLine = PolyDataType::CellsContainer::New();
+  singleLine->push_back(2);
+  singleLine->push_back(0);
+  singleLine->push_back(1);
+  polyData->SetLines(singleLine);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetNumberOfLines(), 1);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetCellPointIds(3)[0], 4);
+
+  // A cell that extends past the end of its cell array is rejected
+  singleLine->push_back(3);
+  singleLine->Modified();
+  ITK_TRY_EXPECT_EXCEPTION(polyData->GetNumberOfLines());
+
+  // So is a 64 bit count that would wrap the position around
+  using WideIndexPolyDataType = itk::PolyData<PixelType, PixelType, uint64_t>;
+  auto wideIndexPolyData = WideIndexPolyDataType::New();
+  auto wideIndexLines = WideIndexPolyDataType::CellsContainer::New();
+  wideIndexLines->CastToSTLContainer() = { 2, 0, 1, std::numeric_limits<uint64_t>::max(), 0 };
+  wideIndexPolyData->SetLines(wideIndexLines);
+  ITK_TRY_EXPECT_EXCEPTION(wideIndexPolyData->GetNumberOfLines());
+
+  // Grafting shares the containers
+  auto grafted = PolyDataType::New();
+  ITK_TRY_EXPECT_NO_EXCEPTION(grafted->CopyInformation(polyData));
+  grafted->Graft(polyData);
+  ITK_TEST_EXPECT_EQUAL(grafted->GetPoints(), polyData->GetPoints());
+  ITK_TEST_EXPECT_EQUAL(grafted->GetPolygons(), polyData->GetPolygons());
+  ITK_TEST_EXPECT_EQUAL(grafted->GetPointData(), polyData->GetPointData());
+  ITK_TEST_EXPECT_EQUAL(grafted->GetCellData(), polyData->GetCellData());
+  auto otherTypePolyData = itk::PolyData<float>::New();
+  ITK_TRY_EXPECT_EXCEPTION(grafted->Graft(otherTypePolyData));
+  ITK_TRY_EXPECT_EXCEPTION(grafted->CopyInformation(otherTypePolyData));
+
+  // With copy on write, shared containers are copied before they are
+  // modified, and the others are not
+  ITK_TEST_SET_GET_BOOLEAN(grafted, CopyOnWrite, true);
+  grafted->CopyOnWriteOn();
+  const PolyDataType * constGrafted = grafted;
+  ITK_TEST_EXPECT_EQUAL(constGrafted->GetPoints(), polyData->GetPoints());
+  const PolyDataType::PointType sourcePoint = polyData->GetPoint(0);
+  point.Fill(50.0);
+  grafted->SetPoint(0, point);
+  ITK_TEST_EXPECT_TRUE(constGrafted->GetPoints() != polyData->GetPoints());
+  ITK_TEST_EXPECT_EQUAL(grafted->GetPoint(0)[0], 50.0);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetPoint(0)[0], sourcePoint[0]);
+  ITK_TEST_EXPECT_EQUAL(grafted->GetPoint(1)[0], polyData->GetPoint(1)[0]);
+  const PolyDataType::PointsContainer * graftedPoints = constGrafted->GetPoints();
+  grafted->GetBounds();
+  grafted->SetPoint(1, point);
+  ITK_TEST_EXPECT_EQUAL(constGrafted->GetPoints(), graftedPoints);
+
+  // The bounds cache does not hold a reference to the points container, so
+  // a replaced container is released
+  {
+    auto cachedPolyData = PolyDataType::New();
+    auto cachedPoints = PolyDataType::PointsContainer::New();
+    cachedPoints->push_back(point);
+    cachedPolyData->SetPoints(cachedPoints);
+    cachedPolyData->GetBounds();
+    ITK_TEST_EXPECT_EQUAL(cachedPoints->GetReferenceCount(), 2);
+    cachedPolyData->SetPoints(PolyDataType::PointsContainer::New());
+    ITK_TEST_EXPECT_EQUAL(cachedPoints->GetReferenceCount(), 1);
+  }
+
+  PolyDataType::CellsContainer * graftedPolygons = grafted->GetPolygons();
+  ITK_TEST_EXPECT_TRUE(graftedPolygons != polyData->GetPolygons());
+  ITK_TEST_EXPECT_TRUE(graftedPolygons->CastToSTLConstContainer() ==
+                       polyData->GetPolygons()->CastToSTLConstContainer());
+  ITK_TEST_EXPECT_EQUAL(constGrafted->GetLines(), polyData->GetLines());
+
+  // Named attribute arrays, each with its own component type and count
+  auto thickness = PolyDataType::AttributeArrayType<float>::New();
+  auto curvatures = PolyDataType::AttributeArrayType<double>::New();
+  for (PolyDataType::PointIdentifier id = 0; id < polyData->GetNumberOfPoints(); ++id)
+  {
+    thickness->push_back(0.5f * id);
+    curvatures->push_back(-1.0 * id);
+    curvatures->push_back(2.0 * id);
+  }
+  auto labels = PolyDataType::AttributeArrayType<uint8_t>::New();
+  labels->push_back(7);
+  polyData->SetPointDataArray("Thickness", thickness.GetPointer());
+  polyData->SetPointDataArray("Curvatures", curvatures.GetPointer(), 2);
+  polyData->SetCellDataArray("Labels", labels.GetPointer());
+  ITK_TRY_EXPECT_EXCEPTION(polyData->SetCellDataArray("Empty", labels.GetPointer(), 0));
+
+  ITK_TEST_EXPECT_EQUAL(polyData->GetPointDataArray<float>("Thickness"), thickness.GetPointer());
+  ITK_TEST_EXPECT_TRUE(polyData->GetPointDataArray<double>("Thickness") == nullptr);
+  ITK_TEST_EXPECT_TRUE(polyData->GetPointDataArray<float>("Labels") == nullptr);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetPointDataArrayNumberOfComponents("Curvatures"), 2u);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetPointDataArrayComponentType("Curvatures"), itk::IOComponentEnum::DOUBLE);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetCellDataArrayComponentType("Labels"), itk::IOComponentEnum::UCHAR);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetCellDataArrayNumberOfComponents("Thickness"), 0u);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetCellDataArrayComponentType("Thickness"),
+                        itk::IOComponentEnum::UNKNOWNCOMPONENTTYPE);
+  ITK_TEST_EXPECT_TRUE(polyData->GetPointDataArrayNames() ==
+                       PolyDataType::AttributeArrayNamesType({ "Curvatures", "Thickness" }));
+
+  // Grafting shares the arrays, which are copied on write
+  auto graftedArrays = PolyDataType::New();
+  graftedArrays->Graft(polyData);
+  graftedArrays->CopyOnWriteOn();
+  const PolyDataType * constGraftedArrays = graftedArrays.GetPointer();
+  ITK_TEST_EXPECT_EQUAL(constGraftedArrays->GetCellDataArray<uint8_t>("Labels"), labels.GetPointer());
+  PolyDataType::AttributeArrayType<uint8_t> * graftedLabels = graftedArrays->GetCellDataArray<uint8_t>("Labels");
+  ITK_TEST_EXPECT_TRUE(graftedLabels != labels.GetPointer());
+  graftedLabels->ElementAt(0) = 3;
+  ITK_TEST_EXPECT_EQUAL(static_cast<int>(labels->ElementAt(0)), 7);
+  ITK_TEST_EXPECT_EQUAL(graftedArrays->GetCellDataArray<uint8_t>("Labels"), graftedLabels);
+
+  graftedArrays->RemovePointDataArray("Thickness");
+  ITK_TEST_EXPECT_EQUAL(graftedArrays->GetPointDataArrayNames().size(), 1u);
+  ITK_TEST_EXPECT_EQUAL(polyData->GetPointDataArrayNames().size(), 2u);
+  polyData->SetPointDataArray<float>("Thickness", nullptr);
+  ITK_TEST_EXPECT_TRUE(polyData->GetPointDataArray<float>("Thickness") == nullptr);
+  graftedArrays->Initialize();
+  ITK_TEST_EXPECT_TRUE(graftedArrays->GetCellDataArrayNames().empty());
+
+  // Multi-component point data stored as a flat buffer
+  using VectorPolyDataType = itk::PolyData<itk::VariableLengthVector<float>>;
+  auto vectorPolyData = VectorPolyDataType::New();
+  auto pointDataBuffer = VectorPolyDataType::PointDataBufferType::New();
+  for (unsigned int ii = 0; ii < 6; ++ii)
+  {
+    pointDataBuffer->InsertElement(ii, 0.5f * ii);
+  }
+  vectorPolyData->SetPointDataBuffer(pointDataBuffer, 3);
+  ITK_TEST_SET_GET_VALUE(pointDataBuffer.GetPointer(), vectorPolyData->GetPointDataBuffer());
+  ITK_TEST_SET_GET_VALUE(3, vectorPolyData->GetNumberOfPointDataComponents());
+  VectorPolyDataType::PixelType vectorPointData;
+  ITK_TEST_EXPECT_TRUE(vectorPolyData->GetPointData(1, &vectorPointData));
+  ITK_TEST_SET_GET_VALUE(3, vectorPointData.GetSize());
+  ITK_TEST_SET_GET_VALUE(2.0f, vectorPointData[1]);
+  ITK_TEST_EXPECT_TRUE(!vectorPolyData->GetPointData(2, &vectorPointData));
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,191 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMeshToPolyDataFilter.h"
+#include "itkPolyDataVTKFileWriter.h"
+
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+int
+itkPolyDataVTKFileWriterTest(int argc, char * argv[])
+{
+  if (argc < 4)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " inputMesh outputLegacyFile outputXMLFile"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string legacyFileName = argv[2];
+  const std::string xmlFileName = argv[3];
+
+  using MeshType = itk::Mesh<float, 3>;
+  using ReaderType = itk::MeshFileReader<MeshType>;
+  using FilterType = itk::MeshToPolyDataFilter<MeshType>;
+  using PolyDataType = FilterType::PolyDataType;
+
+  auto reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+  auto filter = FilterType::New();
+  filter->SetInput(reader->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  PolyDataType::Pointer polyData = filter->GetOutput();
+  polyData->DisconnectPipeline();
+
+  const itk::SizeValueType numberOfPoints = polyData->GetNumberOfPoints();
+  const itk::SizeValueType numberOfPolygons = polyData->GetNumberOfPolygons();
+  auto                     pointData = PolyDataType::PointDataBufferType::New();
+  for (itk::SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+  {
+    pointData->push_back(0.5f * ii);
+  }
+  polyData->SetPointDataBuffer(pointData, 1);
+  auto cellData = PolyDataType::CellDataBufferType::New();
+  for (itk::SizeValueType ii = 0; ii < numberOfPolygons; ++ii)
+  {
+    cellData->push_back(static_cast<float>(ii));
+  }
+  polyData->SetCellDataBuffer(cellData, 1);
+
+  using WriterType = itk::PolyDataVTKFileWriter<PolyDataType>;
+  WriterType::Pointer writer = WriterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(writer, PolyDataVTKFileWriter, Object);
+  ITK_TEST_EXPECT_EQUAL(std::string(writer->GetNormalsArrayName()), "Normals");
+
+  ITK_TRY_EXPECT_EXCEPTION(writer->Write());
+  writer->SetInput(polyData);
+  ITK_TEST_SET_GET_VALUE(polyData.GetPointer(), writer->GetInput());
+  ITK_TRY_EXPECT_EXCEPTION(writer->Write());
+
+  // The legacy file reads back as the input mesh with its attributes
+  writer->SetFileName(legacyFileName);
+  ITK_TEST_SET_GET_VALUE(legacyFileName, std::string(writer->GetFileName()));
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Write());
+
+  auto legacyReader = ReaderType::New();
+  legacyReader->SetFileName(legacyFileName);
+  auto legacyFilter = FilterType::New();
+  legacyFilter->SetInput(legacyReader->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(legacyFilter->Update());
+  const PolyDataType * legacyPolyData = legacyFilter->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(legacyPolyData->GetNumberOfPoints(), numberOfPoints);
+  for (itk::SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+  {
+    ITK_TEST_EXPECT_EQUAL(legacyPolyData->GetPoint(ii), polyData->GetPoint(ii));
+  }
+  ITK_TEST_EXPECT_TRUE(legacyPolyData->GetPolygons()->CastToSTLConstContainer() ==
+                       polyData->GetPolygons()->CastToSTLConstContainer());
+  const MeshType * legacyMesh = legacyReader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(legacyMesh->GetPointData()->Size(), numberOfPoints);
+  ITK_TEST_EXPECT_EQUAL(legacyMesh->GetPointData()->ElementAt(numberOfPoints - 1), pointData->back());
+  ITK_TEST_EXPECT_EQUAL(legacyMesh->GetCellData()->Size(), numberOfPolygons);
+  ITK_TEST_EXPECT_EQUAL(legacyMesh->GetCellData()->ElementAt(numberOfPolygons - 1), cellData->back());
+
+  // The XML file holds the appended arrays announced by its header
+  writer->SetFileName(xmlFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Write());
+  std::string contents;
+  {
+    std::ifstream stream(xmlFileName, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+  }
+  ITK_TEST_EXPECT_EQUAL(contents.compare(0, 5, "<?xml"), 0);
+  ITK_TEST_EXPECT_TRUE(contents.find("NumberOfPoints=\"" + std::to_string(numberOfPoints) + "\"") !=
+                       std::string::npos);
+  ITK_TEST_EXPECT_TRUE(contents.find("NumberOfPolys=\"" + std::to_string(numberOfPolygons) + "\"") !=
+                       std::string::npos);
+  const std::string            trailer = "\n  </AppendedData>\n</VTKFile>\n";
+  const std::string::size_type appendedBegin = contents.find("<AppendedData encoding=\"raw\">\n   _");
+  ITK_TEST_EXPECT_TRUE(appendedBegin != std::string::npos);
+  const itk::SizeValueType polygonsSize = polyData->GetPolygons()->Size();
+  const itk::SizeValueType appendedSize = 8 + numberOfPoints * sizeof(float) + 8 + numberOfPolygons * sizeof(float) +
+                                          8 + numberOfPoints * 3 * sizeof(float) + 8 +
+                                          (polygonsSize - numberOfPolygons) * sizeof(int64_t) + 8 +
+                                          numberOfPolygons * sizeof(int64_t);
+  ITK_TEST_EXPECT_EQUAL(contents.size(),
+                        appendedBegin + std::string("<AppendedData encoding=\"raw\">\n   _").size() + appendedSize +
+                          trailer.size());
+  ITK_TEST_EXPECT_EQUAL(contents.compare(contents.size() - trailer.size(), trailer.size(), trailer), 0);
+
+  // The named arrays follow the point data and cell data under their own
+  // names, encoded for the format of the file
+  auto displacements = PolyDataType::AttributeArrayType<double>::New();
+  for (itk::SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+  {
+    displacements->insert(displacements->end(), { 0.25 * ii, -0.5 * ii });
+  }
+  auto regions = PolyDataType::AttributeArrayType<int16_t>::New();
+  regions->resize(numberOfPolygons, 7);
+  auto wideArray = PolyDataType::AttributeArrayType<uint8_t>::New();
+  wideArray->resize(5 * numberOfPolygons, 1);
+  auto normals = PolyDataType::AttributeArrayType<float>::New();
+  normals->resize(3 * numberOfPoints, 0.0f);
+  polyData->SetPointDataArray("Normals", normals.GetPointer(), 3);
+  polyData->SetPointDataArray("Dis placements", displacements.GetPointer(), 2);
+  polyData->SetCellDataArray("Region<1>", regions.GetPointer());
+  polyData->SetCellDataArray("Wide", wideArray.GetPointer(), 5);
+  const auto readFile = [](const std::string & fileName) {
+    std::ifstream stream(fileName, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+  };
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Write());
+  const std::string namedContents = readFile(xmlFileName);
+  ITK_TEST_EXPECT_TRUE(namedContents.find("type=\"Float64\" Name=\"Dis placements\" NumberOfComponents=\"2\"") !=
+                       std::string::npos);
+  ITK_TEST_EXPECT_TRUE(namedContents.find("type=\"Int16\" Name=\"Region&lt;1&gt;\" NumberOfComponents=\"1\"") !=
+                       std::string::npos);
+  ITK_TEST_EXPECT_TRUE(namedContents.find("<PointData Normals=\"Normals\">") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(namedContents.find("<CellData>") != std::string::npos);
+  ITK_TEST_EXPECT_EQUAL(namedContents.size(),
+                        contents.size() + std::string(" Normals=\"Normals\"").size() + 8 +
+                          displacements->Size() * sizeof(double) + 8 + normals->Size() * sizeof(float) + 8 +
+                          regions->Size() * sizeof(int16_t) + 8 + wideArray->Size());
+  const std::string namedLegacyFileName = legacyFileName + ".named.vtk";
+  writer->SetFileName(namedLegacyFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Write());
+  const std::string namedLegacyContents = readFile(namedLegacyFileName);
+  ITK_TEST_EXPECT_TRUE(namedLegacyContents.find("SCALARS Dis%20placements double 2\nLOOKUP_TABLE default\n") !=
+                       std::string::npos);
+  ITK_TEST_EXPECT_TRUE(namedLegacyContents.find("NORMALS Normals float\n") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(namedLegacyContents.find("SCALARS Region<1> short 1\n") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(namedLegacyContents.find("FIELD FieldData 1\nWide 5 " + std::to_string(numberOfPolygons) +
+                                                " unsigned_char\n") != std::string::npos);
+  writer->SetFileName(xmlFileName);
+
+  // Named arrays that do not match the points or cells are rejected
+  regions->pop_back();
+  ITK_TRY_EXPECT_EXCEPTION(writer->Write());
+  polyData->SetPointDataArray<double>("Dis placements", nullptr);
+  polyData->SetCellDataArray<int16_t>("Region<1>", nullptr);
+  polyData->SetCellDataArray<uint8_t>("Wide", nullptr);
+  polyData->SetPointDataArray<float>("Normals", nullptr);
+
+  // Attributes that do not match the points or cells are rejected
+  auto shortPointData = PolyDataType::PointDataBufferType::New();
+  shortPointData->push_back(1.0f);
+  polyData->SetPointDataBuffer(shortPointData, 1);
+  ITK_TRY_EXPECT_EXCEPTION(writer->Write());
+
+  return EXIT_SUCCESS;
+}